@@ -0,0 +1,215 @@
+#pragma once
+#include <boost/utility/string_view.hpp>
+#include <nlohmann/json.hpp>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+using namespace std;
+
+// 클라이언트 메시지의 숫자 필드
+// 입력/점프처럼 매 틱 오는 메시지는 scanClientMessage로 할당 없이 읽고,
+// 그 외(JOIN의 닉네임/색상 배열 등)는 호출자가 json DOM으로 파싱해서 채운다
+struct ClientMessage
+{
+	enum Field : uint32_t
+	{
+		TYPE = 1 << 0,
+		PLAYER_ID = 1 << 1,
+		X = 1 << 2,
+		Y = 1 << 3,
+		Z = 1 << 4,
+		COUNT = 1 << 5,
+		COSMETIC = 1 << 6, // SPAWN_DUMMIES: 장식용 더미로 (불리언)
+	};
+
+	int type = -1;
+	int playerId = -1;
+	float x = 0.0f, y = 0.0f, z = 0.0f;
+	int count = 10;
+	bool cosmetic = false;
+	uint32_t fields = 0; // 실제로 있었던 필드 (Field 비트)
+
+	bool has(uint32_t mask) const { return (fields & mask) == mask; }
+
+	// 값이 필드에 안 맞으면 (무한대/NaN, int 범위 밖, float로 넘치는 값) 채우지 않고 false
+	// 정수 필드의 소수부는 버린다 (DOM 경로와 같게)
+	bool set(Field field, double value)
+	{
+		if (!std::isfinite(value))
+			return false;
+		switch (field)
+		{
+		case TYPE: return setInt(type, field, value);
+		case PLAYER_ID: return setInt(playerId, field, value);
+		case X: return setFloat(x, field, value);
+		case Y: return setFloat(y, field, value);
+		case Z: return setFloat(z, field, value);
+		case COUNT: return setInt(count, field, value);
+		case COSMETIC: cosmetic = value != 0.0; break;
+		default: return true; // 모르는 키는 무시
+		}
+		fields |= field;
+		return true;
+	}
+
+	bool setInt(int &target, Field field, double value)
+	{
+		if (value < static_cast<double>(INT_MIN) || value > static_cast<double>(INT_MAX))
+			return false;
+		target = static_cast<int>(value);
+		fields |= field;
+		return true;
+	}
+
+	bool setFloat(float &target, Field field, double value)
+	{
+		if (std::fabs(value) > static_cast<double>(FLT_MAX))
+			return false;
+		target = static_cast<float>(value);
+		fields |= field;
+		return true;
+	}
+
+	static Field fieldForKey(boost::string_view key)
+	{
+		if (key == "type") return TYPE;
+		if (key == "playerId") return PLAYER_ID;
+		if (key == "x") return X;
+		if (key == "y") return Y;
+		if (key == "z") return Z;
+		if (key == "count") return COUNT;
+		if (key == "cosmetic") return COSMETIC;
+		return Field(0);
+	}
+};
+
+// 평평한 객체 {"키": 숫자|true|false|null, ...} 만 읽는 스캐너 (할당 없음, true/false는 1/0으로)
+// 문자열 값, 배열, 중첩 객체, 이스케이프가 있거나 형식이 조금이라도 다르면 false -> 호출자가 DOM으로 처리
+// 필드에 안 맞는 숫자(1e999, int 범위 밖 등)도 false (DOM 경로에서도 그 필드는 빠지므로 메시지가 버려진다)
+inline bool scanClientMessage(boost::string_view text, ClientMessage &message)
+{
+	const char *p = text.data();
+	const char *end = p + text.size();
+
+	auto skipSpace = [&]() {
+		while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+			++p;
+	};
+	auto expect = [&](char c) {
+		skipSpace();
+		if (p < end && *p == c)
+		{
+			++p;
+			return true;
+		}
+		return false;
+	};
+
+	if (!expect('{'))
+		return false;
+	skipSpace();
+	if (p < end && *p == '}')
+	{
+		++p;
+		skipSpace();
+		return p == end;
+	}
+
+	while (true)
+	{
+		// 키
+		if (!expect('"'))
+			return false;
+		const char *keyStart = p;
+		while (p < end && *p != '"')
+		{
+			if (*p == '\\')
+				return false;
+			++p;
+		}
+		if (p == end)
+			return false;
+		boost::string_view key(keyStart, static_cast<size_t>(p - keyStart));
+		++p;
+		if (!expect(':'))
+			return false;
+
+		// 값
+		skipSpace();
+		if (p == end)
+			return false;
+		if (*p == '-' || (*p >= '0' && *p <= '9'))
+		{
+			// 버퍼가 NUL로 끝나지 않으므로 숫자 토큰만 복사해서 변환
+			char number[32];
+			size_t length = 0;
+			while (p < end && length < sizeof(number) - 1 && strchr("+-.eE0123456789", *p))
+				number[length++] = *p++;
+			number[length] = '\0';
+			char *parsedEnd;
+			double value = strtod(number, &parsedEnd);
+			if (parsedEnd != number + length)
+				return false;
+			if (!message.set(ClientMessage::fieldForKey(key), value))
+				return false;
+		}
+		else if (static_cast<size_t>(end - p) >= 4 && memcmp(p, "true", 4) == 0)
+		{
+			p += 4;
+			message.set(ClientMessage::fieldForKey(key), 1.0);
+		}
+		else if (static_cast<size_t>(end - p) >= 4 && memcmp(p, "null", 4) == 0)
+			p += 4;
+		else if (static_cast<size_t>(end - p) >= 5 && memcmp(p, "false", 5) == 0)
+		{
+			p += 5;
+			message.set(ClientMessage::fieldForKey(key), 0.0);
+		}
+		else
+			return false;
+
+		skipSpace();
+		if (p < end && *p == ',')
+		{
+			++p;
+			continue;
+		}
+		if (p < end && *p == '}')
+		{
+			++p;
+			skipSpace();
+			return p == end;
+		}
+		return false;
+	}
+}
+
+// DOM으로 파싱한 메시지에서 같은 숫자 필드를 채운다 (스캐너가 못 읽은 메시지용)
+// 필드에 안 맞는 값은 채우지 않는다 (필수 필드면 호출자가 형식 오류로 버린다)
+inline void readClientMessage(const nlohmann::json &data, ClientMessage &message)
+{
+	static const pair<const char *, ClientMessage::Field> keys[] = {
+		{ "type", ClientMessage::TYPE },
+		{ "playerId", ClientMessage::PLAYER_ID },
+		{ "x", ClientMessage::X },
+		{ "y", ClientMessage::Y },
+		{ "z", ClientMessage::Z },
+		{ "count", ClientMessage::COUNT },
+		{ "cosmetic", ClientMessage::COSMETIC },
+	};
+	for (const auto &key : keys)
+	{
+		auto it = data.find(key.first);
+		if (it == data.end())
+			continue;
+		if (it->is_number())
+			message.set(key.second, it->get<double>());
+		else if (it->is_boolean())
+			message.set(key.second, it->get<bool>() ? 1.0 : 0.0);
+	}
+}
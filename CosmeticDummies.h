@@ -0,0 +1,350 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "GameObject.h"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COSMETIC_SSE2 1
+#endif
+
+using namespace std;
+
+// SIMD 로드/스토어용 정렬 할당자
+template <typename T, size_t Alignment>
+struct AlignedAllocator
+{
+	using value_type = T;
+	template <typename U>
+	struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+	AlignedAllocator() = default;
+	template <typename U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment> &) {}
+
+	T *allocate(size_t count)
+	{
+		return static_cast<T *>(::operator new(count * sizeof(T), align_val_t(Alignment)));
+	}
+	void deallocate(T *pointer, size_t)
+	{
+		::operator delete(pointer, align_val_t(Alignment));
+	}
+
+	template <typename U>
+	bool operator==(const AlignedAllocator<U, Alignment> &) const { return true; }
+	template <typename U>
+	bool operator!=(const AlignedAllocator<U, Alignment> &) const { return false; }
+};
+
+// PhysX 밖에서 적분하는 장식용 더미 (중력, 바닥 튕김, 감쇠, 주기 점프만)
+// - SoA 배열 + SSE2/AVX2 커널로 한 코어에서 10만 개 이상을 60Hz로 돌린다
+// - 충돌은 바닥 평면(y = 0)뿐이고 서로/플레이어와는 부딪히지 않는다
+//   -> 플레이어가 접촉 거리 안에 들어오면 GameWorld가 PhysX 액터로 승격하고, 멀어지면 다시 내린다
+// - 상수는 PhysX 더미(상자 0.5 반경, 질량 5, 감쇠 0.3, 점프 충격량 50)와 씬 프로필의 반발 계수에 맞춘다
+class CosmeticDummyField
+{
+public:
+	enum class Kernel
+	{
+		BEST,   // 빌드에서 쓸 수 있는 가장 넓은 SIMD
+		SCALAR, // 비교/벤치용
+	};
+
+	struct Params
+	{
+		float gravity = -9.81f;
+		float halfExtent = 0.5f;         // 상자 반높이 = 바닥에 놓였을 때 중심 높이
+		float restitution = 0.5f;
+		float bounceThreshold = 2.0f;    // 이보다 느린 충돌은 튕기지 않고 멈춤 (PhysX bounceThresholdVelocity 기본값)
+		float linearDamping = 0.3f;
+		float jumpSpeed = 50.0f / 5.0f;  // 충격량 / 질량
+		float jumpInterval = 1.0f;       // 착지 후 다음 점프까지 (초)
+	};
+
+private:
+	template <typename T>
+	using AlignedVector = vector<T, AlignedAllocator<T, 32>>;
+
+	Params params_;
+	AlignedVector<float> px_, py_, pz_;
+	AlignedVector<float> vx_, vy_, vz_;
+	AlignedVector<float> jumpTimer_; // 바닥에 있는 동안만 줄어든다
+	vector<int> ids_;
+
+public:
+	CosmeticDummyField() = default;
+	explicit CosmeticDummyField(const Params &params)
+		: params_(params)
+	{
+	}
+
+	static const char *kernelName()
+	{
+#if defined(__AVX2__)
+		return "avx2";
+#elif defined(COSMETIC_SSE2)
+		return "sse2";
+#else
+		return "scalar";
+#endif
+	}
+
+	size_t size() const { return ids_.size(); }
+	bool empty() const { return ids_.empty(); }
+	const Params &params() const { return params_; }
+	void setRestitution(float restitution) { params_.restitution = restitution; }
+
+	int id(size_t i) const { return ids_[i]; }
+	Vector3 position(size_t i) const { return Vector3(px_[i], py_[i], pz_[i]); }
+	Vector3 velocity(size_t i) const { return Vector3(vx_[i], vy_[i], vz_[i]); }
+
+	void reserve(size_t count)
+	{
+		for (auto *array : { &px_, &py_, &pz_, &vx_, &vy_, &vz_, &jumpTimer_ })
+			array->reserve(count);
+		ids_.reserve(count);
+	}
+
+	// jumpPhase: 0~1, 첫 점프까지 남은 비율 (동시에 뛰지 않도록)
+	void add(int id, const Vector3 &position, const Vector3 &velocity, float jumpPhase)
+	{
+		px_.push_back(position.x);
+		py_.push_back(position.y);
+		pz_.push_back(position.z);
+		vx_.push_back(velocity.x);
+		vy_.push_back(velocity.y);
+		vz_.push_back(velocity.z);
+		jumpTimer_.push_back(params_.jumpInterval * jumpPhase);
+		ids_.push_back(id);
+	}
+
+	// swap-remove (순서 유지 안 함)
+	void removeAt(size_t i)
+	{
+		size_t last = ids_.size() - 1;
+		if (i != last)
+		{
+			px_[i] = px_[last]; py_[i] = py_[last]; pz_[i] = pz_[last];
+			vx_[i] = vx_[last]; vy_[i] = vy_[last]; vz_[i] = vz_[last];
+			jumpTimer_[i] = jumpTimer_[last];
+			ids_[i] = ids_[last];
+		}
+		for (auto *array : { &px_, &py_, &pz_, &vx_, &vy_, &vz_, &jumpTimer_ })
+			array->pop_back();
+		ids_.pop_back();
+	}
+
+	void clear()
+	{
+		for (auto *array : { &px_, &py_, &pz_, &vx_, &vy_, &vz_, &jumpTimer_ })
+			array->clear();
+		ids_.clear();
+	}
+
+	// 한 스텝 적분 (semi-implicit Euler, PhysX와 같은 순서: 속도 -> 감쇠 -> 위치 -> 바닥)
+	void step(float dt, Kernel kernel = Kernel::BEST)
+	{
+		stepRange(dt, 0, ids_.size(), kernel);
+	}
+
+	// [begin, end) 구간만 (구간끼리 겹치지 않으면 여러 스레드에서 동시에 불러도 된다)
+	// begin은 SIMD 폭(8)의 배수여야 정렬 로드가 맞는다
+	void stepRange(float dt, size_t begin, size_t end, Kernel kernel = Kernel::BEST)
+	{
+		size_t done = begin;
+		if (kernel == Kernel::BEST)
+		{
+#if defined(__AVX2__)
+			done = stepAvx2(dt, begin, end);
+#elif defined(COSMETIC_SSE2)
+			done = stepSse2(dt, begin, end);
+#endif
+		}
+		stepScalar(dt, done, end);
+	}
+
+	// points 중 하나라도 radius 안에 있는 더미의 인덱스를 내림차순으로 out에 (바로 removeAt 해도 안전한 순서)
+	void collectNear(const vector<Vector3> &points, float radius, vector<size_t> &out) const
+	{
+		out.clear();
+		if (points.empty())
+			return;
+
+		const float radiusSq = radius * radius;
+		size_t count = ids_.size();
+		for (size_t i = count; i-- > 0;)
+		{
+			for (const Vector3 &point : points)
+			{
+				float dx = px_[i] - point.x;
+				float dy = py_[i] - point.y;
+				float dz = pz_[i] - point.z;
+				if (dx * dx + dy * dy + dz * dz <= radiusSq)
+				{
+					out.push_back(i);
+					break;
+				}
+			}
+		}
+	}
+
+private:
+	void stepScalar(float dt, size_t begin, size_t end)
+	{
+		const Params &p = params_;
+		const float damping = 1.0f / (1.0f + dt * p.linearDamping);
+		for (size_t i = begin; i < end; ++i)
+		{
+			float vx = vx_[i], vy = vy_[i], vz = vz_[i];
+			vy += p.gravity * dt;
+			vx *= damping; vy *= damping; vz *= damping;
+
+			float x = px_[i] + vx * dt;
+			float y = py_[i] + vy * dt;
+			float z = pz_[i] + vz * dt;
+
+			float timer = jumpTimer_[i];
+			if (y < p.halfExtent)
+			{
+				float impact = -vy;
+				y = p.halfExtent;
+				if (impact > p.bounceThreshold)
+				{
+					vy = impact * p.restitution;
+				}
+				else
+				{
+					// 바닥에 놓여 있음: 점프 대기
+					vy = 0.0f;
+					timer -= dt;
+					if (timer <= 0.0f)
+					{
+						vy = p.jumpSpeed;
+						timer = p.jumpInterval;
+					}
+				}
+			}
+
+			px_[i] = x; py_[i] = y; pz_[i] = z;
+			vx_[i] = vx; vy_[i] = vy; vz_[i] = vz;
+			jumpTimer_[i] = timer;
+		}
+	}
+
+#if defined(__AVX2__)
+	// 8개씩, 분기 대신 마스크 선택
+	size_t stepAvx2(float dt, size_t begin, size_t end)
+	{
+		const Params &p = params_;
+		const __m256 vDt = _mm256_set1_ps(dt);
+		const __m256 vGravityDt = _mm256_set1_ps(p.gravity * dt);
+		const __m256 vDamping = _mm256_set1_ps(1.0f / (1.0f + dt * p.linearDamping));
+		const __m256 vHalf = _mm256_set1_ps(p.halfExtent);
+		const __m256 vThreshold = _mm256_set1_ps(p.bounceThreshold);
+		const __m256 vRestitution = _mm256_set1_ps(p.restitution);
+		const __m256 vJumpSpeed = _mm256_set1_ps(p.jumpSpeed);
+		const __m256 vInterval = _mm256_set1_ps(p.jumpInterval);
+		const __m256 vZero = _mm256_setzero_ps();
+
+		size_t i = begin;
+		for (; i + 8 <= end; i += 8)
+		{
+			__m256 vx = _mm256_mul_ps(_mm256_load_ps(&vx_[i]), vDamping);
+			__m256 vy = _mm256_mul_ps(_mm256_add_ps(_mm256_load_ps(&vy_[i]), vGravityDt), vDamping);
+			__m256 vz = _mm256_mul_ps(_mm256_load_ps(&vz_[i]), vDamping);
+
+			__m256 x = _mm256_add_ps(_mm256_load_ps(&px_[i]), _mm256_mul_ps(vx, vDt));
+			__m256 y = _mm256_add_ps(_mm256_load_ps(&py_[i]), _mm256_mul_ps(vy, vDt));
+			__m256 z = _mm256_add_ps(_mm256_load_ps(&pz_[i]), _mm256_mul_ps(vz, vDt));
+			__m256 timer = _mm256_load_ps(&jumpTimer_[i]);
+
+			__m256 below = _mm256_cmp_ps(y, vHalf, _CMP_LT_OQ);
+			__m256 impact = _mm256_sub_ps(vZero, vy);
+			__m256 bounce = _mm256_and_ps(below, _mm256_cmp_ps(impact, vThreshold, _CMP_GT_OQ));
+			__m256 resting = _mm256_andnot_ps(bounce, below);
+
+			timer = _mm256_blendv_ps(timer, _mm256_sub_ps(timer, vDt), resting);
+			__m256 jump = _mm256_and_ps(resting, _mm256_cmp_ps(timer, vZero, _CMP_LE_OQ));
+
+			vy = _mm256_blendv_ps(vy, _mm256_mul_ps(impact, vRestitution), bounce);
+			vy = _mm256_blendv_ps(vy, vZero, resting);
+			vy = _mm256_blendv_ps(vy, vJumpSpeed, jump);
+			timer = _mm256_blendv_ps(timer, vInterval, jump);
+			y = _mm256_blendv_ps(y, vHalf, below);
+
+			_mm256_store_ps(&px_[i], x);
+			_mm256_store_ps(&py_[i], y);
+			_mm256_store_ps(&pz_[i], z);
+			_mm256_store_ps(&vx_[i], vx);
+			_mm256_store_ps(&vy_[i], vy);
+			_mm256_store_ps(&vz_[i], vz);
+			_mm256_store_ps(&jumpTimer_[i], timer);
+		}
+		return i;
+	}
+#endif
+
+#if defined(COSMETIC_SSE2)
+	// SSE2에는 blendv가 없으므로 and/andnot/or로 선택
+	static __m128 select(__m128 mask, __m128 a, __m128 b) // mask ? a : b
+	{
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	size_t stepSse2(float dt, size_t begin, size_t end)
+	{
+		const Params &p = params_;
+		const __m128 vDt = _mm_set1_ps(dt);
+		const __m128 vGravityDt = _mm_set1_ps(p.gravity * dt);
+		const __m128 vDamping = _mm_set1_ps(1.0f / (1.0f + dt * p.linearDamping));
+		const __m128 vHalf = _mm_set1_ps(p.halfExtent);
+		const __m128 vThreshold = _mm_set1_ps(p.bounceThreshold);
+		const __m128 vRestitution = _mm_set1_ps(p.restitution);
+		const __m128 vJumpSpeed = _mm_set1_ps(p.jumpSpeed);
+		const __m128 vInterval = _mm_set1_ps(p.jumpInterval);
+		const __m128 vZero = _mm_setzero_ps();
+
+		size_t i = begin;
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 vx = _mm_mul_ps(_mm_load_ps(&vx_[i]), vDamping);
+			__m128 vy = _mm_mul_ps(_mm_add_ps(_mm_load_ps(&vy_[i]), vGravityDt), vDamping);
+			__m128 vz = _mm_mul_ps(_mm_load_ps(&vz_[i]), vDamping);
+
+			__m128 x = _mm_add_ps(_mm_load_ps(&px_[i]), _mm_mul_ps(vx, vDt));
+			__m128 y = _mm_add_ps(_mm_load_ps(&py_[i]), _mm_mul_ps(vy, vDt));
+			__m128 z = _mm_add_ps(_mm_load_ps(&pz_[i]), _mm_mul_ps(vz, vDt));
+			__m128 timer = _mm_load_ps(&jumpTimer_[i]);
+
+			__m128 below = _mm_cmplt_ps(y, vHalf);
+			__m128 impact = _mm_sub_ps(vZero, vy);
+			__m128 bounce = _mm_and_ps(below, _mm_cmpgt_ps(impact, vThreshold));
+			__m128 resting = _mm_andnot_ps(bounce, below);
+
+			timer = select(resting, _mm_sub_ps(timer, vDt), timer);
+			__m128 jump = _mm_and_ps(resting, _mm_cmple_ps(timer, vZero));
+
+			vy = select(bounce, _mm_mul_ps(impact, vRestitution), vy);
+			vy = select(resting, vZero, vy);
+			vy = select(jump, vJumpSpeed, vy);
+			timer = select(jump, vInterval, timer);
+			y = select(below, vHalf, y);
+
+			_mm_store_ps(&px_[i], x);
+			_mm_store_ps(&py_[i], y);
+			_mm_store_ps(&pz_[i], z);
+			_mm_store_ps(&vx_[i], vx);
+			_mm_store_ps(&vy_[i], vy);
+			_mm_store_ps(&vz_[i], vz);
+			_mm_store_ps(&jumpTimer_[i], timer);
+		}
+		return i;
+	}
+#endif
+};
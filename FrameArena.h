@@ -0,0 +1,173 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// 틱 하나 동안만 쓰는 임시 메모리 (게임 루프 스레드 전용 범프 아레나)
+// - 할당은 포인터 전진뿐, 해제는 아무것도 안 한다 (reset에서 한꺼번에 되돌림)
+// - 블록이 모자라면 새 블록을 잡고, reset 때 지난 틱에 쓴 만큼 한 블록으로 합친다
+//   -> 틱마다 쓰는 양이 비슷하면 정상 상태에서 힙 할당 0
+// - pmr::memory_resource라서 pmr::vector<T>(&arena) 같은 임시 컨테이너에도 쓸 수 있다
+// - 스레드 안전하지 않음: 병렬 구간에서 쓸 버퍼는 호출 스레드가 미리 잡아서 나눠 준다
+class FrameArena : public pmr::memory_resource
+{
+private:
+	struct Block
+	{
+		unique_ptr<unsigned char[]> data;
+		size_t size;
+	};
+
+	vector<Block> blocks_;
+	size_t current_ = 0; // 지금 채우는 블록
+	size_t offset_ = 0;  // 그 블록 안 위치
+	size_t usedBeforeCurrent_ = 0; // 앞 블록들에서 쓴 양 (정렬 손실 포함)
+
+	size_t lastUsed_ = 0;
+	size_t peakUsed_ = 0;
+	long long blockAllocations_ = 0; // 아레나가 힙에서 블록을 잡은 횟수 (정상 상태에서 늘지 않아야 한다)
+
+	static constexpr size_t MIN_BLOCK_BYTES = 64 * 1024;
+
+public:
+	explicit FrameArena(size_t initialBytes = 1024 * 1024)
+	{
+		addBlock(std::max(initialBytes, MIN_BLOCK_BYTES));
+	}
+
+	FrameArena(const FrameArena &) = delete;
+	FrameArena &operator=(const FrameArena &) = delete;
+
+	// 틱 시작/끝에 호출, 이전에 받은 포인터는 모두 무효
+	void reset()
+	{
+		size_t used = this->used();
+		lastUsed_ = used;
+		peakUsed_ = std::max(peakUsed_, used);
+
+		// 블록 하나로 모자랐으면 다음 틱부터는 한 블록에 들어가도록 합친다 (여유 25%)
+		if (blocks_.size() > 1)
+		{
+			size_t merged = std::max(MIN_BLOCK_BYTES, used + used / 4);
+			blocks_.clear();
+			addBlock(merged);
+		}
+		current_ = 0;
+		offset_ = 0;
+		usedBeforeCurrent_ = 0;
+	}
+
+	// 텍스트용 (정렬 1)
+	char *allocateText(size_t bytes)
+	{
+		return static_cast<char *>(allocate(std::max<size_t>(1, bytes), 1));
+	}
+
+	size_t used() const { return usedBeforeCurrent_ + offset_; }
+	size_t lastUsed() const { return lastUsed_; }
+	size_t peakUsed() const { return peakUsed_; }
+	size_t capacity() const
+	{
+		size_t total = 0;
+		for (const Block &block : blocks_)
+			total += block.size;
+		return total;
+	}
+	long long blockAllocations() const { return blockAllocations_; }
+
+protected:
+	void *do_allocate(size_t bytes, size_t alignment) override
+	{
+		while (true)
+		{
+			Block &block = blocks_[current_];
+			uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+			size_t aligned = ((base + offset_ + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+			if (aligned + bytes <= block.size)
+			{
+				offset_ = aligned + bytes;
+				return block.data.get() + aligned;
+			}
+
+			// 다음 블록 (이번 틱에 이미 있던 것 또는 새로)
+			usedBeforeCurrent_ += block.size;
+			offset_ = 0;
+			current_++;
+			if (current_ == blocks_.size())
+				addBlock(std::max(bytes + alignment, block.size * 2));
+		}
+	}
+
+	void do_deallocate(void *, size_t, size_t) override
+	{
+	}
+
+	bool do_is_equal(const pmr::memory_resource &other) const noexcept override
+	{
+		return this == &other;
+	}
+
+private:
+	void addBlock(size_t size)
+	{
+		blocks_.push_back(Block{ unique_ptr<unsigned char[]>(new unsigned char[size]), size });
+		blockAllocations_++;
+	}
+};
+
+// 아레나에서 잡은 고정 용량 텍스트 버퍼 (용량은 쓰기 전에 상한으로 잡는다)
+// string처럼 append/push_back을 받아서 SnapshotJson.h 쓰기 함수를 그대로 쓸 수 있다
+class FrameText
+{
+private:
+	char *data_ = nullptr;
+	size_t size_ = 0;
+	size_t capacity_ = 0;
+
+public:
+	FrameText() = default;
+	FrameText(FrameArena &arena, size_t capacity)
+		: data_(arena.allocateText(capacity)), capacity_(capacity)
+	{
+	}
+
+	// 상한을 넘는 쓰기는 잘린다 (호출자가 상한을 맞게 잡았으면 일어나지 않음)
+	void append(const char *text, size_t length)
+	{
+		length = std::min(length, capacity_ - size_);
+		memcpy(data_ + size_, text, length);
+		size_ += length;
+	}
+	void append(string_view text) { append(text.data(), text.size()); }
+	void push_back(char c)
+	{
+		if (size_ < capacity_)
+			data_[size_++] = c;
+	}
+	FrameText &operator+=(string_view text)
+	{
+		append(text);
+		return *this;
+	}
+	FrameText &operator+=(char c)
+	{
+		push_back(c);
+		return *this;
+	}
+
+	// 직접 쓰기 (snprintf 등): tail()에 remaining()바이트까지 쓰고 commit(length)
+	char *tail() { return data_ + size_; }
+	size_t remaining() const { return capacity_ - size_; }
+	void commit(size_t length) { size_ += std::min(length, remaining()); }
+
+	size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+	string_view view() const { return string_view(data_, size_); }
+};
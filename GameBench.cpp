@@ -0,0 +1,759 @@
+// 헤드리스 벤치마크 (네트워크 없이 월드/물리만)
+// 사용법: GameBench <scenario> [args...]
+//   history [dummies=10000] [ticks=600] : 상태 기록/되감기 비용 (플레이어 50 + 더미 N)
+//   sleep [dummies=10000] [seconds=10]  : 틱 비용이 깨어 있는 더미 수를 따라가는지 (0.5초 간격 출력)
+//   profiles [ticks=300]                : 씬 프로필 x 더미 수(1k/5k/20k) 매트릭스, 틱 평균/p99
+//   queries [dummies=10000] [queries=500] [ticks=600] : 배치 씬 쿼리 비용 (플레이어 50 접지 + 상호작용 N)
+//   snapshot [dummies=10000] [path=gamebench_room.snap] : 방 콜드 스타트, 처음부터 생성 vs 바이너리 스냅샷 복원
+//   cosmetic [dummies=100000] [ticks=600] : 장식용 더미 SIMD 적분 vs 스칼라, 플레이어 1명이 돌아다니며 승격/강등
+//   parallel [dummies=20000] [ticks=300] : 게임 루프 병렬 단계(동기화/기록/장식용 적분/더미 인코딩) 스레드 1/2/4/8/16 비교
+//   arena [dummies=20000] [ticks=300]   : 틱당 힙 할당/시간, 전체 스냅샷 json DOM(이전) vs 틱 아레나 직접 쓰기(현재)
+//   regions [dummies=100000] [ticks=300] [players=50] : 같은 100m 맵을 영역 씬 1x1/2x2/3x3/4x4로 나눠 스텝 비용, 고스트/이전 수
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <new>
+#include <nlohmann/json.hpp>
+#include "GameWorld.h"
+#include "FrameArena.h"
+#include "SnapshotJson.h"
+
+using namespace std;
+
+// 힙 할당 카운터 (모든 스레드의 operator new, PhysX는 자체 할당자라 제외)
+static atomic<long long> benchAllocations{ 0 };
+
+void *operator new(size_t size)
+{
+	benchAllocations.fetch_add(1, memory_order_relaxed);
+	if (void *pointer = malloc(size ? size : 1))
+		return pointer;
+	throw bad_alloc();
+}
+void operator delete(void *pointer) noexcept { free(pointer); }
+void operator delete(void *pointer, size_t) noexcept { free(pointer); }
+
+// 구간의 힙 할당 수
+template <typename F>
+static long long countAllocations(F &&func)
+{
+	long long before = benchAllocations.load(memory_order_relaxed);
+	func();
+	return benchAllocations.load(memory_order_relaxed) - before;
+}
+
+// 구간 시간 측정 (마이크로초)
+template <typename F>
+static double measureMicros(F &&func)
+{
+	auto start = chrono::steady_clock::now();
+	func();
+	return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+static int argOr(int argc, char *argv[], int index, int fallback)
+{
+	return argc > index ? atoi(argv[index]) : fallback;
+}
+
+static int benchHistory(int argc, char *argv[])
+{
+	int dummyCount = argOr(argc, argv, 2, 10000);
+	int ticks = argOr(argc, argv, 3, 600);
+	const float dt = 1.0f / 60.0f;
+
+	GameWorld world;
+	for (int i = 0; i < world.getMaxPlayers(); ++i)
+	{
+		world.addPlayer("bench" + to_string(i));
+	}
+	world.spawnDummies(dummyCount);
+
+	PhysicsWorld &physics = world.getPhysicsWorld();
+
+	// 링 버퍼가 한 바퀴 돌 때까지 워밍업
+	for (int i = 0; i < StateHistory::CAPACITY; ++i)
+	{
+		world.update(dt);
+	}
+
+	double recordTotal = 0.0, tickTotal = 0.0;
+	for (int i = 0; i < ticks; ++i)
+	{
+		tickTotal += measureMicros([&] { world.update(dt); });
+		recordTotal += physics.getLastRecordMicros();
+	}
+
+	// 되감기: 약 0.5초 전 (보간 위치), 전체 / 반경 5m
+	double rewindAll = 0.0, rewindLocal = 0.0;
+	const int rewinds = 200;
+	PxVec3 center(0.0f, 1.0f, 0.0f);
+	for (int i = 0; i < rewinds; ++i)
+	{
+		double viewTick = physics.getTick() - 30.5;
+		rewindAll += measureMicros([&] { physics.withRewind(viewTick, [] {}); });
+		rewindLocal += measureMicros([&] { physics.withRewind(viewTick, [] {}, &center, 5.0f); });
+	}
+
+	cout << "=== history: 50 players + " << dummyCount << " dummies ===" << endl;
+	cout << fixed << setprecision(2);
+	cout << "History memory:     " << (physics.getHistory().memoryBytes() / 1048576.0) << " MB" << endl;
+	cout << "Tick (total):       " << (tickTotal / ticks) << " us" << endl;
+	cout << "Record:             " << (recordTotal / ticks) << " us/tick" << endl;
+	cout << "Rewind+restore all: " << (rewindAll / rewinds) << " us" << endl;
+	cout << "Rewind+restore r=5: " << (rewindLocal / rewinds) << " us" << endl;
+	return 0;
+}
+
+static int benchSleep(int argc, char *argv[])
+{
+	int dummyCount = argOr(argc, argv, 2, 10000);
+	int seconds = argOr(argc, argv, 3, 10);
+	const float dt = 1.0f / 60.0f;
+	const int window = 30; // 0.5초
+
+	GameWorld world;
+	world.spawnDummies(dummyCount);
+	PhysicsWorld &physics = world.getPhysicsWorld();
+
+	cout << "=== sleep: " << dummyCount << " dummies ===" << endl;
+	cout << setw(8) << "time(s)" << setw(10) << "awake" << setw(12) << "tick(us)" << setw(12) << "us/awake" << endl;
+
+	int ticks = seconds * 60;
+	double windowTotal = 0.0;
+	long long awakeTotal = 0;
+	for (int i = 1; i <= ticks; ++i)
+	{
+		windowTotal += measureMicros([&] { world.update(dt); });
+		awakeTotal += physics.countAwakeDummies(); // 측정 구간 밖에서 센다
+
+		if (i % window == 0)
+		{
+			double avgTick = windowTotal / window;
+			double avgAwake = double(awakeTotal) / window;
+			cout << fixed << setprecision(1)
+				<< setw(8) << (i / 60.0)
+				<< setw(10) << avgAwake
+				<< setw(12) << avgTick
+				<< setw(12) << setprecision(3) << (avgAwake > 0 ? avgTick / avgAwake : 0.0) << endl;
+			windowTotal = 0.0;
+			awakeTotal = 0;
+		}
+	}
+	return 0;
+}
+
+static int benchProfiles(int argc, char *argv[])
+{
+	int ticks = argOr(argc, argv, 2, 300);
+	const float dt = 1.0f / 60.0f;
+	const int dummyCounts[] = { 1000, 5000, 20000 };
+
+	cout << "=== profiles: " << ticks << " ticks each ===" << endl;
+	cout << setw(10) << "profile" << setw(9) << "dummies" << setw(12) << "setup(ms)"
+		<< setw(12) << "avg(ms)" << setw(12) << "p99(ms)" << "  " << "description" << endl;
+
+	for (const auto &profile : sceneProfiles())
+	{
+		for (int dummyCount : dummyCounts)
+		{
+			vector<double> samples;
+			samples.reserve(ticks);
+
+			// 프로필마다 새 월드 (PhysX 파운데이션은 프로세스당 하나라 월드를 먼저 정리)
+			{
+				unique_ptr<GameWorld> world;
+				double setup = measureMicros([&] {
+					world = make_unique<GameWorld>(profile);
+					world->spawnDummies(dummyCount);
+				});
+
+				// 낙하/첫 접촉 구간은 제외
+				for (int i = 0; i < 60; ++i)
+				{
+					world->update(dt);
+				}
+				for (int i = 0; i < ticks; ++i)
+				{
+					samples.push_back(measureMicros([&] { world->update(dt); }));
+				}
+
+				double total = 0.0;
+				for (double sample : samples)
+					total += sample;
+				sort(samples.begin(), samples.end());
+				double p99 = samples[min(samples.size() - 1, samples.size() * 99 / 100)];
+
+				cout << fixed << setprecision(2)
+					<< setw(10) << profile.name
+					<< setw(9) << dummyCount
+					<< setw(12) << setup / 1000.0
+					<< setw(12) << total / ticks / 1000.0
+					<< setw(12) << p99 / 1000.0
+					<< "  " << profile.description << endl;
+			}
+		}
+	}
+	return 0;
+}
+
+static int benchQueries(int argc, char *argv[])
+{
+	int dummyCount = argOr(argc, argv, 2, 10000);
+	int queriesPerTick = argOr(argc, argv, 3, 500);
+	int ticks = argOr(argc, argv, 4, 600);
+	const float dt = 1.0f / 60.0f;
+
+	GameWorld world;
+	for (int i = 0; i < world.getMaxPlayers(); ++i)
+	{
+		world.addPlayer("bench" + to_string(i));
+	}
+	world.spawnDummies(dummyCount);
+	PhysicsWorld &physics = world.getPhysicsWorld();
+	SceneQueryBatch &batch = physics.getQueryBatch();
+
+	mt19937 rng(12345);
+	uniform_real_distribution<float> coord(-25.0f, 25.0f);
+	long long hitCount = 0;
+	auto countHits = [&hitCount](const SceneQueryHit *, size_t count) { hitCount += static_cast<long long>(count); };
+
+	// 상호작용 쿼리 흉내: 레이캐스트(사격) / 스윕(근접) / 오버랩(범위) 을 1:1:1
+	auto queueInteractions = [&] {
+		for (int i = 0; i < queriesPerTick; ++i)
+		{
+			PxVec3 origin(coord(rng), 1.0f, coord(rng));
+			switch (i % 3)
+			{
+			case 0:
+				batch.raycast(origin, PxVec3(1.0f, 0.0f, 0.0f), 20.0f, countHits);
+				break;
+			case 1:
+				batch.sweep(PxSphereGeometry(0.5f), PxTransform(origin), PxVec3(0.0f, 0.0f, 1.0f), 3.0f, countHits);
+				break;
+			default:
+				batch.overlap(PxSphereGeometry(3.0f), PxTransform(origin), countHits);
+				break;
+			}
+		}
+	};
+
+	for (int i = 0; i < 60; ++i)
+	{
+		queueInteractions();
+		world.update(dt);
+	}
+
+	double queryTotal = 0.0, tickTotal = 0.0;
+	hitCount = 0;
+	for (int i = 0; i < ticks; ++i)
+	{
+		queueInteractions();
+		tickTotal += measureMicros([&] { world.update(dt); });
+		queryTotal += batch.lastExecuteMicros();
+	}
+
+	cout << "=== queries: 50 players + " << dummyCount << " dummies, " << queriesPerTick << " interactions/tick ===" << endl;
+	cout << fixed << setprecision(2);
+	cout << "Queries/tick:   " << batch.lastQueryCount() << endl;
+	cout << "Tick (total):   " << (tickTotal / ticks) << " us" << endl;
+	cout << "Batch execute:  " << (queryTotal / ticks) << " us/tick" << endl;
+	cout << "Per query:      " << (queryTotal / ticks / max(1u, batch.lastQueryCount())) << " us" << endl;
+	cout << "Hits/tick:      " << (double(hitCount) / ticks) << endl;
+	return 0;
+}
+
+static int benchSnapshot(int argc, char *argv[])
+{
+	int dummyCount = argOr(argc, argv, 2, 10000);
+	string path = argc > 3 ? argv[3] : "gamebench_room.snap";
+	const float dt = 1.0f / 60.0f;
+
+	double buildMs, saveMs, restoreMs, emptyMs;
+	size_t snapshotBytes = 0;
+
+	// 처음부터: 씬 생성 + 더미마다 모양/질량 계산
+	{
+		unique_ptr<GameWorld> world;
+		buildMs = measureMicros([&] {
+			world = make_unique<GameWorld>();
+			world->spawnDummies(dummyCount);
+		}) / 1000.0;
+
+		// 착지한 상태를 템플릿으로 저장
+		for (int i = 0; i < 180; ++i)
+		{
+			world->update(dt);
+		}
+		saveMs = measureMicros([&] { world->saveSnapshot(path); }) / 1000.0;
+		ifstream in(path, ios::binary | ios::ate);
+		snapshotBytes = in ? static_cast<size_t>(in.tellg()) : 0;
+	}
+
+	// 빈 월드 생성 비용 (복원 시간에서 분리해서 보기 위함)
+	emptyMs = measureMicros([&] { GameWorld empty; }) / 1000.0;
+
+	// 스냅샷에서: 빈 씬 + 매핑된 바이너리 컬렉션 추가
+	{
+		unique_ptr<GameWorld> world;
+		bool ok = false;
+		restoreMs = measureMicros([&] {
+			world = make_unique<GameWorld>();
+			ok = world->loadSnapshot(path);
+		}) / 1000.0;
+		if (!ok)
+		{
+			cerr << "restore failed" << endl;
+			return 1;
+		}
+
+		// 복원 직후 틱이 정상인지 (착지 상태로 시작하므로 대부분 곧 잠든다)
+		double tickTotal = 0.0;
+		for (int i = 0; i < 60; ++i)
+		{
+			tickTotal += measureMicros([&] { world->update(dt); });
+		}
+
+		cout << "=== snapshot: " << dummyCount << " dummies ===" << endl;
+		cout << fixed << setprecision(2);
+		cout << "Snapshot size:       " << (snapshotBytes / 1048576.0) << " MB" << endl;
+		cout << "Save:                " << saveMs << " ms" << endl;
+		cout << "Build from scratch:  " << buildMs << " ms" << endl;
+		cout << "Restore from file:   " << restoreMs << " ms" << endl;
+		cout << "  (empty world:      " << emptyMs << " ms)" << endl;
+		cout << "First 60 ticks avg:  " << (tickTotal / 60 / 1000.0) << " ms, awake "
+			<< world->getPhysicsWorld().countAwakeDummies() << " / " << world->getDummies().size() << endl;
+	}
+	return 0;
+}
+
+static int benchCosmetic(int argc, char *argv[])
+{
+	int dummyCount = argOr(argc, argv, 2, 100000);
+	int ticks = argOr(argc, argv, 3, 600);
+	const float dt = 1.0f / 60.0f;
+
+	// 커널만 (월드 밖 필드, 같은 초기 상태)
+	double kernelMicros[2] = {};
+	CosmeticDummyField::Kernel kernels[2] = { CosmeticDummyField::Kernel::BEST, CosmeticDummyField::Kernel::SCALAR };
+	for (int k = 0; k < 2; ++k)
+	{
+		CosmeticDummyField field;
+		mt19937 rng(1);
+		uniform_real_distribution<float> posDist(-8.75f, 8.75f), phaseDist(0.0f, 1.0f);
+		field.reserve(dummyCount);
+		for (int i = 0; i < dummyCount; ++i)
+			field.add(i, Vector3(posDist(rng), 2.0f, posDist(rng)), Vector3(), phaseDist(rng));
+		for (int i = 0; i < ticks; ++i)
+			kernelMicros[k] += measureMicros([&] { field.step(dt, kernels[k]); });
+	}
+
+	// 월드 전체: 플레이어 하나가 원을 그리며 더미 사이를 지나간다
+	GameWorld world;
+	int playerId = world.addPlayer("bench");
+	int spawned = world.spawnCosmeticDummies(dummyCount);
+	double tickTotal = 0.0, tickMax = 0.0;
+	int promotedMax = 0;
+	for (int i = 0; i < ticks; ++i)
+	{
+		float angle = i * dt * 0.5f;
+		world.setPlayerInput(playerId, Vector3(-sinf(angle), 0.0f, cosf(angle)));
+		double micros = measureMicros([&] { world.update(dt); });
+		tickTotal += micros;
+		tickMax = max(tickMax, micros);
+		promotedMax = max(promotedMax, world.getPromotedCount());
+	}
+
+	const double budget = 1000000.0 / 60.0;
+	cout << "=== cosmetic: " << spawned << " dummies, " << ticks << " ticks ===" << endl;
+	cout << fixed << setprecision(1);
+	cout << "Kernel (" << CosmeticDummyField::kernelName() << "):   " << (kernelMicros[0] / ticks) << " us/tick" << endl;
+	cout << "Kernel (scalar): " << (kernelMicros[1] / ticks) << " us/tick ("
+		<< setprecision(2) << (kernelMicros[1] / max(1.0, kernelMicros[0])) << "x)" << endl;
+	cout << setprecision(1);
+	cout << "World tick:      " << (tickTotal / ticks) << " us avg, " << tickMax << " us max ("
+		<< (tickTotal / ticks / budget * 100.0) << "% of 60 Hz budget)" << endl;
+	cout << "Promoted:        " << world.getPromotedCount() << " now, " << promotedMax << " peak" << endl;
+	return 0;
+}
+
+// 서버 전체 스냅샷과 같은 방식으로 더미 배열을 청크 병렬 인코딩 (바이트 수 반환)
+// chunks는 이번 틱 아레나로 새로 만든 빈 벡터
+static size_t encodeDummies(GameWorld &world, FrameArena &arena, pmr::vector<FrameText> &chunks)
+{
+	const size_t grain = 2048;
+	size_t count = world.getTotalDummyCount();
+	size_t chunkCount = (count + grain - 1) / grain;
+	chunks.reserve(chunkCount);
+	for (size_t c = 0; c < chunkCount; ++c)
+		chunks.emplace_back(arena, min(grain, count - c * grain) * (DUMMY_JSON_MAX_BYTES + 1));
+
+	parallelFor(world.getTaskPool(), count, grain, [&](size_t begin, size_t end)
+		{
+			for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grain)
+			{
+				FrameText &text = chunks[chunkBegin / grain];
+				world.forEachDummyInRange(chunkBegin, min(end, chunkBegin + grain), [&](int id, const Vector3 &position, const Vector3 &)
+					{
+						if (!text.empty())
+							text.push_back(',');
+						text.commit(writeDummyJson(text.tail(), id, position));
+					});
+			}
+		});
+
+	size_t bytes = 2;
+	for (const FrameText &text : chunks)
+		bytes += text.size() + 1;
+	return bytes;
+}
+
+// 이전 서버 방식: 더미마다 json DOM을 만들어 dump (arena 시나리오의 비교 기준)
+static size_t encodeDummiesJson(GameWorld &world, vector<string> &chunks)
+{
+	const size_t grain = 2048;
+	size_t count = world.getTotalDummyCount();
+	size_t chunkCount = (count + grain - 1) / grain;
+	chunks.resize(max(chunks.size(), chunkCount));
+	for (size_t c = 0; c < chunkCount; ++c)
+		chunks[c].clear();
+
+	parallelFor(world.getTaskPool(), count, grain, [&](size_t begin, size_t end)
+		{
+			string &text = chunks[begin / grain];
+			world.forEachDummyInRange(begin, end, [&](int id, const Vector3 &position, const Vector3 &)
+				{
+					nlohmann::json d;
+					d["id"] = id;
+					d["pos"] = { position.x, position.y, position.z };
+					if (!text.empty())
+						text += ',';
+					text += d.dump();
+				});
+		});
+
+	size_t bytes = 2;
+	for (size_t c = 0; c < chunkCount; ++c)
+		bytes += chunks[c].size() + 1;
+	return bytes;
+}
+
+static int benchParallel(int argc, char *argv[])
+{
+	int dummyCount = argOr(argc, argv, 2, 20000);
+	int ticks = argOr(argc, argv, 3, 300);
+	const float dt = 1.0f / 60.0f;
+	const int threadCounts[] = { 1, 2, 4, 8, 16 };
+
+	cout << "=== parallel: " << dummyCount << " actor dummies + " << dummyCount << " cosmetic, "
+		<< ticks << " ticks, " << thread::hardware_concurrency() << " hardware threads ===" << endl;
+	cout << setw(8) << "threads" << setw(12) << "update(us)" << setw(12) << "record(us)"
+		<< setw(12) << "encode(us)" << setw(12) << "total(us)" << setw(10) << "speedup" << setw(10) << "steals" << endl;
+
+	double baseline = 0.0;
+	for (int threads : threadCounts)
+	{
+		// 매번 같은 초기 배치가 아니어도 더미 수와 깨어 있는 비율은 비슷하다 (워밍업으로 초기 낙하 제외)
+		GameWorld world;
+		world.setWorkerThreads(threads);
+		int playerId = world.addPlayer("bench");
+		world.spawnDummies(dummyCount);
+		world.spawnCosmeticDummies(dummyCount);
+		for (int i = 0; i < 120; ++i)
+			world.update(dt);
+
+		FrameArena arena;
+		double updateTotal = 0.0, recordTotal = 0.0, encodeTotal = 0.0;
+		for (int i = 0; i < ticks; ++i)
+		{
+			float angle = i * dt * 0.5f;
+			world.setPlayerInput(playerId, Vector3(-sinf(angle), 0.0f, cosf(angle)));
+			updateTotal += measureMicros([&] { world.update(dt); });
+			recordTotal += world.getPhysicsWorld().getLastRecordMicros();
+			arena.reset();
+			encodeTotal += measureMicros([&]
+				{
+					pmr::vector<FrameText> chunks(&arena);
+					encodeDummies(world, arena, chunks);
+				});
+		}
+
+		double total = (updateTotal + encodeTotal) / ticks;
+		if (threads == 1)
+			baseline = total;
+		TaskPool *pool = world.getTaskPool();
+		cout << fixed << setprecision(1)
+			<< setw(8) << threads
+			<< setw(12) << (updateTotal / ticks)
+			<< setw(12) << (recordTotal / ticks)
+			<< setw(12) << (encodeTotal / ticks)
+			<< setw(12) << total
+			<< setw(9) << setprecision(2) << (baseline / max(1.0, total)) << "x"
+			<< setw(10) << (pool ? pool->steals() : 0) << endl;
+	}
+	cout << "(update includes PhysX simulate, which uses the scene profile's dispatcher threads)" << endl;
+	return 0;
+}
+
+// 이전 서버의 전체 스냅샷: 플레이어/나머지 필드는 json DOM, 더미 배열을 dump 결과 맨 앞에 끼워 넣고 관전자용으로 한 번 더 복사
+static size_t encodeSnapshotJson(GameWorld &world, vector<string> &chunks, string &spectatorCopy)
+{
+	size_t dummyBytes = encodeDummiesJson(world, chunks);
+
+	nlohmann::json players = nlohmann::json::array();
+	for (const auto &player : world.getPlayers())
+	{
+		if (player == nullptr)
+			continue;
+		nlohmann::json p;
+		p["id"] = player->id;
+		p["nickname"] = player->nickname;
+		p["pos"] = { player->position.x, player->position.y, player->position.z };
+		p["vel"] = { player->velocity.x, player->velocity.y, player->velocity.z };
+		p["color"] = { player->color.r, player->color.g, player->color.b };
+		players.push_back(p);
+	}
+	nlohmann::json data;
+	data["type"] = 4;
+	data["tick"] = world.getTick();
+	data["players"] = players;
+	string rest = data.dump();
+
+	string text;
+	text.reserve(rest.size() + dummyBytes + 16);
+	text += "{\"dummies\":[";
+	bool first = true;
+	for (const string &chunk : chunks)
+	{
+		if (chunk.empty())
+			continue;
+		if (!first)
+			text += ',';
+		text += chunk;
+		first = false;
+	}
+	text += "],";
+	text.append(rest, 1, string::npos);
+	spectatorCopy = text;
+	return text.size();
+}
+
+// 현재 서버의 전체 스냅샷: 틱 아레나에 직접 쓰기 (관전자는 같은 텍스트를 본다)
+static size_t encodeSnapshotArena(GameWorld &world, FrameArena &arena)
+{
+	pmr::vector<FrameText> chunks(&arena);
+	size_t dummyBytes = encodeDummies(world, arena, chunks);
+	FrameText text(arena, 96 + playersJsonMaxBytes(world.getPlayers()) + dummyBytes + 16);
+	char header[96];
+	int headerLength = snprintf(header, sizeof(header), "{\"type\":4,\"tick\":%u,\"players\":", world.getTick());
+	text.append(header, static_cast<size_t>(headerLength));
+	appendPlayersJson(text, world.getPlayers());
+	text += ",\"dummies\":[";
+	bool first = true;
+	for (const FrameText &chunk : chunks)
+	{
+		if (chunk.empty())
+			continue;
+		if (!first)
+			text += ',';
+		text += chunk.view();
+		first = false;
+	}
+	text += "]}";
+	return text.size();
+}
+
+static int benchArena(int argc, char *argv[])
+{
+	int dummyCount = argOr(argc, argv, 2, 20000);
+	int ticks = argOr(argc, argv, 3, 300);
+	const float dt = 1.0f / 60.0f;
+
+	cout << "=== arena: 16 players + " << dummyCount << " actor dummies + " << dummyCount << " cosmetic, "
+		<< ticks << " ticks ===" << endl;
+	cout << setw(8) << "encoder" << setw(14) << "update(us)" << setw(14) << "update alloc" << setw(14) << "encode(us)"
+		<< setw(14) << "encode alloc" << setw(12) << "bytes" << setw(14) << "arena(KB)" << endl;
+
+	for (int useArena = 0; useArena <= 1; ++useArena)
+	{
+		GameWorld world;
+		int firstPlayer = -1;
+		for (int i = 0; i < 16; ++i)
+		{
+			int playerId = world.addPlayer("bench \"" + to_string(i) + "\"");
+			if (firstPlayer < 0)
+				firstPlayer = playerId;
+		}
+		world.spawnDummies(dummyCount);
+		world.spawnCosmeticDummies(dummyCount);
+
+		FrameArena arena;
+		vector<string> chunks;
+		string spectatorCopy;
+		size_t bytes = 0;
+		auto encode = [&]
+			{
+				if (useArena)
+				{
+					arena.reset();
+					bytes = encodeSnapshotArena(world, arena);
+				}
+				else
+				{
+					bytes = encodeSnapshotJson(world, chunks, spectatorCopy);
+				}
+			};
+		for (int i = 0; i < 120; ++i)
+		{
+			world.update(dt);
+			encode();
+		}
+
+		double updateTotal = 0.0, encodeTotal = 0.0;
+		long long updateAllocs = 0, encodeAllocs = 0;
+		for (int i = 0; i < ticks; ++i)
+		{
+			float angle = i * dt * 0.5f;
+			world.setPlayerInput(firstPlayer, Vector3(-sinf(angle), 0.0f, cosf(angle)));
+			updateAllocs += countAllocations([&] { updateTotal += measureMicros([&] { world.update(dt); }); });
+			encodeAllocs += countAllocations([&] { encodeTotal += measureMicros(encode); });
+		}
+
+		cout << fixed << setprecision(1)
+			<< setw(8) << (useArena ? "arena" : "json")
+			<< setw(14) << (updateTotal / ticks)
+			<< setw(14) << (double(updateAllocs) / ticks)
+			<< setw(14) << (encodeTotal / ticks)
+			<< setw(14) << (double(encodeAllocs) / ticks)
+			<< setw(12) << bytes
+			<< setw(14) << (useArena ? to_string(arena.lastUsed() >> 10) : string("-")) << endl;
+	}
+	cout << "(alloc = operator new calls per tick on all threads; PhysX uses its own allocator)" << endl;
+	return 0;
+}
+
+static int benchRegions(int argc, char *argv[])
+{
+	int dummyCount = argOr(argc, argv, 2, 100000);
+	int ticks = argOr(argc, argv, 3, 300);
+	const float dt = 1.0f / 60.0f;
+	const float mapSize = 100.0f;
+	int playerCount = max(1, argOr(argc, argv, 4, 50));
+	const int grids[] = { 1, 2, 3, 4 };
+
+	cout << "=== regions: " << dummyCount << " dummies + " << playerCount << " players on a " << mapSize << " m map, "
+		<< ticks << " ticks, " << thread::hardware_concurrency() << " hardware threads ===" << endl;
+	cout << setw(6) << "grid" << setw(12) << "setup(ms)" << setw(12) << "avg(ms)" << setw(12) << "p99(ms)"
+		<< setw(10) << "speedup" << setw(10) << "ghosts" << setw(14) << "handoffs/tick" << endl;
+
+	double baseline = 0.0;
+	for (int grid : grids)
+	{
+		vector<double> samples;
+		samples.reserve(ticks);
+		uint32_t ghosts = 0;
+		long long handoffs = 0;
+		double setup = 0.0;
+
+		// 격자마다 새 월드 (같은 시드로 같은 배치), 영역 판정은 게임 루프 풀에서
+		{
+			TaskPool pool(static_cast<int>(thread::hardware_concurrency()));
+			unique_ptr<PhysicsWorld> physics;
+			setup = measureMicros([&] {
+				physics = make_unique<PhysicsWorld>(defaultSceneProfile(), mapSize, grid, playerCount);
+				physics->setTaskPool(&pool);
+				mt19937 rng(1234);
+				uniform_real_distribution<float> posDist(-mapSize * 0.45f, mapSize * 0.45f);
+				for (int i = 0; i < dummyCount; ++i)
+					physics->createDummyActor(i, Vector3(posDist(rng), 2.0f, posDist(rng)));
+				for (int i = 0; i < playerCount; ++i)
+					physics->createPlayerActor(i, Vector3(posDist(rng), 1.0f, posDist(rng)));
+			});
+
+			// 낙하/첫 접촉 구간은 제외, 플레이어는 맵을 가로지르며 원을 그린다 (경계를 넘나들도록)
+			for (int i = 0; i < 60 + ticks; ++i)
+			{
+				float angle = i * dt * 0.5f;
+				for (int p = 0; p < playerCount; ++p)
+				{
+					float phase = angle + p * 0.7f;
+					physics->applyPlayerInput(p, Vector3(-sinf(phase), 0.0f, cosf(phase)));
+				}
+				if (i < 60)
+				{
+					physics->simulate(dt);
+					continue;
+				}
+				samples.push_back(measureMicros([&] { physics->simulate(dt); }));
+				ghosts = max(ghosts, physics->getTickStats().ghostActors);
+			}
+			handoffs = physics->getHandoffsTotal();
+			physics->setTaskPool(nullptr);
+		}
+
+		double total = 0.0;
+		for (double sample : samples)
+			total += sample;
+		sort(samples.begin(), samples.end());
+		double p99 = samples[min(samples.size() - 1, samples.size() * 99 / 100)];
+		double average = total / ticks;
+		if (grid == 1)
+			baseline = average;
+
+		cout << fixed << setprecision(2)
+			<< setw(4) << grid << "x" << grid
+			<< setw(12) << setup / 1000.0
+			<< setw(12) << average / 1000.0
+			<< setw(12) << p99 / 1000.0
+			<< setw(9) << (baseline / max(1.0, average)) << "x"
+			<< setw(10) << ghosts
+			<< setw(14) << double(handoffs) / (60 + ticks) << endl;
+	}
+	cout << "(simulate = all region scenes + region/ghost update + history + batched queries; ghosts = peak per tick)" << endl;
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	struct Scenario
+	{
+		const char *name;
+		function<int(int, char *[])> run;
+	};
+	vector<Scenario> scenarios = {
+		{ "history", benchHistory },
+		{ "sleep", benchSleep },
+		{ "profiles", benchProfiles },
+		{ "queries", benchQueries },
+		{ "snapshot", benchSnapshot },
+		{ "cosmetic", benchCosmetic },
+		{ "parallel", benchParallel },
+		{ "arena", benchArena },
+		{ "regions", benchRegions },
+	};
+
+	if (argc >= 2)
+	{
+		for (auto &scenario : scenarios)
+		{
+			if (scenario.name == string(argv[1]))
+				return scenario.run(argc, argv);
+		}
+	}
+
+	cerr << "Usage: GameBench <scenario> [args...]" << endl;
+	cerr << "Scenarios:";
+	for (auto &scenario : scenarios)
+		cerr << " " << scenario.name;
+	cerr << endl;
+	return 1;
+}
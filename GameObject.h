@@ -46,8 +46,9 @@ struct DummyObject
 	Vector3 position;
 	Vector3 velocity;
 	float radius;
+	bool cosmetic; // 장식용 더미에서 승격된 액터 (플레이어가 멀어지면 다시 내린다)
 
-	DummyObject(int id, Vector3 pos, Vector3 vel)
-		: id(id), position(pos), velocity(vel), radius(0.5f) {
+	DummyObject(int id, Vector3 pos, Vector3 vel, bool cosmetic = false)
+		: id(id), position(pos), velocity(vel), radius(0.5f), cosmetic(cosmetic) {
 	}
 };
\ No newline at end of file
@@ -1,46 +1,91 @@
 #pragma once
 #include "GameObject.h"
-#include "Physicsworld.h"
+#include "PhysicsWorld.h"
+#include "CosmeticDummies.h"
+#include "TaskPool.h"
 #include <vector>
 #include <memory>
 #include <random>
 #include <array>
+#include <unordered_map>
+#include <string>
+#include <cstring>
 
 using namespace std;
 
 class GameWorld
 {
 private:
-	array<unique_ptr<Player>, 50> players_;
+	vector<unique_ptr<Player>> players_; // 인덱스가 플레이어 id, 크기가 정원
 	vector<unique_ptr<DummyObject>> dummies_;
+	unordered_map<int, DummyObject*> dummyById_; // 움직인 더미만 동기화할 때 사용
 
 	unique_ptr<PhysicsWorld> physicsWorld_;
 
+	// 더미별 단계(동기화, 상태 기록, 장식용 적분, 스냅샷 인코딩)를 나눠 돌릴 풀, 없으면 단일 스레드
+	// PhysX 디스패처 스레드와는 시간이 겹치지 않는다 (simulate/fetchResults 바깥 단계만)
+	unique_ptr<TaskPool> taskPool_;
+	static const size_t COSMETIC_GRAIN = 8192; // SIMD 폭(8)의 배수
+
+	// 장식용 더미 (PhysX 밖 SIMD 적분, 플레이어 접촉 거리 안에 들어오면 액터로 승격)
+	CosmeticDummyField cosmetic_;
+	vector<Vector3> playerPoints_;  // 승격/강등 판정용 스크래치
+	vector<size_t> nearIndices_;
+	int promotedCount_ = 0;
+	uint32_t cosmeticTicks_ = 0;
+
+	const float PROMOTE_RADIUS = 2.5f;  // 플레이어 반경 + 더미 반경 + 한 틱 이동 여유
+	const float DEMOTE_RADIUS = 6.0f;   // 승격/강등이 경계에서 반복되지 않도록 더 멀리
+	const uint32_t DEMOTE_CHECK_TICKS = 30;
+	const size_t MAX_COSMETIC_DUMMIES = 250000;
+
 	const float PLAYER_SPEED = 5.0f;
-	const float MAP_SIZE = 25.0f;
+	const float MAP_SIZE = 25.0f; // 영역 한 칸 크기 (맵 전체는 regionGrid_배)
+
+	int regionGrid_;
+	float mapSize_;
 
 	mt19937 rng_; // �����Լ�����
 	int nextDummyId_ = 0; //���� Id ī����
 
 public:
-	GameWorld()
+	// regionGrid: 맵을 N x N 영역 씬으로 나눈다 (1..8, 칸마다 기존 맵 크기)
+	// maxPlayers: 플레이어 정원 (슬롯 수, 1..4096)
+	GameWorld(const SceneProfile& profile = defaultSceneProfile(), int regionGrid = 1, int maxPlayers = 50)
+		: players_(min(max(maxPlayers, 1), 4096)), regionGrid_(min(max(regionGrid, 1), 8)), mapSize_(MAP_SIZE * regionGrid_)
 	{
 		rng_.seed(random_device{}());
-		physicsWorld_ = make_unique<PhysicsWorld>();
+		physicsWorld_ = make_unique<PhysicsWorld>(profile, mapSize_, regionGrid_, static_cast<int>(players_.size()));
+		cosmetic_.setRestitution(profile.restitution);
+	}
+
+	// 게임 루프 쪽 병렬 단계의 스레드 수 (호출 스레드 포함, 1 이하면 단일 스레드)
+	void setWorkerThreads(int threads)
+	{
+		physicsWorld_->setTaskPool(nullptr);
+		taskPool_.reset();
+		if (threads > 1)
+			taskPool_ = make_unique<TaskPool>(threads);
+		physicsWorld_->setTaskPool(taskPool_.get());
 	}
+	TaskPool* getTaskPool() { return taskPool_.get(); }
+	int getWorkerThreads() const { return taskPool_ ? taskPool_->threadCount() : 1; }
 
 	int addPlayer(string nickname = "Player", Color color = Color(1.0f, 1.0f, 1.0f))
 	{
-		for (int i = 0; i < 50; i++)
+		for (int i = 0; i < getMaxPlayers(); i++)
 		{
 			if (players_[i] == nullptr)
 			{
-				//시작 위치 (원형으로 배치)
-				float angle = i * 3.14159f * 2.0f / 50.0f;
+				//시작 위치 (원형으로 배치, 50명마다 바깥 원으로, 맵 밖으로 나가면 안쪽 원부터 각도를 비껴 다시)
+				int ring = i / 50;
+				int ringCount = max(1, static_cast<int>((mapSize_ * 0.45f - 8.0f * regionGrid_) / 2.0f) + 1);
+				float angle = ((i % 50) + (ring / ringCount) * 0.37f) * 3.14159f * 2.0f / 50.0f;
+				float radius = 8.0f * regionGrid_ + (ring % ringCount) * 2.0f;
 				Vector3 startPos(
-					cos(angle) * 8.0f,
+					cos(angle) * radius,
 					1.0f,
-					sin(angle) * 8.0f
+					sin(angle) * radius
 				);
 
 				players_[i] = make_unique<Player>(i, startPos, color, nickname);
@@ -48,25 +93,25 @@ public:
 				//PhysX Actor 생성
 				physicsWorld_->createPlayerActor(i, startPos);
 
-				cout << "Player " << i << " (" << nickname << ") joined (slot assigned)" << endl;
+				LOG_INFO << "Player " << i << " (" << nickname << ") joined (slot assigned)";
 				return i;
 			}
 		}
-		cout << "No available slots!" << endl;
+		LOG_EVERY_MS(LogLevel::WARN, 1000) << "No available slots!";
 		return -1;
 	}
 	void removePlayer(int playerId)
 	{
-		if (playerId >= 0 && playerId < 50 && players_[playerId] != nullptr)
+		if (playerId >= 0 && playerId < getMaxPlayers() && players_[playerId] != nullptr)
 		{
-			cout << "Player " << playerId << " removed (slot freed)" << endl;
+			LOG_INFO << "Player " << playerId << " removed (slot freed)";
 			physicsWorld_->removePlayer(playerId);
 			players_[playerId].reset();
 		}
 	}
 	void spawnDummies(int count = 10)
 	{
-		uniform_real_distribution<float> posDist(-MAP_SIZE * 0.35f, MAP_SIZE * 0.35f);
+		uniform_real_distribution<float> posDist(-mapSize_ * 0.35f, mapSize_ * 0.35f);
 		
 		for (int i = 0; i < count; ++i)
 		{
@@ -78,23 +123,136 @@ public:
 			int dummyId = nextDummyId_++;
 
 			dummies_.push_back(make_unique<DummyObject>(dummyId, pos, Vector3()));
+			dummyById_[dummyId] = dummies_.back().get();
 			physicsWorld_->createDummyActor(dummyId, pos);
 		}
 	}
-	void deleteAllDummies()
+	// 장식용 더미 생성 (PhysX 액터 없음), 실제로 만든 수 반환
+	int spawnCosmeticDummies(int count)
 	{
-		//physX Actor ����
-		for (auto& dummy : dummies_)
+		uniform_real_distribution<float> posDist(-mapSize_ * 0.35f, mapSize_ * 0.35f);
+		uniform_real_distribution<float> phaseDist(0.0f, 1.0f);
+
+		size_t room = MAX_COSMETIC_DUMMIES > cosmetic_.size() ? MAX_COSMETIC_DUMMIES - cosmetic_.size() : 0;
+		int spawned = static_cast<int>(min<size_t>(room, static_cast<size_t>(max(0, count))));
+		cosmetic_.reserve(cosmetic_.size() + spawned);
+		for (int i = 0; i < spawned; ++i)
 		{
-			physicsWorld_->removeDummy(dummy->id);
+			Vector3 pos(
+				posDist(rng_),
+				2.0f,
+				posDist(rng_)
+			);
+			cosmetic_.add(nextDummyId_++, pos, Vector3(), phaseDist(rng_));
 		}
-		//���� ����
+		return spawned;
+	}
+	void deleteAllDummies()
+	{
+		// PhysX 액터 일괄 삭제 후 목록 정리
+		physicsWorld_->removeAllDummies();
+		dummyById_.clear();
 		dummies_.clear();
+		cosmetic_.clear();
+		promotedCount_ = 0;
+	}
+
+	// 방 스냅샷 저장 (더미 액터 + 엔티티 테이블, 플레이어는 재접속하므로 제외)
+	// 장식용 더미는 PhysX 컬렉션에 없으므로 저장하지 않는다 (승격된 것은 일반 더미로 저장됨)
+	bool saveSnapshot(const string& path)
+	{
+		PxDefaultMemoryOutputStream physxData;
+		if (!physicsWorld_->serializeDummies(physxData))
+		{
+			LOG_ERROR << "Room snapshot serialization failed";
+			return false;
+		}
+
+		RoomSnapshotHeader header = {};
+		memcpy(header.magic, RoomSnapshotHeader::expectedMagic(), sizeof(header.magic));
+		header.version = RoomSnapshotHeader::VERSION;
+		header.dummyCount = static_cast<uint32_t>(dummies_.size());
+		header.nextDummyId = nextDummyId_;
+		size_t tableEnd = sizeof(header) + dummies_.size() * sizeof(int32_t);
+		size_t align = RoomSnapshotHeader::PHYSX_ALIGN;
+		header.physxOffset = static_cast<uint32_t>((tableEnd + align - 1) / align * align);
+		header.physxSize = physxData.getSize();
+
+		string file(header.physxOffset + header.physxSize, '\0');
+		memcpy(&file[0], &header, sizeof(header));
+		for (size_t i = 0; i < dummies_.size(); ++i)
+		{
+			int32_t id = dummies_[i]->id;
+			memcpy(&file[sizeof(header) + i * sizeof(int32_t)], &id, sizeof(id));
+		}
+		memcpy(&file[header.physxOffset], physxData.getData(), header.physxSize);
+		header.checksum = RoomSnapshotHeader::computeChecksum(file.data(), sizeof(header), file.size());
+		memcpy(&file[0], &header, sizeof(header));
+
+		if (!writeFileAtomically(path, file))
+		{
+			LOG_ERROR << "Room snapshot write failed: " << path;
+			return false;
+		}
+		return true;
+	}
+
+	// 방 스냅샷 복원 (기존 더미는 지우고 스냅샷 것으로 교체, 파일이 잘못됐으면 기존 방 유지)
+	bool loadSnapshot(const string& path)
+	{
+		unique_ptr<MappedFile> file = MappedFile::open(path);
+		if (!file || file->size() < sizeof(RoomSnapshotHeader))
+		{
+			LOG_ERROR << "Room snapshot not readable: " << path;
+			return false;
+		}
+
+		RoomSnapshotHeader header;
+		memcpy(&header, file->data(), sizeof(header));
+		if (!header.valid(file->size()))
+		{
+			LOG_ERROR << "Room snapshot invalid or from another version: " << path;
+			return false;
+		}
+
+		size_t dataEnd = static_cast<size_t>(header.physxOffset + header.physxSize);
+		if (RoomSnapshotHeader::computeChecksum(file->data(), sizeof(header), dataEnd) != header.checksum)
+		{
+			LOG_ERROR << "Room snapshot checksum mismatch (truncated or corrupt): " << path;
+			return false;
+		}
+
+		vector<int32_t> tableIds(header.dummyCount);
+		if (!tableIds.empty())
+			memcpy(tableIds.data(), file->data() + sizeof(header), tableIds.size() * sizeof(int32_t));
+
+		// 컬렉션을 만든 뒤에만 기존 더미를 지운다 (실패하면 방은 그대로)
+		vector<int> restoredIds;
+		if (!physicsWorld_->deserializeDummies(move(file), header.physxOffset, restoredIds, [this] { deleteAllDummies(); }))
+			return false;
+		if (restoredIds.size() != tableIds.size())
+		{
+			LOG_WARN << "Room snapshot table mismatch: " << tableIds.size() << " entries, "
+				<< restoredIds.size() << " actors";
+		}
+
+		// 엔티티 테이블은 실제로 복원된 액터 기준으로 다시 만든다
+		dummies_.reserve(restoredIds.size());
+		for (int dummyId : restoredIds)
+		{
+			Vector3 pos = physicsWorld_->getDummyPosition(dummyId);
+			dummies_.push_back(make_unique<DummyObject>(dummyId, pos, Vector3()));
+			dummyById_[dummyId] = dummies_.back().get();
+		}
+		nextDummyId_ = header.nextDummyId;
+
+		LOG_INFO << "Room snapshot restored: " << dummies_.size() << " dummies from " << path;
+		return true;
 	}
 	// �÷��̾� �Է� ����
 	void setPlayerInput(int playerId, const Vector3& movement)
 	{
-		if (playerId>=0 && playerId < 50 && players_[playerId]!=nullptr)
+		if (playerId>=0 && playerId < getMaxPlayers() && players_[playerId]!=nullptr)
 		{
 			players_[playerId]->inputMovement = movement;
 		}
@@ -103,7 +261,7 @@ public:
 	// 플레이어 점프
 	void playerJump(int playerId)
 	{
-		if (playerId >= 0 && playerId < 50 && players_[playerId] != nullptr)
+		if (playerId >= 0 && playerId < getMaxPlayers() && players_[playerId] != nullptr)
 		{
 			physicsWorld_->applyPlayerJump(playerId);
 		}
@@ -113,7 +271,7 @@ public:
 	void update(float deltaTime)
 	{
 		// �÷��̾� �Է��� PhysX�� ����
-		for (int i = 0; i < 50; ++i)
+		for (int i = 0; i < getMaxPlayers(); ++i)
 		{
 			if (players_[i] != nullptr && players_[i]->active)
 			{
@@ -125,7 +283,7 @@ public:
 		physicsWorld_->simulate(deltaTime);
 
 		// PhysX ����� ���� ������Ʈ�� ����ȭ
-		for (int i = 0; i < 50; ++i)
+		for (int i = 0; i < getMaxPlayers(); ++i)
 		{
 			if (players_[i] != nullptr)
 			{
@@ -134,12 +292,129 @@ public:
 			}
 		}
 
-		for (auto& dummy : dummies_)
+		// 잠든 더미는 위치가 그대로이므로 이번 스텝에 움직인 더미만 갱신
+		// 속도는 위치 차이로 (스냅샷 우선순위용, 잠들기 직전 속도는 거의 0)
+		// 청크 병렬: 맵은 찾기만 하고 더미마다 자기 객체에만 쓴다
+		float inverseDelta = deltaTime > 0.0f ? 1.0f / deltaTime : 0.0f;
+		physicsWorld_->forEachActiveDummy([this, inverseDelta](int dummyId, const Vector3& position)
+			{
+				auto it = dummyById_.find(dummyId);
+				if (it != dummyById_.end())
+				{
+					DummyObject* dummy = it->second;
+					dummy->velocity = Vector3(
+						(position.x - dummy->position.x) * inverseDelta,
+						(position.y - dummy->position.y) * inverseDelta,
+						(position.z - dummy->position.z) * inverseDelta);
+					dummy->position = position;
+				}
+			});
+
+		// 장식용 더미는 PhysX와 같은 스텝 상한으로 적분
+		float cosmeticDelta = min(deltaTime, 2.0f / 60.0f);
+		parallelFor(taskPool_.get(), cosmetic_.size(), COSMETIC_GRAIN, [this, cosmeticDelta](size_t begin, size_t end)
+			{
+				cosmetic_.stepRange(cosmeticDelta, begin, end);
+			});
+		updateCosmeticTier();
+	}
+
+	// 플레이어 근처 장식용 더미는 PhysX 액터로 승격 (밀고 부딪힐 수 있도록)
+	// 승격된 더미는 가끔 확인해서 모든 플레이어가 충분히 멀어졌으면 다시 장식용으로 내린다
+	void updateCosmeticTier()
+	{
+		playerPoints_.clear();
+		for (const auto& player : players_)
+		{
+			if (player != nullptr)
+				playerPoints_.push_back(player->position);
+		}
+
+		// 내림차순 인덱스라 바로 swap-remove 해도 남은 인덱스가 유효
+		cosmetic_.collectNear(playerPoints_, PROMOTE_RADIUS, nearIndices_);
+		for (size_t index : nearIndices_)
+		{
+			int dummyId = cosmetic_.id(index);
+			Vector3 pos = cosmetic_.position(index);
+			Vector3 vel = cosmetic_.velocity(index);
+			cosmetic_.removeAt(index);
+
+			dummies_.push_back(make_unique<DummyObject>(dummyId, pos, vel, true));
+			dummyById_[dummyId] = dummies_.back().get();
+			physicsWorld_->createDummyActor(dummyId, pos);
+			physicsWorld_->setDummyVelocity(dummyId, vel);
+			promotedCount_++;
+		}
+
+		if (promotedCount_ == 0 || ++cosmeticTicks_ % DEMOTE_CHECK_TICKS != 0)
+			return;
+
+		uniform_real_distribution<float> phaseDist(0.0f, 1.0f);
+		const float demoteSq = DEMOTE_RADIUS * DEMOTE_RADIUS;
+		for (size_t i = dummies_.size(); i-- > 0;)
+		{
+			DummyObject* dummy = dummies_[i].get();
+			if (!dummy->cosmetic)
+				continue;
+
+			bool near = false;
+			for (const Vector3& point : playerPoints_)
+			{
+				float dx = dummy->position.x - point.x;
+				float dy = dummy->position.y - point.y;
+				float dz = dummy->position.z - point.z;
+				if (dx * dx + dy * dy + dz * dz <= demoteSq)
+				{
+					near = true;
+					break;
+				}
+			}
+			if (near)
+				continue;
+
+			int dummyId = dummy->id;
+			cosmetic_.add(dummyId, dummy->position, physicsWorld_->getDummyVelocity(dummyId), phaseDist(rng_));
+			physicsWorld_->removeDummy(dummyId);
+			dummyById_.erase(dummyId);
+			if (i != dummies_.size() - 1)
+				dummies_[i] = move(dummies_.back());
+			dummies_.pop_back();
+			promotedCount_--;
+		}
+	}
+
+	// 액터 더미와 장식용 더미를 모두 순회 func(id, position, velocity)
+	template <typename F>
+	void forEachDummy(F&& func) const
+	{
+		forEachDummyInRange(0, getTotalDummyCount(), forward<F>(func));
+	}
+
+	// 액터 더미 다음 장식용 더미 순서로 이어 붙인 인덱스 [begin, end) 구간만 (청크 병렬 인코딩용)
+	template <typename F>
+	void forEachDummyInRange(size_t begin, size_t end, F&& func) const
+	{
+		size_t actorCount = dummies_.size();
+		for (size_t i = begin; i < min(end, actorCount); ++i)
+		{
+			const DummyObject& dummy = *dummies_[i];
+			func(dummy.id, dummy.position, dummy.velocity);
+		}
+		for (size_t i = max(begin, actorCount); i < end; ++i)
 		{
-			dummy->position = physicsWorld_->getDummyPosition(dummy->id);
+			size_t index = i - actorCount;
+			func(cosmetic_.id(index), cosmetic_.position(index), cosmetic_.velocity(index));
 		}
 	}
 	//Getter
-	const array<unique_ptr<Player>,50>& getPlayers() const { return players_; }
+	uint32_t getTick() const { return physicsWorld_->getTick(); }
+	PhysicsWorld& getPhysicsWorld() { return *physicsWorld_; }
+	int getRegionGrid() const { return regionGrid_; }
+	float getMapSize() const { return mapSize_; }
+	const vector<unique_ptr<Player>>& getPlayers() const { return players_; }
+	int getMaxPlayers() const { return static_cast<int>(players_.size()); }
 	const vector<unique_ptr<DummyObject>>& getDummies() const { return dummies_; }
+	const CosmeticDummyField& getCosmeticDummies() const { return cosmetic_; }
+	size_t getTotalDummyCount() const { return dummies_.size() + cosmetic_.size(); }
+	int getPromotedCount() const { return promotedCount_; }
 };
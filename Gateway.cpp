@@ -0,0 +1,886 @@
+// 게이트웨이: 여러 GameServer 백엔드 앞에서 웹소켓 접속을 받아 가장 한가한 백엔드로 잇는다
+// 사용법: Gateway [--port=9000] [--control-port=9001] [--control-host=127.0.0.1]
+//                [--threads=1] [--backend-timeout-ms=2000] [--log-level=info]
+// 백엔드: GameServer --port=9002 --gateway=127.0.0.1:9001 (포트만 바꿔서 여러 개)
+//
+// 1. 클라이언트 핸드셰이크는 게이트웨이가 직접 받는다 (백엔드가 보낼 101과 같은 응답)
+// 2. 첫 프레임(JOIN_REQUEST)을 읽어 확인하고, 부하 보고 기준으로 백엔드를 고른다
+// 3. 원래 업그레이드 요청을 백엔드에 그대로 다시 보내고, 받아 둔 JOIN 프레임을 넘긴다
+// 4. 이후는 양방향 바이트 중계 (Linux는 splice()로 사용자 공간 복사 없이, 그 외는 버퍼 복사)
+//    웹소켓 프레임은 해석하지 않으므로 ping/pong, close도 백엔드와 클라이언트가 직접 주고받는다
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/websocket/rfc6455.hpp>
+#include <boost/beast/websocket/detail/hybi13.hpp>
+#include <algorithm>
+#include <array>
+#include <csignal>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "GatewayControl.h"
+#include "Logger.h"
+#include "ServerConfig.h"
+
+using namespace std;
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+using udp = net::ip::udp;
+using json = nlohmann::json;
+
+// 로그용 "주소:포트"
+template <typename Endpoint>
+static string endpointText(const Endpoint &endpoint)
+{
+	return endpoint.address().to_string() + ":" + to_string(endpoint.port());
+}
+
+struct GatewayConfig
+{
+	int port = 9000;
+	int controlPort = 9001;
+	string controlHost = "127.0.0.1"; // 다른 머신의 백엔드를 받으려면 0.0.0.0
+	int threads = 1;
+	int backendTimeoutMs = 2000;      // 이 시간 동안 보고가 없으면 백엔드 제외
+	string logLevel = "info";
+};
+
+static GatewayConfig parseGatewayConfig(int argc, char *argv[])
+{
+	GatewayConfig config;
+	for (int i = 1; i < argc; ++i)
+	{
+		const char *value = nullptr;
+		if (matchArg(argv[i], "--port", value))
+			config.port = atoi(value);
+		else if (matchArg(argv[i], "--control-port", value))
+			config.controlPort = atoi(value);
+		else if (matchArg(argv[i], "--control-host", value))
+			config.controlHost = value;
+		else if (matchArg(argv[i], "--threads", value))
+			config.threads = max(1, atoi(value));
+		else if (matchArg(argv[i], "--backend-timeout-ms", value))
+			config.backendTimeoutMs = atoi(value);
+		else if (matchArg(argv[i], "--log-level", value))
+			config.logLevel = value;
+		else
+			cerr << "Unknown option: " << argv[i] << endl;
+	}
+	return config;
+}
+
+// 전체 카운터 (상태 출력용)
+struct GatewayStats
+{
+	atomic<long long> accepted{ 0 };
+	atomic<long long> routed{ 0 };
+	atomic<long long> rejected{ 0 };   // 받을 백엔드 없음
+	atomic<long long> failed{ 0 };     // 핸드셰이크/JOIN 형식/백엔드 연결 실패
+	atomic<long long> active{ 0 };     // 중계 중인 연결
+	atomic<long long> bytesUp{ 0 };    // 클라이언트 -> 백엔드
+	atomic<long long> bytesDown{ 0 };  // 백엔드 -> 클라이언트
+};
+
+// 부하 보고로 유지하는 백엔드 목록
+class BackendTable
+{
+public:
+	struct Backend
+	{
+		tcp::endpoint endpoint;
+		BackendLoadReport load;
+		int pending = 0; // 마지막 보고 이후 보낸 JOIN (보고에 아직 안 잡힌 몫)
+		long long routed = 0;
+		chrono::steady_clock::time_point lastReport;
+	};
+
+	// 단계가 하나 오를 때마다 플레이어 비율에 더하는 벌점 (부하 경감 중인 백엔드는 뒤로)
+	static constexpr float LOAD_LEVEL_PENALTY = 0.25f;
+
+private:
+	mutex mutex_;
+	vector<Backend> backends_;
+	const chrono::milliseconds timeout_;
+
+public:
+	explicit BackendTable(chrono::milliseconds timeout)
+		: timeout_(timeout)
+	{
+	}
+
+	void update(const net::ip::address &address, const BackendLoadReport &load)
+	{
+		tcp::endpoint endpoint(address, static_cast<unsigned short>(load.port));
+		lock_guard<mutex> lock(mutex_);
+		auto it = find_if(backends_.begin(), backends_.end(),
+			[&](const Backend &backend) { return backend.endpoint == endpoint; });
+		if (it == backends_.end())
+		{
+			LOG_INFO << "Backend registered: " << endpointText(endpoint) << " (" << load.players << "/" << load.maxPlayers << ")";
+			backends_.push_back(Backend());
+			it = backends_.end() - 1;
+			it->endpoint = endpoint;
+		}
+		it->load = load;
+		it->pending = 0;
+		it->lastReport = chrono::steady_clock::now();
+	}
+
+	// 자리가 있는 백엔드 중 (플레이어 + 대기) / 최대 + 부하 단계 벌점이 가장 작은 곳, 없으면 false
+	bool pick(tcp::endpoint &out)
+	{
+		auto now = chrono::steady_clock::now();
+		lock_guard<mutex> lock(mutex_);
+		Backend *best = nullptr;
+		float bestScore = 0.0f;
+		for (Backend &backend : backends_)
+		{
+			if (now - backend.lastReport > timeout_ || backend.load.maxPlayers <= 0)
+				continue;
+			int expected = backend.load.players + backend.pending;
+			if (expected >= backend.load.maxPlayers)
+				continue;
+			float score = static_cast<float>(expected) / backend.load.maxPlayers
+				+ backend.load.loadLevel * LOAD_LEVEL_PENALTY;
+			if (best == nullptr || score < bestScore)
+			{
+				best = &backend;
+				bestScore = score;
+			}
+		}
+		if (best == nullptr)
+			return false;
+
+		best->pending++;
+		best->routed++;
+		out = best->endpoint;
+		return true;
+	}
+
+	// 연결 실패한 배정은 되돌린다
+	void unpick(const tcp::endpoint &endpoint)
+	{
+		lock_guard<mutex> lock(mutex_);
+		for (Backend &backend : backends_)
+		{
+			if (backend.endpoint == endpoint && backend.pending > 0)
+				backend.pending--;
+		}
+	}
+
+	void print(ostream &out)
+	{
+		auto now = chrono::steady_clock::now();
+		lock_guard<mutex> lock(mutex_);
+		for (const Backend &backend : backends_)
+		{
+			bool alive = now - backend.lastReport <= timeout_;
+			out << "  " << backend.endpoint
+				<< (alive ? "" : " (stale)")
+				<< "  players " << backend.load.players << "/" << backend.load.maxPlayers
+				<< "  sessions " << backend.load.sessions
+				<< "  load " << backend.load.loadLevel
+				<< "  tick " << fixed << setprecision(2) << backend.load.tickMs << " ms"
+				<< "  routed " << backend.routed << endl;
+		}
+	}
+};
+
+// 백엔드 부하 보고 수신
+class ControlReceiver
+{
+private:
+	udp::socket socket_;
+	udp::endpoint sender_;
+	array<char, 2048> buffer_;
+	BackendTable &table_;
+
+public:
+	ControlReceiver(net::io_context &ioc, const udp::endpoint &endpoint, BackendTable &table)
+		: socket_(ioc, endpoint), table_(table)
+	{
+	}
+
+	void start()
+	{
+		doReceive();
+	}
+
+private:
+	void doReceive()
+	{
+		socket_.async_receive_from(net::buffer(buffer_), sender_,
+			[this](boost::system::error_code ec, size_t bytes)
+			{
+				if (ec == net::error::operation_aborted)
+					return;
+				if (!ec)
+				{
+					BackendLoadReport load;
+					if (BackendLoadReport::parse(buffer_.data(), bytes, load))
+						table_.update(sender_.address(), load);
+					else
+						LOG_EVERY_MS(LogLevel::WARN, 5000) << "Malformed load report from " << endpointText(sender_);
+				}
+				doReceive();
+			});
+	}
+};
+
+// 클라이언트 첫 프레임 (클라이언트 -> 서버 프레임은 항상 마스크됨, RFC 6455 5.2)
+enum class FrameParse
+{
+	INCOMPLETE,
+	OK,
+	INVALID,
+};
+
+// 완성된 텍스트 프레임 하나면 frameSize와 마스크를 푼 payload를 채운다
+static FrameParse parseClientTextFrame(const uint8_t *data, size_t size, size_t maxPayload, size_t &frameSize, string &payload)
+{
+	if (size < 2)
+		return FrameParse::INCOMPLETE;
+
+	bool fin = (data[0] & 0x80) != 0;
+	int opcode = data[0] & 0x0F;
+	bool masked = (data[1] & 0x80) != 0;
+	uint64_t length = data[1] & 0x7F;
+	// JOIN은 작은 텍스트 메시지 하나 (조각 나뉜 프레임/확장 비트는 받지 않음)
+	if (!fin || opcode != 1 || !masked || (data[0] & 0x70) != 0)
+		return FrameParse::INVALID;
+
+	size_t header = 2;
+	if (length == 126)
+	{
+		if (size < 4)
+			return FrameParse::INCOMPLETE;
+		length = (uint64_t(data[2]) << 8) | data[3];
+		header = 4;
+	}
+	else if (length == 127)
+	{
+		return FrameParse::INVALID; // 64KB 이상
+	}
+	if (length > maxPayload)
+		return FrameParse::INVALID;
+
+	if (size < header + 4 + length)
+		return FrameParse::INCOMPLETE;
+
+	const uint8_t *mask = data + header;
+	const uint8_t *body = mask + 4;
+	payload.resize(static_cast<size_t>(length));
+	for (size_t i = 0; i < length; ++i)
+		payload[i] = static_cast<char>(body[i] ^ mask[i % 4]);
+	frameSize = header + 4 + static_cast<size_t>(length);
+	return FrameParse::OK;
+}
+
+// 서버 -> 클라이언트 텍스트 프레임 (마스크 없음)
+static string makeServerTextFrame(const string &payload)
+{
+	string frame;
+	frame += static_cast<char>(0x81);
+	if (payload.size() < 126)
+	{
+		frame += static_cast<char>(payload.size());
+	}
+	else
+	{
+		frame += static_cast<char>(126);
+		frame += static_cast<char>((payload.size() >> 8) & 0xFF);
+		frame += static_cast<char>(payload.size() & 0xFF);
+	}
+	frame += payload;
+	return frame;
+}
+
+// 한 방향 중계 (in -> out), 끝나면 done(ok) 호출
+// Linux: 소켓 -> 파이프 -> 소켓 splice(), 데이터가 커널 밖으로 나오지 않는다
+// 그 외: async_read_some/async_write 버퍼 복사
+class Relay : public enable_shared_from_this<Relay>
+{
+public:
+	using Done = function<void(bool)>;
+
+private:
+	tcp::socket &in_;
+	tcp::socket &out_;
+	atomic<long long> &counter_;
+	Done done_;
+#ifdef __linux__
+	int pipe_[2] = { -1, -1 };
+	size_t pipeBytes_ = 0; // 파이프에 들어 있고 아직 out으로 못 보낸 바이트
+	static const size_t CHUNK = 64 * 1024;
+#else
+	array<char, 16 * 1024> buffer_;
+#endif
+
+public:
+	Relay(tcp::socket &in, tcp::socket &out, atomic<long long> &counter, Done done)
+		: in_(in), out_(out), counter_(counter), done_(move(done))
+	{
+	}
+	~Relay()
+	{
+#ifdef __linux__
+		if (pipe_[0] >= 0)
+			::close(pipe_[0]);
+		if (pipe_[1] >= 0)
+			::close(pipe_[1]);
+#endif
+	}
+
+	void start()
+	{
+#ifdef __linux__
+		if (::pipe2(pipe_, O_NONBLOCK | O_CLOEXEC) != 0)
+		{
+			LOG_ERROR << "pipe2 failed: " << strerror(errno);
+			finish(false);
+			return;
+		}
+		// splice는 논블로킹 fd에서 EAGAIN을 돌려주고, 준비되면 async_wait로 다시 시도
+		boost::system::error_code ec;
+		in_.non_blocking(true, ec);
+		out_.non_blocking(true, ec);
+		pump();
+#else
+		doRead();
+#endif
+	}
+
+private:
+	void finish(bool ok)
+	{
+		Done done = move(done_);
+		if (done)
+			done(ok);
+	}
+
+#ifdef __linux__
+	void pump()
+	{
+		while (true)
+		{
+			// 파이프에 남은 것부터 내보낸다
+			while (pipeBytes_ > 0)
+			{
+				ssize_t sent = ::splice(pipe_[0], nullptr, out_.native_handle(), nullptr, pipeBytes_,
+					SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+				if (sent > 0)
+				{
+					pipeBytes_ -= static_cast<size_t>(sent);
+					counter_.fetch_add(sent, memory_order_relaxed);
+					continue;
+				}
+				if (sent < 0 && errno == EINTR)
+					continue;
+				if (sent < 0 && errno == EAGAIN)
+				{
+					out_.async_wait(tcp::socket::wait_write,
+						[self = shared_from_this()](boost::system::error_code ec)
+						{
+							if (ec)
+								self->finish(false);
+							else
+								self->pump();
+						});
+					return;
+				}
+				finish(false);
+				return;
+			}
+
+			ssize_t received = ::splice(in_.native_handle(), nullptr, pipe_[1], nullptr, CHUNK,
+				SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+			if (received > 0)
+			{
+				pipeBytes_ = static_cast<size_t>(received);
+				continue;
+			}
+			if (received == 0)
+			{
+				finish(true); // 상대가 보내기를 닫음
+				return;
+			}
+			if (errno == EINTR)
+				continue;
+			if (errno == EAGAIN)
+			{
+				in_.async_wait(tcp::socket::wait_read,
+					[self = shared_from_this()](boost::system::error_code ec)
+					{
+						if (ec)
+							self->finish(false);
+						else
+							self->pump();
+					});
+				return;
+			}
+			finish(false);
+			return;
+		}
+	}
+#else
+	void doRead()
+	{
+		in_.async_read_some(net::buffer(buffer_),
+			[self = shared_from_this()](boost::system::error_code ec, size_t bytes)
+			{
+				if (ec)
+				{
+					self->finish(ec == net::error::eof);
+					return;
+				}
+				net::async_write(self->out_, net::buffer(self->buffer_.data(), bytes),
+					[self](boost::system::error_code ec, size_t bytes)
+					{
+						if (ec)
+						{
+							self->finish(false);
+							return;
+						}
+						self->counter_.fetch_add(static_cast<long long>(bytes), memory_order_relaxed);
+						self->doRead();
+					});
+			});
+	}
+#endif
+};
+
+// 접속 하나: 핸드셰이크 -> JOIN 확인 -> 백엔드 선택/연결 -> 중계
+// 모든 핸들러는 세션 strand에서 실행 (두 방향 중계가 같은 소켓을 닫을 수 있으므로)
+class GatewaySession : public enable_shared_from_this<GatewaySession>
+{
+private:
+	static const size_t MAX_JOIN_BYTES = 16 * 1024;
+	const chrono::seconds HANDSHAKE_TIMEOUT{ 10 };
+
+	tcp::socket client_;
+	tcp::socket backend_;
+	net::steady_timer timer_;
+	BackendTable &table_;
+	GatewayStats &stats_;
+
+	beast::flat_buffer clientBuffer_;  // 업그레이드 요청 + 첫 프레임 (+ 그 뒤에 바로 온 바이트)
+	beast::flat_buffer backendBuffer_; // 백엔드 101 응답 뒤에 붙어 온 바이트
+	http::request<http::string_body> request_;
+	http::response<http::string_body> backendResponse_;
+	string handshakeResponse_;
+	string rejectFrame_;
+	tcp::endpoint backendEndpoint_;
+	string nickname_;
+
+	int openRelays_ = 0;
+	bool relaying_ = false;
+
+public:
+	GatewaySession(tcp::socket socket, BackendTable &table, GatewayStats &stats)
+		: client_(move(socket))
+		, backend_(client_.get_executor())
+		, timer_(client_.get_executor())
+		, table_(table)
+		, stats_(stats)
+	{
+	}
+	~GatewaySession()
+	{
+		if (relaying_)
+			stats_.active.fetch_sub(1, memory_order_relaxed);
+	}
+
+	void start()
+	{
+		boost::system::error_code ec;
+		client_.set_option(tcp::no_delay(true), ec);
+
+		// 핸드셰이크 + JOIN까지 시간 제한 (중계가 시작되면 해제)
+		timer_.expires_after(HANDSHAKE_TIMEOUT);
+		timer_.async_wait([self = shared_from_this()](boost::system::error_code ec)
+			{
+				if (!ec && !self->relaying_)
+				{
+					LOG_EVERY_MS(LogLevel::WARN, 1000) << "Gateway handshake timed out";
+					self->fail();
+				}
+			});
+
+		http::async_read(client_, clientBuffer_, request_,
+			[self = shared_from_this()](beast::error_code ec, size_t)
+			{
+				if (ec)
+				{
+					self->fail();
+					return;
+				}
+				self->acceptUpgrade();
+			});
+	}
+
+private:
+	void fail()
+	{
+		stats_.failed.fetch_add(1, memory_order_relaxed);
+		closeAll();
+	}
+
+	void closeAll()
+	{
+		boost::system::error_code ec;
+		timer_.cancel();
+		client_.close(ec);
+		backend_.close(ec);
+	}
+
+	// 백엔드(beast websocket accept)가 보낼 것과 같은 101 응답을 게이트웨이가 먼저 보낸다
+	// 확장(permessage-deflate)은 협상하지 않는다 (백엔드도 켜지 않으므로 이후 프레임이 그대로 통한다)
+	void acceptUpgrade()
+	{
+		auto key = request_[http::field::sec_websocket_key];
+		if (!beast::websocket::is_upgrade(request_) || key.empty()
+			|| key.size() > beast::websocket::detail::sec_ws_key_type::max_size_n)
+		{
+			fail();
+			return;
+		}
+
+		beast::websocket::detail::sec_ws_accept_type accept;
+		beast::websocket::detail::make_sec_ws_accept(accept, key);
+		handshakeResponse_ = "HTTP/1.1 101 Switching Protocols\r\n"
+			"Upgrade: websocket\r\n"
+			"Connection: upgrade\r\n"
+			"Sec-WebSocket-Accept: " + string(accept.data(), accept.size()) + "\r\n\r\n";
+
+		net::async_write(client_, net::buffer(handshakeResponse_),
+			[self = shared_from_this()](boost::system::error_code ec, size_t)
+			{
+				if (ec)
+				{
+					self->fail();
+					return;
+				}
+				self->readJoin();
+			});
+	}
+
+	void readJoin()
+	{
+		auto data = clientBuffer_.data();
+		size_t frameSize = 0;
+		string payload;
+		FrameParse result = parseClientTextFrame(static_cast<const uint8_t *>(data.data()), data.size(),
+			MAX_JOIN_BYTES, frameSize, payload);
+
+		if (result == FrameParse::INCOMPLETE)
+		{
+			client_.async_read_some(clientBuffer_.prepare(4096),
+				[self = shared_from_this()](boost::system::error_code ec, size_t bytes)
+				{
+					if (ec)
+					{
+						self->fail();
+						return;
+					}
+					self->clientBuffer_.commit(bytes);
+					self->readJoin();
+				});
+			return;
+		}
+
+		json join = result == FrameParse::OK ? json::parse(payload, nullptr, false) : json();
+		if (result == FrameParse::INVALID || !join.is_object() || join.value("type", -1) != 1)
+		{
+			LOG_EVERY_MS(LogLevel::WARN, 1000) << "Gateway expected JOIN_REQUEST as first message";
+			fail();
+			return;
+		}
+		if (join.contains("nickname") && join["nickname"].is_string())
+			nickname_ = join["nickname"];
+
+		if (!table_.pick(backendEndpoint_))
+		{
+			stats_.rejected.fetch_add(1, memory_order_relaxed);
+			LOG_EVERY_MS(LogLevel::WARN, 1000) << "No backend with free slots, rejecting " << nickname_;
+			reject("All servers are full");
+			return;
+		}
+		connectBackend();
+	}
+
+	// 백엔드의 만원 응답과 같은 형식의 JOIN_RESPONSE를 보내고 닫는다
+	void reject(const string &message)
+	{
+		json response;
+		response["type"] = 2; // JOIN_RESPONSE
+		response["success"] = false;
+		response["message"] = message;
+		rejectFrame_ = makeServerTextFrame(response.dump());
+		rejectFrame_ += string("\x88\x02\x03\xF5", 4); // close 1013 (try again later)
+
+		net::async_write(client_, net::buffer(rejectFrame_),
+			[self = shared_from_this()](boost::system::error_code, size_t)
+			{
+				boost::system::error_code ignored;
+				self->client_.shutdown(tcp::socket::shutdown_send, ignored);
+				self->timer_.cancel();
+			});
+	}
+
+	void connectBackend()
+	{
+		backend_.async_connect(backendEndpoint_,
+			[self = shared_from_this()](boost::system::error_code ec)
+			{
+				if (ec)
+				{
+					LOG_WARN << "Backend " << endpointText(self->backendEndpoint_) << " unreachable: " << ec.message();
+					self->table_.unpick(self->backendEndpoint_);
+					self->reject("Server unavailable");
+					self->stats_.failed.fetch_add(1, memory_order_relaxed);
+					return;
+				}
+				boost::system::error_code ignored;
+				self->backend_.set_option(tcp::no_delay(true), ignored);
+				self->replayUpgrade();
+			});
+	}
+
+	// 클라이언트의 업그레이드 요청을 백엔드에 다시 보낸다 (같은 키 -> 백엔드 101은 이미 보낸 것과 같다)
+	void replayUpgrade()
+	{
+		request_.erase(http::field::sec_websocket_extensions);
+		boost::system::error_code ec;
+		tcp::endpoint remote = client_.remote_endpoint(ec);
+		if (!ec)
+			request_.set("X-Forwarded-For", remote.address().to_string());
+
+		http::async_write(backend_, request_,
+			[self = shared_from_this()](beast::error_code ec, size_t)
+			{
+				if (ec)
+				{
+					self->fail();
+					return;
+				}
+				http::async_read(self->backend_, self->backendBuffer_, self->backendResponse_,
+					[self](beast::error_code ec, size_t)
+					{
+						if (ec || self->backendResponse_.result() != http::status::switching_protocols)
+						{
+							LOG_WARN << "Backend " << endpointText(self->backendEndpoint_) << " refused upgrade";
+							self->fail();
+							return;
+						}
+						self->forwardBuffered();
+					});
+			});
+	}
+
+	// 게이트웨이가 미리 읽은 바이트(JOIN 프레임 등)를 넘기고 나서 중계 시작
+	void forwardBuffered()
+	{
+		net::async_write(backend_, clientBuffer_.data(),
+			[self = shared_from_this()](boost::system::error_code ec, size_t bytes)
+			{
+				if (ec)
+				{
+					self->fail();
+					return;
+				}
+				self->stats_.bytesUp.fetch_add(static_cast<long long>(bytes), memory_order_relaxed);
+				self->clientBuffer_.consume(bytes);
+				net::async_write(self->client_, self->backendBuffer_.data(),
+					[self](boost::system::error_code ec, size_t bytes)
+					{
+						if (ec)
+						{
+							self->fail();
+							return;
+						}
+						self->stats_.bytesDown.fetch_add(static_cast<long long>(bytes), memory_order_relaxed);
+						self->backendBuffer_.consume(bytes);
+						self->startRelays();
+					});
+			});
+	}
+
+	void startRelays()
+	{
+		relaying_ = true;
+		timer_.cancel();
+		stats_.routed.fetch_add(1, memory_order_relaxed);
+		stats_.active.fetch_add(1, memory_order_relaxed);
+		LOG_INFO << "Routed " << (nickname_.empty() ? "client" : nickname_) << " -> " << endpointText(backendEndpoint_);
+
+		// 한 방향이 정상 종료(EOF)되면 반대쪽에 보내기 종료를 전하고, 오류면 둘 다 닫는다
+		// 세션은 두 중계가 모두 끝날 때까지 핸들러가 잡고 있다
+		openRelays_ = 2;
+		auto up = make_shared<Relay>(client_, backend_, stats_.bytesUp,
+			[self = shared_from_this()](bool ok) { self->onRelayDone(ok, self->backend_); });
+		auto down = make_shared<Relay>(backend_, client_, stats_.bytesDown,
+			[self = shared_from_this()](bool ok) { self->onRelayDone(ok, self->client_); });
+		up->start();
+		down->start();
+	}
+
+	void onRelayDone(bool ok, tcp::socket &out)
+	{
+		boost::system::error_code ec;
+		if (ok)
+			out.shutdown(tcp::socket::shutdown_send, ec);
+		else
+			closeAll();
+
+		if (--openRelays_ == 0)
+			closeAll();
+	}
+};
+
+class Gateway
+{
+private:
+	net::io_context &ioc_;
+	tcp::acceptor acceptor_;
+	BackendTable &table_;
+	GatewayStats &stats_;
+
+public:
+	Gateway(net::io_context &ioc, const tcp::endpoint &endpoint, BackendTable &table, GatewayStats &stats)
+		: ioc_(ioc), acceptor_(ioc, endpoint), table_(table), stats_(stats)
+	{
+	}
+
+	void start()
+	{
+		doAccept();
+	}
+
+	void stop()
+	{
+		boost::system::error_code ec;
+		acceptor_.close(ec);
+	}
+
+private:
+	void doAccept()
+	{
+		// 세션마다 strand (스레드가 여럿이어도 세션 핸들러는 순서대로)
+		acceptor_.async_accept(net::make_strand(ioc_),
+			[this](boost::system::error_code ec, tcp::socket socket)
+			{
+				if (ec == net::error::operation_aborted)
+					return;
+				if (!ec)
+				{
+					stats_.accepted.fetch_add(1, memory_order_relaxed);
+					make_shared<GatewaySession>(move(socket), table_, stats_)->start();
+				}
+				else
+				{
+					LOG_EVERY_MS(LogLevel::WARN, 1000) << "Gateway accept failed: " << ec.message();
+				}
+				doAccept();
+			});
+	}
+};
+
+int main(int argc, char *argv[])
+{
+	GatewayConfig config = parseGatewayConfig(argc, argv);
+
+	LogLevel logLevel;
+	if (!Logger::parseLevel(config.logLevel, logLevel))
+	{
+		cerr << "Unknown log level: " << config.logLevel << endl;
+		return 1;
+	}
+	Logger::instance().setLevel(logLevel);
+
+#ifndef _WIN32
+	// splice()는 MSG_NOSIGNAL이 없으므로 끊긴 소켓에 쓰면 SIGPIPE -> 무시하고 EPIPE로 받는다
+	signal(SIGPIPE, SIG_IGN);
+#endif
+
+	try
+	{
+		net::io_context ioc;
+		BackendTable table{ chrono::milliseconds(config.backendTimeoutMs) };
+		GatewayStats stats;
+
+		ControlReceiver control(ioc, udp::endpoint(net::ip::make_address(config.controlHost),
+			static_cast<unsigned short>(config.controlPort)), table);
+		Gateway gateway(ioc, tcp::endpoint(tcp::v4(), static_cast<unsigned short>(config.port)), table, stats);
+		control.start();
+		gateway.start();
+
+		LOG_INFO << "Gateway on port " << config.port << ", load reports on udp "
+			<< config.controlHost << ":" << config.controlPort;
+
+		net::signal_set signals(ioc, SIGINT, SIGTERM);
+		signals.async_wait([&ioc](boost::system::error_code, int) { ioc.stop(); });
+
+		// 상태 출력 (5초마다)
+		net::steady_timer statusTimer(ioc);
+		function<void()> printStatus = [&]()
+		{
+			statusTimer.expires_after(chrono::seconds(5));
+			statusTimer.async_wait([&](boost::system::error_code ec)
+				{
+					if (ec)
+						return;
+					cout << "=== Gateway Status ===" << endl;
+					cout << "Accepted: " << stats.accepted << "  Routed: " << stats.routed
+						<< "  Rejected: " << stats.rejected << "  Failed: " << stats.failed
+						<< "  Active: " << stats.active << endl;
+					cout << "Relayed: up " << fixed << setprecision(1) << (stats.bytesUp / 1048576.0)
+						<< " MB, down " << (stats.bytesDown / 1048576.0) << " MB"
+#ifdef __linux__
+						<< " (splice)"
+#endif
+						<< endl;
+					table.print(cout);
+					printStatus();
+				});
+		};
+		printStatus();
+
+		vector<thread> threads;
+		for (int i = 1; i < config.threads; ++i)
+			threads.emplace_back([&ioc] { ioc.run(); });
+		ioc.run();
+		for (auto &t : threads)
+			t.join();
+
+		LOG_INFO << "Gateway stopped";
+	}
+	catch (const exception &e)
+	{
+		LOG_ERROR << "Gateway error: " << e.what();
+		Logger::instance().stop();
+		return 1;
+	}
+	Logger::instance().stop();
+	return 0;
+}
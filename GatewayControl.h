@@ -0,0 +1,110 @@
+#pragma once
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "Logger.h"
+
+using namespace std;
+
+// 게이트웨이 제어 채널 (백엔드 GameServer -> Gateway, UDP 데이터그램 하나 = 부하 보고 하나)
+// 백엔드 주소는 데이터그램을 보낸 주소 + 보고에 든 포트 (다른 머신의 백엔드도 같은 방식)
+struct BackendLoadReport
+{
+	int port = 0;         // 클라이언트 웹소켓 포트
+	int players = 0;
+	int maxPlayers = 0;
+	int sessions = 0;     // JOIN 전 세션 포함
+	int loadLevel = 0;    // LoadShedder 단계
+	float tickMs = 0.0f;  // 평활 틱 비용
+
+	string toJson() const
+	{
+		nlohmann::json report;
+		report["port"] = port;
+		report["players"] = players;
+		report["maxPlayers"] = maxPlayers;
+		report["sessions"] = sessions;
+		report["loadLevel"] = loadLevel;
+		report["tickMs"] = tickMs;
+		return report.dump();
+	}
+
+	// 형식이 다르면 false (다른 버전의 백엔드/잡음)
+	static bool parse(const char *data, size_t size, BackendLoadReport &out)
+	{
+		nlohmann::json report = nlohmann::json::parse(data, data + size, nullptr, false);
+		if (report.is_discarded() || !report.is_object())
+			return false;
+		if (!report.contains("port") || !report["port"].is_number_integer()
+			|| !report.contains("players") || !report["players"].is_number_integer()
+			|| !report.contains("maxPlayers") || !report["maxPlayers"].is_number_integer())
+			return false;
+
+		out.port = report["port"];
+		out.players = report["players"];
+		out.maxPlayers = report["maxPlayers"];
+		out.sessions = report.value("sessions", 0);
+		out.loadLevel = report.value("loadLevel", 0);
+		out.tickMs = report.value("tickMs", 0.0f);
+		return out.port > 0 && out.port < 65536;
+	}
+};
+
+// 백엔드 쪽: 주기적으로 게이트웨이에 부하 보고
+class LoadReporter
+{
+public:
+	using Source = function<BackendLoadReport()>;
+	static constexpr chrono::milliseconds INTERVAL{ 500 };
+
+private:
+	boost::asio::ip::udp::socket socket_;
+	boost::asio::ip::udp::endpoint gateway_;
+	boost::asio::steady_timer timer_;
+	Source source_;
+	string datagram_;
+
+public:
+	// gateway: "host:port" (host는 IP 주소)
+	LoadReporter(boost::asio::io_context &ioc, const string &gateway, Source source)
+		: socket_(ioc), timer_(ioc), source_(move(source))
+	{
+		size_t colon = gateway.rfind(':');
+		if (colon == string::npos)
+			throw runtime_error("gateway address must be host:port: " + gateway);
+		gateway_ = boost::asio::ip::udp::endpoint(
+			boost::asio::ip::make_address(gateway.substr(0, colon)),
+			static_cast<unsigned short>(stoi(gateway.substr(colon + 1))));
+		socket_.open(gateway_.protocol());
+	}
+
+	const boost::asio::ip::udp::endpoint &gateway() const { return gateway_; }
+
+	void start()
+	{
+		report();
+	}
+
+private:
+	void report()
+	{
+		// 게이트웨이가 없거나 재시작 중이어도 보고는 계속 (보내기 실패는 무시)
+		datagram_ = source_().toJson();
+		boost::system::error_code ec;
+		socket_.send_to(boost::asio::buffer(datagram_), gateway_, 0, ec);
+		if (ec)
+			LOG_EVERY_MS(LogLevel::WARN, 10000) << "Gateway load report failed: " << ec.message();
+
+		timer_.expires_after(INTERVAL);
+		timer_.async_wait([this](boost::system::error_code ec)
+			{
+				if (!ec)
+					report();
+			});
+	}
+};
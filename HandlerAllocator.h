@@ -0,0 +1,146 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+// 세션별 완료 핸들러 메모리 재활용
+// - Asio/Beast는 비동기 작업마다 핸들러와 작업 상태를 담을 메모리를 핸들러의 associated allocator로 잡는다
+// - 세션이 동시에 걸어 두는 작업은 몇 개뿐(읽기, 쓰기, post)이므로 고정 블록 몇 개를 돌려 쓴다
+// - 블록보다 크거나 블록이 모두 사용 중이면 일반 힙으로 넘긴다 (fallbacks로 확인)
+// - io_context 종료 시 남은 작업이 세션보다 늦게 해제될 수 있어서 shared_ptr로 잡아 둔다
+class HandlerMemory
+{
+public:
+	static const size_t BLOCK_SIZE = 1024;
+	static const size_t BLOCK_COUNT = 4;
+
+private:
+	struct alignas(alignof(max_align_t)) Block
+	{
+		unsigned char data[BLOCK_SIZE];
+	};
+
+	Block blocks_[BLOCK_COUNT];
+	atomic<bool> inUse_[BLOCK_COUNT];
+
+public:
+	HandlerMemory()
+	{
+		for (auto &flag : inUse_)
+			flag.store(false, memory_order_relaxed);
+	}
+	HandlerMemory(const HandlerMemory &) = delete;
+	HandlerMemory &operator=(const HandlerMemory &) = delete;
+
+	// 블록을 못 쓰고 힙으로 간 횟수 (전체 세션 합계)
+	static atomic<long long> &fallbacks()
+	{
+		static atomic<long long> count{ 0 };
+		return count;
+	}
+
+	void *allocate(size_t size)
+	{
+		// 보통은 세션 샤드 스레드에서만 불리지만 send()의 post는 다른 스레드일 수 있어 플래그는 원자적으로
+		if (size <= BLOCK_SIZE)
+		{
+			for (size_t i = 0; i < BLOCK_COUNT; ++i)
+			{
+				if (!inUse_[i].load(memory_order_relaxed) && !inUse_[i].exchange(true, memory_order_acquire))
+					return blocks_[i].data;
+			}
+		}
+		fallbacks().fetch_add(1, memory_order_relaxed);
+		return ::operator new(size);
+	}
+
+	void deallocate(void *pointer)
+	{
+		for (size_t i = 0; i < BLOCK_COUNT; ++i)
+		{
+			if (pointer == blocks_[i].data)
+			{
+				inUse_[i].store(false, memory_order_release);
+				return;
+			}
+		}
+		::operator delete(pointer);
+	}
+};
+
+template <typename T>
+class HandlerAllocator
+{
+public:
+	using value_type = T;
+
+	explicit HandlerAllocator(shared_ptr<HandlerMemory> memory) noexcept
+		: memory_(move(memory))
+	{
+	}
+
+	template <typename U>
+	HandlerAllocator(const HandlerAllocator<U> &other) noexcept
+		: memory_(other.memory_)
+	{
+	}
+
+	T *allocate(size_t count)
+	{
+		return static_cast<T *>(memory_->allocate(sizeof(T) * count));
+	}
+
+	void deallocate(T *pointer, size_t)
+	{
+		memory_->deallocate(pointer);
+	}
+
+	template <typename U>
+	bool operator==(const HandlerAllocator<U> &other) const noexcept { return memory_ == other.memory_; }
+	template <typename U>
+	bool operator!=(const HandlerAllocator<U> &other) const noexcept { return memory_ != other.memory_; }
+
+private:
+	template <typename> friend class HandlerAllocator;
+	shared_ptr<HandlerMemory> memory_;
+};
+
+// 핸들러에 allocator_type/get_allocator()를 붙여 Asio가 HandlerMemory를 쓰게 한다
+// bind_executor로 한 번 더 감싸도 executor_binder가 associated allocator를 그대로 전달한다
+template <typename Handler>
+class AllocatingHandler
+{
+public:
+	using allocator_type = HandlerAllocator<Handler>;
+
+	AllocatingHandler(const shared_ptr<HandlerMemory> &memory, Handler handler)
+		: memory_(memory), handler_(move(handler))
+	{
+	}
+
+	allocator_type get_allocator() const noexcept
+	{
+		return allocator_type(memory_);
+	}
+
+	template <typename... Args>
+	void operator()(Args &&...args)
+	{
+		handler_(forward<Args>(args)...);
+	}
+
+private:
+	shared_ptr<HandlerMemory> memory_;
+	Handler handler_;
+};
+
+template <typename Handler>
+AllocatingHandler<typename decay<Handler>::type> makeAllocatingHandler(const shared_ptr<HandlerMemory> &memory, Handler &&handler)
+{
+	return AllocatingHandler<typename decay<Handler>::type>(memory, forward<Handler>(handler));
+}
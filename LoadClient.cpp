@@ -0,0 +1,889 @@
+// 부하 테스트 클라이언트
+// 사용법: LoadClient <host> <port> <mode> <clients> [seconds]
+//   storm  : 접속 -> JOIN_REQUEST -> 첫 GAME_STATE 수신 -> 종료 를 계속 반복 (재접속 폭주)
+//            결과: 초당 참가 수, 접속 시작 ~ 첫 GAME_STATE 지연 평균과 p50/p99/max
+//            (서버 정원을 넘는 동시 접속은 거절되므로 정원보다 많은 클라이언트는 거절/재시도 부하가 된다)
+//   fanout : 접속 -> SPECTATE_REQUEST 후 계속 수신만 하며 스냅샷 수신량/간격 측정
+//            플레이어 정원과 무관하게 N개 모두 브로드캐스트를 받는다 (JOIN은 정원(기본 50)까지만 받으므로 쓰지 않음)
+//            틱마다 받게 하려면 서버를 --spectator-rate=60 --max-spectators=N 이상으로 띄운다
+//   spectate : fanout과 같은 클라이언트 (Relay에 대고 실행할 때의 이름)
+//   udp    : JOIN 후 UDP_OFFER를 받아 UDP 채널로 스냅샷 수신 + 입력 송신
+//            (서버를 --udp-port=9003 --udp-loss=0.1 등으로 띄워 손실 상황 재현)
+//   stall  : JOIN_RESPONSE까지만 읽고 수신을 멈춤 (느린 소비자 축출 확인, 서버 --stats-port로 조회)
+//   burst  : 모두 접속해 둔 뒤 JOIN_REQUEST를 한꺼번에 보내고 첫 GAME_STATE까지 지연(p50/p99/max) 측정
+//            이후 1초마다 참가한 클라이언트 전부가 RESYNC_REQUEST를 동시에 보낸다 (서버 Keyframes 줄로 합쳐진 수 확인)
+//            서버 정원(50)을 넘는 클라이언트는 거절되며 거절 수로 따로 센다
+#include <iostream>
+#include <boost/beast/core.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <thread>
+#include <memory>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <mutex>
+#include "UdpTransport.h"
+
+using namespace std;
+
+namespace beast = boost::beast;
+namespace websocket = beast::websocket;
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+using udp = net::ip::udp;
+
+// 전체 클라이언트 공용 카운터
+struct LoadStats
+{
+	atomic<long long> joinsOk{ 0 };
+	atomic<long long> joinsRejected{ 0 };
+	atomic<long long> errors{ 0 };
+	atomic<long long> joinLatencyUs{ 0 }; // 접속 시작 ~ 첫 GAME_STATE
+
+	// burst 측정
+	atomic<long long> connected{ 0 };
+	atomic<long long> resyncs{ 0 };
+	mutex latencyMutex;
+	vector<long long> joinLatencies; // JOIN_REQUEST ~ 첫 GAME_STATE (us)
+
+	// fanout 측정
+	atomic<long long> messages{ 0 };
+	atomic<long long> bytes{ 0 };
+	atomic<long long> maxGapUs{ 0 }; // 구간 내 최대 수신 간격
+
+	// udp 측정
+	atomic<long long> udpBound{ 0 };
+	atomic<long long> snapshotsComplete{ 0 };
+	atomic<long long> snapshotsIncomplete{ 0 }; // 조각 일부 유실 후 새 스냅샷에 밀림
+	atomic<long long> snapshotsMissing{ 0 };    // 조각이 하나도 안 온 시퀀스
+
+	void recordJoinLatency(long long latencyUs)
+	{
+		joinsOk++;
+		joinLatencyUs += latencyUs;
+		lock_guard<mutex> lock(latencyMutex);
+		joinLatencies.push_back(latencyUs);
+	}
+
+	// 정렬된 지연에서 백분위 (없으면 0)
+	static long long percentile(const vector<long long> &sorted, double fraction)
+	{
+		if (sorted.empty())
+			return 0;
+		size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+		return sorted[std::min(index, sorted.size() - 1)];
+	}
+
+	void updateMaxGap(long long gapUs)
+	{
+		long long current = maxGapUs;
+		while (gapUs > current && !maxGapUs.compare_exchange_weak(current, gapUs))
+		{
+		}
+	}
+};
+
+// 메시지 타입만 빠르게 확인 (서버 json은 키가 정렬되어 "type"이 최상위 마지막 키)
+static int messageType(const string &message)
+{
+	size_t pos = message.rfind("\"type\":");
+	if (pos == string::npos)
+		return -1;
+	return atoi(message.c_str() + pos + 7);
+}
+
+// 재접속 폭주 클라이언트
+class StormClient : public enable_shared_from_this<StormClient>
+{
+private:
+	net::io_context &ioc_;
+	tcp::endpoint endpoint_;
+	string host_;
+	int index_;
+	LoadStats &stats_;
+	atomic<bool> &running_;
+
+	unique_ptr<websocket::stream<tcp::socket>> ws_;
+	beast::flat_buffer buffer_;
+	string joinMessage_;
+	bool joined_ = false;
+	chrono::steady_clock::time_point cycleStart_;
+
+public:
+	StormClient(net::io_context &ioc, tcp::endpoint endpoint, string host, int index, LoadStats &stats, atomic<bool> &running)
+		: ioc_(ioc), endpoint_(endpoint), host_(move(host)), index_(index), stats_(stats), running_(running)
+	{
+		joinMessage_ = "{\"type\":1,\"nickname\":\"storm" + to_string(index_) + "\"}";
+	}
+
+	void start()
+	{
+		if (!running_)
+			return;
+
+		cycleStart_ = chrono::steady_clock::now();
+		joined_ = false;
+		buffer_.consume(buffer_.size());
+		ws_ = make_unique<websocket::stream<tcp::socket>>(ioc_);
+
+		ws_->next_layer().async_connect(endpoint_,
+			[self = shared_from_this()](beast::error_code ec)
+			{
+				if (ec) return self->fail();
+				self->ws_->async_handshake(self->host_, "/",
+					[self](beast::error_code ec)
+					{
+						if (ec) return self->fail();
+						self->ws_->text(true);
+						self->ws_->async_write(net::buffer(self->joinMessage_),
+							[self](beast::error_code ec, size_t)
+							{
+								if (ec) return self->fail();
+								self->doRead();
+							});
+					});
+			});
+	}
+
+private:
+	void doRead()
+	{
+		ws_->async_read(buffer_,
+			[self = shared_from_this()](beast::error_code ec, size_t)
+			{
+				if (ec) return self->fail();
+
+				string message = beast::buffers_to_string(self->buffer_.data());
+				self->buffer_.consume(self->buffer_.size());
+
+				int type = messageType(message);
+				if (type == 2) // JOIN_RESPONSE
+				{
+					if (message.find("\"success\":true") == string::npos)
+					{
+						self->stats_.joinsRejected++;
+						return self->restart();
+					}
+					self->joined_ = true;
+				}
+				else if (type == 4 && self->joined_) // 첫 GAME_STATE
+				{
+					auto latency = chrono::duration_cast<chrono::microseconds>(
+						chrono::steady_clock::now() - self->cycleStart_).count();
+					self->stats_.recordJoinLatency(latency);
+					return self->restart();
+				}
+				self->doRead();
+			});
+	}
+
+	void restart()
+	{
+		ws_->async_close(websocket::close_code::normal,
+			[self = shared_from_this()](beast::error_code)
+			{
+				self->start();
+			});
+	}
+
+	void fail()
+	{
+		stats_.errors++;
+		// 서버가 밀려 있으면 잠깐 쉬고 재시도
+		auto timer = make_shared<net::steady_timer>(ioc_, chrono::milliseconds(50));
+		timer->async_wait([self = shared_from_this(), timer](beast::error_code)
+			{
+				self->start();
+			});
+	}
+};
+
+// 수신 전용 클라이언트 (브로드캐스트 팬아웃 측정)
+// SPECTATE_REQUEST로 관전하므로 플레이어 슬롯을 쓰지 않는다
+class FanoutClient : public enable_shared_from_this<FanoutClient>
+{
+private:
+	websocket::stream<tcp::socket> ws_;
+	tcp::endpoint endpoint_;
+	string host_;
+	LoadStats &stats_;
+	beast::flat_buffer buffer_;
+	string joinMessage_;
+	chrono::steady_clock::time_point lastMessage_;
+	bool hasLast_ = false;
+
+public:
+	FanoutClient(net::io_context &ioc, tcp::endpoint endpoint, string host, int index, LoadStats &stats)
+		: ws_(ioc), endpoint_(endpoint), host_(move(host)), stats_(stats)
+	{
+		joinMessage_ = "{\"type\":9,\"nickname\":\"spectator" + to_string(index) + "\"}";
+	}
+
+	void start()
+	{
+		ws_.next_layer().async_connect(endpoint_,
+			[self = shared_from_this()](beast::error_code ec)
+			{
+				if (ec) return self->fail();
+				self->ws_.async_handshake(self->host_, "/",
+					[self](beast::error_code ec)
+					{
+						if (ec) return self->fail();
+						self->ws_.text(true);
+						self->ws_.async_write(net::buffer(self->joinMessage_),
+							[self](beast::error_code ec, size_t)
+							{
+								if (ec) return self->fail();
+								self->doRead();
+							});
+					});
+			});
+	}
+
+private:
+	void doRead()
+	{
+		ws_.async_read(buffer_,
+			[self = shared_from_this()](beast::error_code ec, size_t bytes)
+			{
+				if (ec) return self->fail();
+
+				auto now = chrono::steady_clock::now();
+				if (self->hasLast_)
+				{
+					self->stats_.updateMaxGap(chrono::duration_cast<chrono::microseconds>(
+						now - self->lastMessage_).count());
+				}
+				self->lastMessage_ = now;
+				self->hasLast_ = true;
+
+				// JOIN_RESPONSE(관전이면 SPECTATE_RESPONSE) 결과만 확인하고 나머지는 개수/크기만 센다
+				if (bytes < 256)
+				{
+					string message = beast::buffers_to_string(self->buffer_.data());
+					if (messageType(message) == 10) // SPECTATE_RESPONSE
+					{
+						if (message.find("\"success\":true") != string::npos)
+							self->stats_.joinsOk++;
+						else
+							self->stats_.joinsRejected++;
+					}
+				}
+				self->buffer_.consume(self->buffer_.size());
+
+				self->stats_.messages++;
+				self->stats_.bytes += bytes;
+				self->doRead();
+			});
+	}
+
+	void fail()
+	{
+		stats_.errors++;
+	}
+};
+
+// 수신을 멈추는 클라이언트 (서버 쓰기 큐가 쌓이는 느린 소비자)
+// 서버가 축출하면 연결이 끊기지만 읽지 않으므로 여기서는 알 수 없다 -> 서버 통계로 확인
+class StallClient : public enable_shared_from_this<StallClient>
+{
+private:
+	websocket::stream<tcp::socket> ws_;
+	tcp::endpoint endpoint_;
+	string host_;
+	LoadStats &stats_;
+	beast::flat_buffer buffer_;
+	string joinMessage_;
+
+public:
+	StallClient(net::io_context &ioc, tcp::endpoint endpoint, string host, int index, LoadStats &stats)
+		: ws_(ioc), endpoint_(endpoint), host_(move(host)), stats_(stats)
+	{
+		joinMessage_ = "{\"type\":1,\"nickname\":\"stall" + to_string(index) + "\"}";
+	}
+
+	void start()
+	{
+		ws_.next_layer().async_connect(endpoint_,
+			[self = shared_from_this()](beast::error_code ec)
+			{
+				if (ec) return self->fail();
+
+				// 수신 버퍼를 줄여 서버 쪽 송신이 빨리 막히도록
+				beast::error_code ignored;
+				self->ws_.next_layer().set_option(net::socket_base::receive_buffer_size(4096), ignored);
+
+				self->ws_.async_handshake(self->host_, "/",
+					[self](beast::error_code ec)
+					{
+						if (ec) return self->fail();
+						self->ws_.text(true);
+						self->ws_.async_write(net::buffer(self->joinMessage_),
+							[self](beast::error_code ec, size_t)
+							{
+								if (ec) return self->fail();
+								self->readJoinResponse();
+							});
+					});
+			});
+	}
+
+private:
+	void readJoinResponse()
+	{
+		ws_.async_read(buffer_,
+			[self = shared_from_this()](beast::error_code ec, size_t)
+			{
+				if (ec) return self->fail();
+
+				string message = beast::buffers_to_string(self->buffer_.data());
+				self->buffer_.consume(self->buffer_.size());
+				if (messageType(message) != 2)
+					return self->readJoinResponse();
+
+				if (message.find("\"success\":true") != string::npos)
+					self->stats_.joinsOk++;
+				else
+					self->stats_.joinsRejected++;
+				// 여기서 읽기를 멈춘다 (걸린 작업이 없으면 객체가 사라져 연결이 닫히므로 자기 참조로 유지)
+				self->stalled_ = self;
+			});
+	}
+
+	void fail()
+	{
+		stats_.errors++;
+	}
+
+	shared_ptr<StallClient> stalled_;
+};
+
+// 동시 참가 클라이언트 (서버가 잠깐 멈췄다 돌아와 끊겼던 클라이언트가 한꺼번에 다시 들어오는 상황)
+// 접속/핸드셰이크까지만 해 두고 main이 모두 준비됐을 때 join()을 한꺼번에 부른다
+// 읽기가 걸린 채로 RESYNC_REQUEST를 쓰므로 핸들러는 strand에서
+class BurstClient : public enable_shared_from_this<BurstClient>
+{
+private:
+	websocket::stream<tcp::socket> ws_;
+	tcp::endpoint endpoint_;
+	string host_;
+	LoadStats &stats_;
+	beast::flat_buffer buffer_;
+	string joinMessage_;
+	string resyncMessage_ = "{\"type\":11}";
+	chrono::steady_clock::time_point joinSent_;
+	bool ready_ = false;
+	bool joined_ = false;   // JOIN_RESPONSE 성공
+	bool hasState_ = false; // 첫 GAME_STATE 받음
+	bool writing_ = false;
+
+public:
+	BurstClient(net::io_context &ioc, tcp::endpoint endpoint, string host, int index, LoadStats &stats)
+		: ws_(net::make_strand(ioc)), endpoint_(endpoint), host_(move(host)), stats_(stats)
+	{
+		joinMessage_ = "{\"type\":1,\"nickname\":\"burst" + to_string(index) + "\"}";
+	}
+
+	void start()
+	{
+		ws_.next_layer().async_connect(endpoint_,
+			[self = shared_from_this()](beast::error_code ec)
+			{
+				if (ec) return self->fail();
+				self->ws_.async_handshake(self->host_, "/",
+					[self](beast::error_code ec)
+					{
+						if (ec) return self->fail();
+						self->ws_.text(true);
+						self->ready_ = true;
+						self->stats_.connected++;
+						self->doRead();
+					});
+			});
+	}
+
+	// 모든 클라이언트에 같은 시각(burstStart)을 넘겨 대기열 지연까지 포함해 잰다
+	void join(chrono::steady_clock::time_point burstStart)
+	{
+		net::post(ws_.get_executor(), [self = shared_from_this(), burstStart]()
+			{
+				if (!self->ready_)
+					return;
+				self->joinSent_ = burstStart;
+				self->write(self->joinMessage_);
+			});
+	}
+
+	void resync()
+	{
+		net::post(ws_.get_executor(), [self = shared_from_this()]()
+			{
+				// 참가 전이거나 이전 쓰기가 아직이면 이번 차례는 건너뛴다
+				if (!self->hasState_ || self->writing_)
+					return;
+				self->stats_.resyncs++;
+				self->write(self->resyncMessage_);
+			});
+	}
+
+private:
+	void write(const string &message)
+	{
+		writing_ = true;
+		ws_.async_write(net::buffer(message),
+			[self = shared_from_this()](beast::error_code ec, size_t)
+			{
+				self->writing_ = false;
+				if (ec) return self->fail();
+			});
+	}
+
+	void doRead()
+	{
+		ws_.async_read(buffer_,
+			[self = shared_from_this()](beast::error_code ec, size_t bytes)
+			{
+				if (ec) return self->fail();
+
+				if (!self->hasState_)
+				{
+					string message = beast::buffers_to_string(self->buffer_.data());
+					int type = bytes < 256 ? messageType(message) : 4;
+					if (type == 2) // JOIN_RESPONSE
+					{
+						if (message.find("\"success\":true") == string::npos)
+						{
+							// 거절된 클라이언트는 더 받을 것이 없다 (읽기를 멈추면 연결이 닫힌다)
+							self->stats_.joinsRejected++;
+							return;
+						}
+						self->joined_ = true;
+					}
+					else if (type == 4 && self->joined_) // 첫 GAME_STATE (키프레임 또는 그 틱 브로드캐스트)
+					{
+						self->hasState_ = true;
+						self->stats_.recordJoinLatency(chrono::duration_cast<chrono::microseconds>(
+							chrono::steady_clock::now() - self->joinSent_).count());
+					}
+				}
+				self->buffer_.consume(self->buffer_.size());
+				self->stats_.messages++;
+				self->stats_.bytes += bytes;
+				self->doRead();
+			});
+	}
+
+	void fail()
+	{
+		stats_.errors++;
+	}
+};
+
+// 서버 json에서 숫자 필드 하나 추출 (LoadClient는 json 라이브러리 없이 동작)
+static unsigned long long numberField(const string &message, const char *key)
+{
+	string pattern = string("\"") + key + "\":";
+	size_t pos = message.find(pattern);
+	if (pos == string::npos)
+		return 0;
+	return strtoull(message.c_str() + pos + pattern.size(), nullptr, 10);
+}
+
+// UDP 채널 클라이언트
+class UdpClient : public enable_shared_from_this<UdpClient>
+{
+private:
+	net::io_context &ioc_;
+	websocket::stream<tcp::socket> ws_;
+	udp::socket udpSocket_;
+	tcp::endpoint endpoint_;
+	string host_;
+	LoadStats &stats_;
+	beast::flat_buffer buffer_;
+	string joinMessage_;
+
+	uint64_t token_ = 0;
+	udp::endpoint serverUdp_;
+	bool acked_ = false;
+	net::steady_timer helloTimer_;
+	net::steady_timer inputTimer_;
+	uint32_t inputSequence_ = 0;
+
+	array<char, 2048> recvBuffer_;
+	udp::endpoint sender_;
+
+	// 재조립 상태 (현재 시퀀스 하나만 유지)
+	bool hasSequence_ = false;
+	uint32_t sequence_ = 0;
+	vector<bool> received_;
+	int receivedCount_ = 0;
+	bool completed_ = false;
+
+public:
+	UdpClient(net::io_context &ioc, tcp::endpoint endpoint, string host, int index, LoadStats &stats)
+		: ioc_(ioc), ws_(ioc), udpSocket_(ioc), endpoint_(endpoint), host_(move(host)), stats_(stats)
+		, helloTimer_(ioc), inputTimer_(ioc)
+	{
+		joinMessage_ = "{\"type\":1,\"nickname\":\"udp" + to_string(index) + "\"}";
+	}
+
+	void start()
+	{
+		ws_.next_layer().async_connect(endpoint_,
+			[self = shared_from_this()](beast::error_code ec)
+			{
+				if (ec) return self->fail();
+				self->ws_.async_handshake(self->host_, "/",
+					[self](beast::error_code ec)
+					{
+						if (ec) return self->fail();
+						self->ws_.text(true);
+						self->ws_.async_write(net::buffer(self->joinMessage_),
+							[self](beast::error_code ec, size_t)
+							{
+								if (ec) return self->fail();
+								self->doReadWs();
+							});
+					});
+			});
+	}
+
+private:
+	void doReadWs()
+	{
+		ws_.async_read(buffer_,
+			[self = shared_from_this()](beast::error_code ec, size_t bytes)
+			{
+				if (ec) return self->fail();
+
+				if (bytes < 256)
+				{
+					string message = beast::buffers_to_string(self->buffer_.data());
+					int type = messageType(message);
+					if (type == 2)
+					{
+						if (message.find("\"success\":true") != string::npos)
+							self->stats_.joinsOk++;
+						else
+							self->stats_.joinsRejected++;
+					}
+					else if (type == 8 && self->token_ == 0) // UDP_OFFER
+					{
+						self->token_ = numberField(message, "token");
+						unsigned short port = static_cast<unsigned short>(numberField(message, "port"));
+						self->serverUdp_ = udp::endpoint(self->endpoint_.address(), port);
+						self->openUdp();
+					}
+				}
+				self->buffer_.consume(self->buffer_.size());
+				self->doReadWs();
+			});
+	}
+
+	void openUdp()
+	{
+		udpSocket_.open(udp::v4());
+		doReceiveUdp();
+		sendHello();
+		sendInputs();
+	}
+
+	// ACK 받을 때까지 HELLO 재전송 (HELLO 자체도 유실될 수 있음)
+	void sendHello()
+	{
+		if (acked_)
+			return;
+
+		UdpHelloPacket hello;
+		hello.type = UDP_HELLO;
+		hello.token = token_;
+		beast::error_code ec;
+		udpSocket_.send_to(net::buffer(&hello, sizeof(hello)), serverUdp_, 0, ec);
+
+		helloTimer_.expires_after(chrono::milliseconds(200));
+		helloTimer_.async_wait([self = shared_from_this()](beast::error_code ec)
+			{
+				if (!ec) self->sendHello();
+			});
+	}
+
+	// 30Hz 이동 입력
+	void sendInputs()
+	{
+		if (acked_)
+		{
+			UdpInputPacket input;
+			input.type = UDP_INPUT;
+			input.token = token_;
+			input.sequence = ++inputSequence_;
+			input.x = (inputSequence_ / 30) % 2 ? 1.0f : -1.0f;
+			input.y = 0.0f;
+			input.z = 0.0f;
+			beast::error_code ec;
+			udpSocket_.send_to(net::buffer(&input, sizeof(input)), serverUdp_, 0, ec);
+		}
+
+		inputTimer_.expires_after(chrono::milliseconds(33));
+		inputTimer_.async_wait([self = shared_from_this()](beast::error_code ec)
+			{
+				if (!ec) self->sendInputs();
+			});
+	}
+
+	void doReceiveUdp()
+	{
+		udpSocket_.async_receive_from(net::buffer(recvBuffer_), sender_,
+			[self = shared_from_this()](beast::error_code ec, size_t bytes)
+			{
+				if (ec) return self->fail();
+				self->handleUdp(bytes);
+				self->doReceiveUdp();
+			});
+	}
+
+	void handleUdp(size_t bytes)
+	{
+		uint8_t type = static_cast<uint8_t>(recvBuffer_[0]);
+		if (type == UDP_HELLO_ACK)
+		{
+			if (!acked_)
+			{
+				acked_ = true;
+				stats_.udpBound++;
+			}
+			return;
+		}
+		if (type != UDP_SNAPSHOT || bytes < sizeof(UdpSnapshotHeader))
+			return;
+
+		UdpSnapshotHeader header;
+		memcpy(&header, recvBuffer_.data(), sizeof(header));
+		stats_.messages++;
+		stats_.bytes += bytes;
+
+		// 오래된 시퀀스 조각은 버림 (latest-wins)
+		if (hasSequence_ && sequenceNewer(sequence_, header.sequence))
+			return;
+
+		if (!hasSequence_ || header.sequence != sequence_)
+		{
+			if (hasSequence_)
+			{
+				if (!completed_)
+					stats_.snapshotsIncomplete++;
+				stats_.snapshotsMissing += header.sequence - sequence_ - 1;
+			}
+			hasSequence_ = true;
+			sequence_ = header.sequence;
+			received_.assign(header.fragmentCount, false);
+			receivedCount_ = 0;
+			completed_ = false;
+		}
+
+		if (header.fragmentIndex < received_.size() && !received_[header.fragmentIndex])
+		{
+			received_[header.fragmentIndex] = true;
+			if (++receivedCount_ == static_cast<int>(received_.size()))
+			{
+				completed_ = true;
+				stats_.snapshotsComplete++;
+			}
+		}
+	}
+
+	void fail()
+	{
+		stats_.errors++;
+		helloTimer_.cancel();
+		inputTimer_.cancel();
+	}
+};
+
+int main(int argc, char *argv[])
+{
+	if (argc < 5)
+	{
+		cerr << "Usage: LoadClient <host> <port> <mode> <clients> [seconds]" << endl;
+		cerr << "  mode: storm | fanout | spectate | udp | stall | burst" << endl;
+		return 1;
+	}
+
+	string host = argv[1];
+	string port = argv[2];
+	string mode = argv[3];
+	int clientCount = atoi(argv[4]);
+	int seconds = argc > 5 ? atoi(argv[5]) : 10;
+
+	if (mode != "storm" && mode != "fanout" && mode != "spectate" && mode != "udp" && mode != "stall"
+		&& mode != "burst")
+	{
+		cerr << "Unknown mode: " << mode << endl;
+		return 1;
+	}
+
+	try
+	{
+		net::io_context ioc;
+		tcp::resolver resolver(ioc);
+		tcp::endpoint endpoint = *resolver.resolve(host, port).begin();
+
+		LoadStats stats;
+		atomic<bool> running(true);
+
+		vector<shared_ptr<BurstClient>> burstClients;
+		for (int i = 0; i < clientCount; ++i)
+		{
+			if (mode == "burst")
+			{
+				burstClients.push_back(make_shared<BurstClient>(ioc, endpoint, host, i, stats));
+				burstClients.back()->start();
+			}
+			else if (mode == "storm")
+				make_shared<StormClient>(ioc, endpoint, host, i, stats, running)->start();
+			else if (mode == "fanout" || mode == "spectate")
+				make_shared<FanoutClient>(ioc, endpoint, host, i, stats)->start();
+			else if (mode == "stall")
+				make_shared<StallClient>(ioc, endpoint, host, i, stats)->start();
+			else
+				make_shared<UdpClient>(ioc, endpoint, host, i, stats)->start();
+		}
+
+		auto const threadCount = std::max<int>(1, std::thread::hardware_concurrency());
+		vector<thread> threads;
+		for (int i = 0; i < threadCount; ++i)
+		{
+			threads.emplace_back([&ioc] { ioc.run(); });
+		}
+
+		cout << mode << ": " << clientCount << " clients -> " << host << ":" << port
+			<< " for " << seconds << "s" << endl;
+
+		if (mode == "burst")
+		{
+			// 모두 접속(또는 실패)할 때까지 최대 10초 기다렸다가 JOIN을 한꺼번에
+			auto waitStart = chrono::steady_clock::now();
+			while (stats.connected + stats.errors < clientCount
+				&& chrono::steady_clock::now() - waitStart < chrono::seconds(10))
+			{
+				this_thread::sleep_for(chrono::milliseconds(10));
+			}
+			cout << "connected: " << stats.connected << " / " << clientCount
+				<< "  errors: " << stats.errors << "  -> sending JOIN_REQUEST burst" << endl;
+			auto burstStart = chrono::steady_clock::now();
+			for (auto &client : burstClients)
+				client->join(burstStart);
+		}
+
+		long long lastOk = 0, lastRejected = 0, lastMessages = 0, lastBytes = 0;
+		for (int s = 0; s < seconds; ++s)
+		{
+			this_thread::sleep_for(chrono::seconds(1));
+			long long ok = stats.joinsOk, rejected = stats.joinsRejected;
+			if (mode == "storm")
+			{
+				cout << "joins/s: " << (ok - lastOk)
+					<< "  rejected/s: " << (rejected - lastRejected)
+					<< "  errors: " << stats.errors << endl;
+			}
+			else if (mode == "burst")
+			{
+				cout << "joined: " << ok << "  rejected: " << rejected
+					<< "  resyncs: " << stats.resyncs
+					<< "  msgs/s: " << (stats.messages - lastMessages)
+					<< "  errors: " << stats.errors << endl;
+				lastMessages = stats.messages;
+
+				// 참가한 클라이언트가 모두 같은 순간에 재동기화 요청
+				for (auto &client : burstClients)
+					client->resync();
+			}
+			else if (mode == "stall")
+			{
+				cout << "stalled: " << ok << "  rejected: " << rejected
+					<< "  errors: " << stats.errors << endl;
+			}
+			else if (mode == "udp")
+			{
+				cout << "bound: " << stats.udpBound
+					<< "  complete: " << stats.snapshotsComplete
+					<< "  incomplete: " << stats.snapshotsIncomplete
+					<< "  missing: " << stats.snapshotsMissing
+					<< "  errors: " << stats.errors << endl;
+			}
+			else
+			{
+				long long messages = stats.messages, bytes = stats.bytes;
+				cout << "msgs/s: " << (messages - lastMessages)
+					<< "  MB/s: " << fixed << setprecision(2) << ((bytes - lastBytes) / 1048576.0)
+					<< "  max gap: " << (stats.maxGapUs.exchange(0) / 1000.0) << " ms"
+					<< "  receivers: " << ok << "  rejected: " << rejected
+					<< "  errors: " << stats.errors << endl;
+				lastMessages = messages;
+				lastBytes = bytes;
+			}
+			lastOk = ok;
+			lastRejected = rejected;
+		}
+
+		running = false;
+		ioc.stop();
+		for (auto &t : threads)
+		{
+			t.join();
+		}
+
+		long long ok = stats.joinsOk;
+		cout << "=== Result ===" << endl;
+		if (mode == "fanout" || mode == "spectate")
+		{
+			cout << "Messages: " << stats.messages << " (" << fixed << setprecision(1)
+				<< (stats.messages / float(seconds)) << "/s)" << endl;
+			cout << "Bytes: " << fixed << setprecision(2) << (stats.bytes / 1048576.0) << " MB" << endl;
+		}
+		if (mode == "udp")
+		{
+			long long complete = stats.snapshotsComplete;
+			long long total = complete + stats.snapshotsIncomplete + stats.snapshotsMissing;
+			cout << "Snapshots delivered: " << complete << " / " << total;
+			if (total > 0)
+				cout << " (" << fixed << setprecision(1) << (complete * 100.0 / total) << "%)";
+			cout << endl;
+		}
+		cout << "Joins: " << ok << " (" << fixed << setprecision(1) << (ok / float(seconds)) << "/s)" << endl;
+		cout << "Rejected: " << stats.joinsRejected << endl;
+		cout << "Errors: " << stats.errors << endl;
+		if (ok > 0)
+		{
+			cout << "Avg join latency: " << fixed << setprecision(2)
+				<< (stats.joinLatencyUs / 1000.0 / ok) << " ms" << endl;
+		}
+		if (mode == "storm" || mode == "burst")
+		{
+			vector<long long> latencies;
+			{
+				lock_guard<mutex> lock(stats.latencyMutex);
+				latencies = stats.joinLatencies;
+			}
+			sort(latencies.begin(), latencies.end());
+			cout << "Join latency p50/p99/max: " << fixed << setprecision(2)
+				<< (LoadStats::percentile(latencies, 0.50) / 1000.0) << " / "
+				<< (LoadStats::percentile(latencies, 0.99) / 1000.0) << " / "
+				<< (latencies.empty() ? 0.0 : latencies.back() / 1000.0) << " ms" << endl;
+		}
+		if (mode == "burst")
+			cout << "Resync requests: " << stats.resyncs << endl;
+	}
+	catch (const exception &e)
+	{
+		cerr << "Fatal Error: " << e.what() << endl;
+		return 1;
+	}
+	return 0;
+}
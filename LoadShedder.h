@@ -0,0 +1,128 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+// 틱 비용이 예산을 넘을 때 단계적으로 일을 덜어내는 제어기
+// 게임 업데이트(플레이어 입력 반영)는 항상 매 틱 돌리고, 그 외의 일만 줄인다
+//   1단계: 스냅샷 송신을 2틱에 한 번으로
+//   2단계: + 플레이어에게서 먼 더미는 스냅샷에 몇 틱에 한 번만 싣기 (partial 스냅샷)
+//   3단계: + 새 SPAWN_DUMMIES 거부
+// 평활 비용이 예산의 HIGH_RATIO를 ESCALATE_TICKS 동안 넘으면 한 단계 올리고,
+// LOW_RATIO 아래로 RECOVER_TICKS 동안 있으면 한 단계 내린다 (단계 사이 진동 방지)
+enum class LoadLevel : int
+{
+	NORMAL = 0,
+	REDUCED_SNAPSHOT_RATE = 1,
+	THROTTLED_DISTANT_DUMMIES = 2,
+	SPAWN_CAPPED = 3,
+};
+
+class LoadShedder
+{
+public:
+	static constexpr float HIGH_RATIO = 0.9f;
+	static constexpr float LOW_RATIO = 0.6f;
+	static const int ESCALATE_TICKS = 30;  // 0.5초 (60Hz)
+	static const int RECOVER_TICKS = 180;  // 3초
+
+	static const int SNAPSHOT_DIVIDER = 2;       // 1단계 이상: 스냅샷 주기
+	static const int DISTANT_DUMMY_DIVIDER = 4;  // 2단계 이상: 먼 더미가 실리는 주기
+	static constexpr float DISTANT_RADIUS = 12.0f; // m, 가장 가까운 플레이어 기준
+
+private:
+	const float budgetMicros_;
+	int overTicks_ = 0;
+	int underTicks_ = 0;
+
+	// 게임 루프가 쓰고 I/O 스레드(SPAWN 제한, 통계 조회)가 읽는다
+	atomic<int> level_{ 0 };
+	atomic<float> smoothedCostMicros_{ 0.0f };
+	atomic<float> lastCostMicros_{ 0.0f };
+	atomic<long long> overruns_{ 0 };
+
+public:
+	explicit LoadShedder(float budgetMicros)
+		: budgetMicros_(budgetMicros)
+	{
+	}
+
+	// 틱 하나가 끝날 때마다 (게임 루프 스레드), 단계가 바뀌면 true
+	bool recordTick(float costMicros)
+	{
+		lastCostMicros_.store(costMicros, memory_order_relaxed);
+		if (costMicros > budgetMicros_)
+			overruns_.fetch_add(1, memory_order_relaxed);
+
+		// 순간 스파이크 하나로 단계가 오르지 않도록 1/8 가중 평균
+		float smoothed = smoothedCostMicros_.load(memory_order_relaxed);
+		smoothed += (costMicros - smoothed) / 8.0f;
+		smoothedCostMicros_.store(smoothed, memory_order_relaxed);
+
+		float ratio = smoothed / budgetMicros_;
+		int level = level_.load(memory_order_relaxed);
+
+		if (ratio > HIGH_RATIO && level < static_cast<int>(LoadLevel::SPAWN_CAPPED))
+		{
+			underTicks_ = 0;
+			if (++overTicks_ >= ESCALATE_TICKS)
+			{
+				overTicks_ = 0;
+				level_.store(level + 1, memory_order_relaxed);
+				return true;
+			}
+		}
+		else if (ratio < LOW_RATIO && level > 0)
+		{
+			overTicks_ = 0;
+			if (++underTicks_ >= RECOVER_TICKS)
+			{
+				underTicks_ = 0;
+				level_.store(level - 1, memory_order_relaxed);
+				return true;
+			}
+		}
+		else
+		{
+			overTicks_ = 0;
+			underTicks_ = 0;
+		}
+		return false;
+	}
+
+	LoadLevel level() const { return static_cast<LoadLevel>(level_.load(memory_order_relaxed)); }
+	bool atLeast(LoadLevel level) const { return level_.load(memory_order_relaxed) >= static_cast<int>(level); }
+
+	bool shouldSendSnapshot(uint32_t tick) const
+	{
+		return !atLeast(LoadLevel::REDUCED_SNAPSHOT_RATE) || tick % SNAPSHOT_DIVIDER == 0;
+	}
+	bool throttleDistantDummies() const { return atLeast(LoadLevel::THROTTLED_DISTANT_DUMMIES); }
+	bool spawnCapped() const { return atLeast(LoadLevel::SPAWN_CAPPED); }
+
+	// 먼 더미는 id로 나눠 보내는 스냅샷 DISTANT_DUMMY_DIVIDER개마다 한 번씩 돌아가며 싣는다
+	// 2단계는 항상 1단계(짝수 틱만 송신)와 함께이므로 틱이 아니라 송신 순번으로 센다
+	static bool distantDummyDue(int dummyId, uint32_t tick)
+	{
+		return static_cast<uint32_t>(dummyId) % DISTANT_DUMMY_DIVIDER == (tick / SNAPSHOT_DIVIDER) % DISTANT_DUMMY_DIVIDER;
+	}
+
+	float budgetMicros() const { return budgetMicros_; }
+	float smoothedCostMicros() const { return smoothedCostMicros_.load(memory_order_relaxed); }
+	float lastCostMicros() const { return lastCostMicros_.load(memory_order_relaxed); }
+	long long overruns() const { return overruns_.load(memory_order_relaxed); }
+
+	static const char *levelName(LoadLevel level)
+	{
+		switch (level)
+		{
+		case LoadLevel::NORMAL: return "normal";
+		case LoadLevel::REDUCED_SNAPSHOT_RATE: return "reduced snapshot rate";
+		case LoadLevel::THROTTLED_DISTANT_DUMMIES: return "throttled distant dummies";
+		case LoadLevel::SPAWN_CAPPED: return "spawns capped";
+		}
+		return "unknown";
+	}
+};
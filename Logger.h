@@ -0,0 +1,361 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+#ifdef ERROR
+#undef ERROR // wingdi.h
+#endif
+
+// 비동기 로거
+// - 스레드마다 고정 크기 링 버퍼(SPSC)에 기록하고, 백그라운드 스레드가 모아서 출력
+// - 호출 스레드는 포맷 + memcpy만 한다 (락, 시스템 콜, 할당 없음)
+// - 링이 가득 차면 버리고 개수만 센다 (게임 루프를 막지 않음)
+// - INFO 이하는 stdout, WARN 이상은 stderr (기존 cout/cerr 구분 유지)
+//
+// 사용법:
+//   LOG_INFO << "Player " << playerId << " jumped!";
+//   LOG_EVERY_MS(LogLevel::WARN, 1000) << "Received INPUT from non-joined client";  // 1초에 한 번, 생략 수 표시
+enum class LogLevel : uint8_t
+{
+	DEBUG = 0,
+	INFO = 1,
+	WARN = 2,
+	ERROR = 3,
+};
+
+class Logger
+{
+public:
+	static const size_t TEXT_CAPACITY = 244;
+	static const uint32_t RING_CAPACITY = 1024; // 스레드당 (2의 거듭제곱)
+
+private:
+	struct Record
+	{
+		int64_t timeNs;
+		uint16_t length;
+		LogLevel level;
+		char text[TEXT_CAPACITY];
+	};
+
+	struct Ring
+	{
+		array<Record, RING_CAPACITY> records;
+		alignas(64) atomic<uint32_t> head{ 0 }; // 생산자(기록 스레드)만 증가
+		alignas(64) atomic<uint32_t> tail{ 0 }; // 소비자(출력 스레드)만 증가
+		atomic<uint64_t> dropped{ 0 };
+		uint32_t threadIndex = 0;
+	};
+
+	struct Pending
+	{
+		int64_t timeNs;
+		uint32_t threadIndex;
+		LogLevel level;
+		string text;
+	};
+
+	atomic<int> minLevel_{ static_cast<int>(LogLevel::INFO) };
+
+	mutex ringsMutex_; // 스레드 등록과 출력 스레드의 목록 복사에만 사용
+	vector<shared_ptr<Ring>> rings_;
+
+	thread flusher_;
+	atomic<bool> running_{ false };
+	mutex flushMutex_; // 출력 스레드와 종료 시 drain이 겹치지 않도록
+
+	vector<Pending> pending_;
+	string outBuffer_;
+	string errBuffer_;
+
+	const chrono::milliseconds FLUSH_INTERVAL{ 5 };
+
+	Logger() = default;
+
+public:
+	Logger(const Logger &) = delete;
+	Logger &operator=(const Logger &) = delete;
+
+	~Logger()
+	{
+		stop();
+	}
+
+	static Logger &instance()
+	{
+		static Logger logger;
+		return logger;
+	}
+
+	static bool enabled(LogLevel level)
+	{
+		return static_cast<int>(level) >= instance().minLevel_.load(memory_order_relaxed);
+	}
+
+	void setLevel(LogLevel level) { minLevel_ = static_cast<int>(level); }
+
+	// "debug" / "info" / "warn" / "error"
+	static bool parseLevel(const string &name, LogLevel &level)
+	{
+		static const char *names[] = { "debug", "info", "warn", "error" };
+		for (int i = 0; i < 4; ++i)
+		{
+			if (name == names[i])
+			{
+				level = static_cast<LogLevel>(i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// 호출 스레드의 링에 기록 (가득 차면 버림)
+	void write(LogLevel level, const char *text, size_t length)
+	{
+		thread_local Ring *ring = registerThread();
+
+		uint32_t head = ring->head.load(memory_order_relaxed);
+		if (head - ring->tail.load(memory_order_acquire) >= RING_CAPACITY)
+		{
+			ring->dropped.fetch_add(1, memory_order_relaxed);
+			return;
+		}
+
+		Record &record = ring->records[head & (RING_CAPACITY - 1)];
+		record.timeNs = chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count();
+		record.level = level;
+		record.length = static_cast<uint16_t>(std::min(length, TEXT_CAPACITY));
+		memcpy(record.text, text, record.length);
+		ring->head.store(head + 1, memory_order_release);
+	}
+
+	// 남은 기록을 모두 출력하고 출력 스레드 종료 (이후 기록은 다시 start 전까지 쌓이기만 한다)
+	void stop()
+	{
+		if (running_.exchange(false) && flusher_.joinable())
+			flusher_.join();
+		drain();
+	}
+
+private:
+	Ring *registerThread()
+	{
+		auto ring = make_shared<Ring>();
+		lock_guard<mutex> lock(ringsMutex_);
+		ring->threadIndex = static_cast<uint32_t>(rings_.size());
+		rings_.push_back(ring);
+
+		// 첫 기록 때 출력 스레드 시작
+		if (!running_.exchange(true))
+		{
+			flusher_ = thread([this] {
+				while (running_)
+				{
+					this_thread::sleep_for(FLUSH_INTERVAL);
+					drain();
+				}
+			});
+		}
+		return ring.get();
+	}
+
+	// 모든 링에서 꺼내 시간순으로 정렬 후 한 번에 출력
+	void drain()
+	{
+		lock_guard<mutex> flushLock(flushMutex_);
+
+		vector<shared_ptr<Ring>> rings;
+		{
+			lock_guard<mutex> lock(ringsMutex_);
+			rings = rings_;
+		}
+
+		pending_.clear();
+		for (auto &ring : rings)
+		{
+			uint32_t tail = ring->tail.load(memory_order_relaxed);
+			uint32_t head = ring->head.load(memory_order_acquire);
+			for (; tail != head; ++tail)
+			{
+				const Record &record = ring->records[tail & (RING_CAPACITY - 1)];
+				pending_.push_back({ record.timeNs, ring->threadIndex, record.level, string(record.text, record.length) });
+			}
+			ring->tail.store(tail, memory_order_release);
+
+			uint64_t dropped = ring->dropped.exchange(0, memory_order_relaxed);
+			if (dropped > 0)
+			{
+				pending_.push_back({ chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count(),
+					ring->threadIndex, LogLevel::WARN, "logger ring full, dropped " + to_string(dropped) + " messages" });
+			}
+		}
+		if (pending_.empty())
+			return;
+
+		stable_sort(pending_.begin(), pending_.end(), [](const Pending &a, const Pending &b) { return a.timeNs < b.timeNs; });
+
+		outBuffer_.clear();
+		errBuffer_.clear();
+		for (const Pending &entry : pending_)
+		{
+			string &out = entry.level >= LogLevel::WARN ? errBuffer_ : outBuffer_;
+			appendPrefix(out, entry);
+			out += entry.text;
+			out += '\n';
+		}
+		if (!outBuffer_.empty())
+		{
+			fwrite(outBuffer_.data(), 1, outBuffer_.size(), stdout);
+			fflush(stdout);
+		}
+		if (!errBuffer_.empty())
+		{
+			fwrite(errBuffer_.data(), 1, errBuffer_.size(), stderr);
+			fflush(stderr);
+		}
+	}
+
+	// "HH:MM:SS.mmm I T3 "
+	static void appendPrefix(string &out, const Pending &entry)
+	{
+		time_t seconds = static_cast<time_t>(entry.timeNs / 1000000000);
+		int millis = static_cast<int>((entry.timeNs / 1000000) % 1000);
+		tm local;
+#ifdef _WIN32
+		localtime_s(&local, &seconds);
+#else
+		localtime_r(&seconds, &local);
+#endif
+		static const char levels[] = { 'D', 'I', 'W', 'E' };
+		char prefix[48];
+		int length = snprintf(prefix, sizeof(prefix), "%02d:%02d:%02d.%03d %c T%u ",
+			local.tm_hour, local.tm_min, local.tm_sec, millis, levels[static_cast<int>(entry.level)], entry.threadIndex);
+		out.append(prefix, static_cast<size_t>(length));
+	}
+};
+
+// 한 줄 조립기: 스택 버퍼에 포맷하고 소멸 시 로거 링으로 복사
+class LogLine
+{
+private:
+	LogLevel level_;
+	size_t length_ = 0;
+	long long repeated_;
+	char buffer_[Logger::TEXT_CAPACITY];
+
+	void append(const char *text, size_t length)
+	{
+		size_t room = sizeof(buffer_) - length_;
+		if (length > room)
+			length = room;
+		memcpy(buffer_ + length_, text, length);
+		length_ += length;
+	}
+
+public:
+	explicit LogLine(LogLevel level, long long repeated = 0)
+		: level_(level), repeated_(repeated)
+	{
+	}
+
+	~LogLine()
+	{
+		if (repeated_ > 0)
+			*this << " (+" << repeated_ << " suppressed)";
+		Logger::instance().write(level_, buffer_, length_);
+	}
+
+	LogLine &operator<<(const char *text)
+	{
+		append(text, strlen(text));
+		return *this;
+	}
+	LogLine &operator<<(const string &text)
+	{
+		append(text.data(), text.size());
+		return *this;
+	}
+	LogLine &operator<<(bool value)
+	{
+		return *this << (value ? "true" : "false");
+	}
+	LogLine &operator<<(char c)
+	{
+		append(&c, 1);
+		return *this;
+	}
+	LogLine &operator<<(double value)
+	{
+		char text[32];
+		int length = snprintf(text, sizeof(text), "%g", value);
+		append(text, static_cast<size_t>(length));
+		return *this;
+	}
+
+	template <typename T, typename = enable_if_t<is_integral<T>::value>>
+	LogLine &operator<<(T value)
+	{
+		char text[24];
+		auto result = to_chars(text, text + sizeof(text), value);
+		append(text, static_cast<size_t>(result.ptr - text));
+		return *this;
+	}
+};
+
+// 호출 위치별 반복 억제 (interval 동안 한 번만 통과, 나머지는 세어 두었다가 다음 통과 때 표시)
+class LogRateLimiter
+{
+private:
+	const int64_t intervalNs_;
+	atomic<int64_t> nextAllowedNs_{ 0 };
+	atomic<long long> suppressed_{ 0 };
+
+public:
+	explicit LogRateLimiter(int64_t intervalMs)
+		: intervalNs_(intervalMs * 1000000)
+	{
+	}
+
+	// 통과면 그동안 억제된 수(>= 0), 아니면 -1
+	long long acquire()
+	{
+		int64_t now = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+		int64_t next = nextAllowedNs_.load(memory_order_relaxed);
+		if (now >= next && nextAllowedNs_.compare_exchange_strong(next, now + intervalNs_, memory_order_relaxed))
+			return suppressed_.exchange(0, memory_order_relaxed);
+		suppressed_.fetch_add(1, memory_order_relaxed);
+		return -1;
+	}
+};
+
+// 비활성 레벨은 인자 평가도 하지 않는다
+#define LOG_AT(level) \
+	for (bool logOnce_ = Logger::enabled(level); logOnce_; logOnce_ = false) \
+		LogLine(level)
+
+#define LOG_DEBUG LOG_AT(LogLevel::DEBUG)
+#define LOG_INFO LOG_AT(LogLevel::INFO)
+#define LOG_WARN LOG_AT(LogLevel::WARN)
+#define LOG_ERROR LOG_AT(LogLevel::ERROR)
+
+#define LOG_EVERY_MS(level, intervalMs) \
+	for (long long logRepeated_ = Logger::enabled(level) \
+			? ([]() -> LogRateLimiter & { static LogRateLimiter limiter(intervalMs); return limiter; }()).acquire() \
+			: -1; \
+		logRepeated_ >= 0; logRepeated_ = -1) \
+		LogLine(level, logRepeated_)
@@ -1,9 +1,23 @@
 #pragma once
 #include <PxPhysicsAPI.h>
 #include "GameObject.h"
+#include "StateHistory.h"
+#include "TimerWheel.h"
+#include "SceneProfile.h"
+#include "SceneQueryBatch.h"
+#include "RoomSnapshot.h"
+#include "TaskPool.h"
+#include "Logger.h"
+#include <algorithm>
 #include <memory>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <string>
 
 using namespace physx;
 using namespace std;
@@ -14,12 +28,104 @@ class PhysXErrorCallback : public PxErrorCallback
 public:
 	virtual void reportError(PxErrorCode::Enum code, const char* message, const char* file, int line) override
 	{
-		cerr << "PhysX Error [" << file << ":" << line << "]: " << message << endl;
+		LOG_ERROR << "PhysX Error [" << file << ":" << line << "]: " << message;
+	}
+};
+
+// 액터 userData 태그 (종류 + 엔티티 id), 정적 액터는 nullptr
+enum class ActorKind : uint32_t
+{
+	STATIC = 0,
+	PLAYER = 1,
+	DUMMY = 2,
+	GHOST = 3, // 영역 격자 경계의 키네마틱 복제 (id는 주인 엔티티, 플레이어면 GHOST_PLAYER_BIT)
+};
+
+inline void* makeActorTag(ActorKind kind, int id)
+{
+	return reinterpret_cast<void*>((static_cast<uintptr_t>(kind) << 30) | (static_cast<uint32_t>(id) & 0x3FFFFFFF));
+}
+inline uint32_t actorTagValue(const PxActor* actor)
+{
+	return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(actor->userData));
+}
+inline ActorKind actorTagKind(uint32_t tag) { return static_cast<ActorKind>(tag >> 30); }
+inline int actorTagId(uint32_t tag) { return static_cast<int>(tag & 0x3FFFFFFF); }
+
+// 고스트 태그 <-> 주인 태그 (더미 id는 2^29보다 작다고 가정)
+const uint32_t GHOST_PLAYER_BIT = 1u << 29;
+inline void* makeGhostTag(uint32_t ownerTag)
+{
+	uint32_t id = static_cast<uint32_t>(actorTagId(ownerTag));
+	if (actorTagKind(ownerTag) == ActorKind::PLAYER)
+		id |= GHOST_PLAYER_BIT;
+	return makeActorTag(ActorKind::GHOST, static_cast<int>(id));
+}
+inline uint32_t ghostOwnerTag(uint32_t ghostTag)
+{
+	uint32_t id = static_cast<uint32_t>(actorTagId(ghostTag));
+	ActorKind kind = (id & GHOST_PLAYER_BIT) ? ActorKind::PLAYER : ActorKind::DUMMY;
+	return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(makeActorTag(kind, static_cast<int>(id & ~GHOST_PLAYER_BIT))));
+}
+
+// 기본 셰이더 + 접촉 시작/종료 통지 (더미 착지 판정용)
+inline PxFilterFlags contactReportFilterShader(
+	PxFilterObjectAttributes attributes0, PxFilterData filterData0,
+	PxFilterObjectAttributes attributes1, PxFilterData filterData1,
+	PxPairFlags& pairFlags, const void* constantBlock, PxU32 constantBlockSize)
+{
+	if (PxFilterObjectIsTrigger(attributes0) || PxFilterObjectIsTrigger(attributes1))
+	{
+		pairFlags = PxPairFlag::eTRIGGER_DEFAULT;
+		return PxFilterFlag::eDEFAULT;
+	}
+	pairFlags = PxPairFlag::eCONTACT_DEFAULT
+		| PxPairFlag::eNOTIFY_TOUCH_FOUND
+		| PxPairFlag::eNOTIFY_TOUCH_LOST;
+	return PxFilterFlag::eDEFAULT;
+}
+
+// 틱 하나의 PxSimulationStatistics 요약 (/stats, 상태 줄, PVD 캡처 CSV)
+// 아일랜드 수는 공개 API에 없어서 솔버 파티션 수(nbPartitions)로 대신한다
+struct PhysicsTickStats
+{
+	uint32_t tick = 0;
+	uint32_t activeDynamicBodies = 0;
+	uint32_t dynamicBodies = 0;
+	uint32_t staticBodies = 0;
+	uint32_t activeConstraints = 0;
+	uint32_t axisSolverConstraints = 0;
+	uint32_t partitions = 0;
+	uint32_t contactPairs = 0;             // 좁은 단계에 들어간 쌍 (broadphase 겹침)
+	uint32_t contactPairsWithContacts = 0; // 실제 접촉점이 생긴 쌍
+	uint32_t newPairs = 0;
+	uint32_t lostPairs = 0;
+	uint32_t newTouches = 0;
+	uint32_t lostTouches = 0;
+	float simulateMicros = 0.0f;           // simulate + fetchResults (영역 씬 전부)
+	uint32_t regions = 1;                  // 영역 씬 수
+	uint32_t ghostActors = 0;              // 이웃 영역 씬에 둔 고스트 수
+	uint32_t handoffs = 0;                 // 이번 틱에 소유 영역이 바뀐 엔티티
+
+	static const char* csvHeader()
+	{
+		return "tick,activeDynamicBodies,dynamicBodies,staticBodies,activeConstraints,axisSolverConstraints,partitions,"
+			"contactPairs,contactPairsWithContacts,newPairs,lostPairs,newTouches,lostTouches,simulateMicros,"
+			"regions,ghostActors,handoffs";
+	}
+
+	void writeCsv(ostream& out) const
+	{
+		out << tick << ',' << activeDynamicBodies << ',' << dynamicBodies << ',' << staticBodies << ','
+			<< activeConstraints << ',' << axisSolverConstraints << ',' << partitions << ','
+			<< contactPairs << ',' << contactPairsWithContacts << ',' << newPairs << ',' << lostPairs << ','
+			<< newTouches << ',' << lostTouches << ',' << simulateMicros << ','
+			<< regions << ',' << ghostActors << ',' << handoffs << '\n';
 	}
 };
 
 //PhysX ���� ���� ����
-class PhysicsWorld
+class PhysicsWorld : public PxSimulationEventCallback
 {
 private:
 	PxDefaultAllocator allocator_;
@@ -27,18 +133,128 @@ private:
 	PxFoundation* foundation_ = nullptr;
 	PxPhysics* physics_ = nullptr;
 	PxDefaultCpuDispatcher* dispatcher_ = nullptr;
-	PxScene* scene_ = nullptr;
 	PxMaterial* defaultMaterial_ = nullptr;
 
+	// 영역 격자: 맵을 regionGrid_ x regionGrid_ 칸으로 나눠 칸마다 PxScene 하나 (1이면 씬 하나, 고스트/이전 없음)
+	// - 엔티티 액터는 소유 영역 씬에만 있고, 경계 GHOST_MARGIN 안이면 이웃 씬에 키네마틱 고스트를 둔다
+	//   (고스트는 한 틱 늦게 주인 포즈를 따라가며, 이웃 씬 물체를 밀어낼 뿐 밀리지는 않는다)
+	//   경계를 사이에 두고 닿은 두 물체는 둘 다 GHOST_MARGIN 안이라 서로 상대 씬에 고스트가 있으므로
+	//   접촉 자체는 양방향이다. 다만 양쪽 모두 상대를 한 틱 늦은 무한 질량으로 보므로
+	//   경계 너머 충돌은 질량비/운동량이 보존되지 않는다 (둘 다 상대에게서 완전히 밀려남)
+	// - 칸을 HANDOFF_MARGIN 넘게 벗어나면 같은 액터를 새 씬으로 옮긴다 (포인터, 속도, 기록/되감기 목록 유지)
+	// - 씬을 모두 simulate로 띄운 뒤 fetchResults를 차례로 부르므로 스텝은 공유 디스패처에서 겹쳐 돌고,
+	//   접촉 콜백은 게임 루프 스레드에서 차례로 불린다 (받침/점프 장부에 잠금 불필요)
+	// - 되감기는 주인 액터만 옮긴다 (경계 너머 씬의 고스트는 현재 포즈로 남음)
+	struct RegionGhost
+	{
+		uint32_t region;
+		PxRigidDynamic* actor;
+	};
+	struct GhostSet
+	{
+		RegionGhost ghosts[4];
+		uint32_t count = 0;
+	};
+	struct RegionCandidate
+	{
+		PxRigidDynamic* actor;
+		uint32_t tag;
+		PxTransform pose;
+		uint32_t current;
+		uint32_t owner;
+		uint32_t wanted[4];
+		uint32_t wantedCount;
+		bool apply;
+	};
+	vector<PxScene*> scenes_;
+	int regionGrid_;
+	vector<uint32_t> dummyRegions_;               // dummyList_와 같은 인덱스, 소유 영역
+	unordered_map<int, uint32_t> playerRegions_;
+	unordered_map<uint32_t, GhostSet> ghosts_;    // 주인 태그 -> 이웃 씬 고스트
+	PxShape* ghostShape_ = nullptr;               // 고스트끼리 공유 (플레이어/더미 박스 크기가 같다)
+	vector<RegionCandidate> regionCandidates_;
+	vector<pair<PxRigidActor*, int>> activeDummies_; // 영역이 여럿일 때 이번 스텝에 움직인 더미 (씬을 바꾸기 전에 모은다)
+	uint32_t ghostCount_ = 0;
+	uint32_t handoffsThisTick_ = 0;
+	long long handoffsTotal_ = 0;
+	static const uint32_t ALL_REGIONS = UINT32_MAX;
+	static const size_t REGION_GRAIN = 2048;
+	const float GHOST_MARGIN = 2.0f;   // 박스 반폭 + 한 틱 최대 이동 + 여유 (칸 크기의 절반보다 작아야 한다)
+	const float HANDOFF_MARGIN = 0.5f; // 경계에서 소유가 오가지 않도록 (GHOST_MARGIN보다 작게)
+
+	// PVD: 항상 만들어 두고 캡처할 때만 파일 전송에 연결 (연결 시점에 씬 전체를 보낸다)
+	// release 빌드 PhysX는 PVD가 컴파일에서 빠져 있어 파일이 비어 나온다 (CMake PHYSX_BUILD_CONFIG=profile)
+	PxPvd* pvd_ = nullptr;
+	PxPvdTransport* pvdTransport_ = nullptr;
+	string pvdPath_;
+	uint32_t pvdStopTick_ = 0;
+	ofstream pvdStatsCsv_; // 캡처 창 동안 틱별 통계 (<path>.stats.csv)
+	PhysicsTickStats tickStats_;
+
+	SceneProfile profile_;
+	float mapSize_;
+
 	unordered_map<int, PxRigidDynamic*> playerActors_;
 	unordered_map<int, PxRigidDynamic*> dummyActors_;
 
-	unordered_map<int, float> dummyJumpTimers_;
+	// 더미 dense 목록 (상태 기록/되감기용, 삭제는 swap-remove)
+	vector<PxRigidDynamic*> dummyList_;
+	vector<int> dummyListIds_;
+	unordered_map<int, uint32_t> dummyListIndex_;
+	uint32_t dummySetVersion_ = 0; // 더미 추가/삭제 시 증가
+
+	// 랙 보정용 상태 기록
+	StateHistory history_;
+	uint32_t tick_ = 0;
+	float lastRecordMicros_ = 0.0f;
+	vector<pair<PxRigidDynamic*, PxTransform>> rewound_; // 되감기 전 원래 포즈
+
+	// 배치 씬 쿼리 (틱 끝에 실행, 결과는 다음 틱 시작 때 반영)
+	SceneQueryBatch queryBatch_;
+	unordered_set<int> groundedPlayers_; // 지난 틱 접지 스윕에서 발밑에 무언가 있던 플레이어
+
+	// 바이너리 직렬화 (방 스냅샷)
+	PxSerializationRegistry* serializationRegistry_ = nullptr;
+	// dummyList_와 같은 인덱스, 스냅샷에서 복원한 더미는 그 액터가 든 매핑 (아니면 nullptr)
+	// 매핑은 그 스냅샷의 마지막 더미가 해제될 때 풀린다 (반복 복원해도 쌓이지 않게)
+	vector<shared_ptr<MappedFile>> dummyBacking_;
+	static const PxSerialObjectId MATERIAL_SERIAL_ID = 1;
+	static PxSerialObjectId dummySerialId(int dummyId) { return (1ull << 32) | static_cast<uint32_t>(dummyId); }
+
+	// 더미 점프 스케줄 (접촉 통지 기반 착지 판정 + 타이머 휠)
+	struct DummyJumpState
+	{
+		int supportContacts = 0;  // 아래에서 받치고 있는 접촉 수 (바닥/다른 액터)
+		bool scheduled = false;
+		uint32_t jumpDueTick = 0;
+		float initialPhase = 0.0f; // 첫 착지 때만 적용되는 위상 (동시 점프 방지)
+		bool hasLanded = false;
+		int carriedContacts = 0;  // 영역 이전으로 끊겼지만 supportContacts에 남겨 둔 받침 (다음 스텝에 다시 잡히면 새 착지가 아니다)
+	};
+	unordered_map<int, DummyJumpState> dummyJumpStates_;
+	unordered_map<uint64_t, int> supportPairs_; // 접촉 쌍 키 -> 받쳐지는 더미 id
+	unordered_map<uint32_t, vector<uint64_t>> supportPairsByTag_; // 액터 태그 -> 그 태그가 든 쌍 키 (정적 액터 제외, 정리 비용을 그 액터 쌍 수로)
+	vector<uint64_t> supportPurgeScratch_;
+	vector<int> carriedDummies_; // carriedContacts가 남은 더미 (다음 fetchResults 뒤 정산)
+	TimerWheel<int> jumpWheel_;
+	float lastDeltaTime_ = 1.0f / 60.0f;
+	int jumpsThisTick_ = 0;
+
+	// 틱 안의 더미별 단계를 나눠 돌릴 풀 (GameWorld 소유, 없으면 단일 스레드)
+	// 청크 안에서는 PhysX 읽기만, 쓰기(힘 적용)는 결과를 모아 호출 스레드에서
+	TaskPool* taskPool_ = nullptr;
+	vector<int> dueDummies_;                 // 이번 틱 점프 만기 (타이머 휠 순서)
+	vector<PxRigidDynamic*> jumpCandidates_; // dueDummies_와 같은 인덱스, 점프할 액터 또는 nullptr
+	static const size_t DUE_GRAIN = 512;
+	static const size_t SYNC_GRAIN = 1024;
+	static const size_t RECORD_GRAIN = 2048;
 	const float JUMP_INTERVAL = 1.0f; // 1�ʸ��� ����
 	const float JUMP_FORCE = 50.0f; // ���� ����(���� ��)
 
 public:
-	PhysicsWorld()
+	// regionGrid: 영역 격자 한 변의 칸 수 (mapSize는 전체 맵), playerSlots: 플레이어 id 범위 [0, playerSlots) (기록/되감기)
+	PhysicsWorld(const SceneProfile& profile = defaultSceneProfile(), float mapSize = 25.0f, int regionGrid = 1, int playerSlots = 50)
+		: regionGrid_(std::max(1, regionGrid)), profile_(profile), mapSize_(mapSize), history_(playerSlots)
 	{
 		initPhysX();
 	}
@@ -49,52 +265,157 @@ public:
 
 	void initPhysX()
 	{
-		cout << "Initializing PhysX SDK..." << endl;
+		LOG_INFO << "Initializing PhysX SDK...";
 		
 		foundation_ = PxCreateFoundation(PX_PHYSICS_VERSION, allocator_, errorCallback_);
 		if (!foundation_)
 		{
-			cerr << "PxCreateFoundation failed!" << endl;
+			LOG_ERROR << "PxCreateFoundation failed!";
 			return;
 		}
-		cout << "PhysX Foundation created (Version: " << PX_PHYSICS_VERSION << ")" << endl;
+		LOG_INFO << "PhysX Foundation created (Version: " << PX_PHYSICS_VERSION << ")";
+
+		pvd_ = PxCreatePvd(*foundation_);
+		if (!pvd_)
+			LOG_WARN << "PxCreatePvd failed, PVD capture disabled";
 
 		PxTolerancesScale scale;
-		physics_ = PxCreatePhysics(PX_PHYSICS_VERSION, *foundation_, scale, true);
+		physics_ = PxCreatePhysics(PX_PHYSICS_VERSION, *foundation_, scale, true, pvd_);
 		if (!physics_)
 		{
-			cerr << "pxCreatePhysics failed!" << endl;
+			LOG_ERROR << "pxCreatePhysics failed!";
 			return;
 		}
-		cout << "PhysX Physics created" << endl;
+		LOG_INFO << "PhysX Physics created";
 
 		PxSceneDesc sceneDesc(physics_->getTolerancesScale());
 		sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
 
-		dispatcher_ = PxDefaultCpuDispatcherCreate(2);
+		// 영역 씬들은 디스패처 하나를 나눠 쓴다 (영역이 여럿이면 영역 수만큼, 코어 수까지 늘린다)
+		uint32_t regionCount = static_cast<uint32_t>(regionGrid_ * regionGrid_);
+		PxU32 dispatcherThreads = profile_.dispatcherThreads;
+		if (regionCount > 1)
+		{
+			PxU32 cores = std::max(1u, thread::hardware_concurrency());
+			dispatcherThreads = std::max(dispatcherThreads, std::min<PxU32>(regionCount, cores));
+		}
+		dispatcher_ = PxDefaultCpuDispatcherCreate(dispatcherThreads);
 		sceneDesc.cpuDispatcher = dispatcher_;
-		sceneDesc.filterShader = PxDefaultSimulationFilterShader;
+		sceneDesc.filterShader = contactReportFilterShader;
+		sceneDesc.simulationEventCallback = this;
+		sceneDesc.flags |= PxSceneFlag::eENABLE_ACTIVE_ACTORS; // 움직인 액터만 동기화
+		applySceneProfile(sceneDesc);
 
-		scene_ = physics_->createScene(sceneDesc);
-		if (!scene_)
+		for (uint32_t region = 0; region < regionCount; ++region)
 		{
-			cerr << "createScene failed!" << endl;
-			return;
+			PxScene* scene = physics_->createScene(sceneDesc);
+			if (!scene)
+			{
+				LOG_ERROR << "createScene failed!";
+				return;
+			}
+			scenes_.push_back(scene);
+
+			if (PxPvdSceneClient* pvdClient = scene->getScenePvdClient())
+			{
+				pvdClient->setScenePvdFlag(PxPvdSceneFlag::eTRANSMIT_CONSTRAINTS, true);
+				pvdClient->setScenePvdFlag(PxPvdSceneFlag::eTRANSMIT_CONTACTS, true);
+				pvdClient->setScenePvdFlag(PxPvdSceneFlag::eTRANSMIT_SCENEQUERIES, true);
+			}
+
+			if (profile_.overrideScene && profile_.broadPhase == PxBroadPhaseType::eMBP)
+			{
+				addBroadPhaseRegions(*scene, regionBounds(region));
+			}
+		}
+		LOG_INFO << "PhysX Scene created (profile: " << profile_.name << ")";
+		if (regionCount > 1)
+		{
+			LOG_INFO << "Region grid: " << regionGrid_ << "x" << regionGrid_ << " scenes, "
+				<< regionCellSize() << " m cells, " << dispatcherThreads << " dispatcher threads";
 		}
-		cout << "PhysX Scene created" << endl;
 
 		// �ݹ߷� ���� Material
 		//(��������,��������,�ݹ߰��)
-		defaultMaterial_ = physics_->createMaterial(0.6f, 0.5f, 0.5f);
+		defaultMaterial_ = physics_->createMaterial(profile_.staticFriction, profile_.dynamicFriction, profile_.restitution);
 		createGround();
 
-		cout << "PhysX initialization complete!" << endl;
+		if (regionCount > 1)
+		{
+			ghostShape_ = physics_->createShape(PxBoxGeometry(0.5f, 0.5f, 0.5f), *defaultMaterial_, false);
+			queryBatch_.setRouting(
+				[this](const PxVec3& position) { return regionAt(position); },
+				[this](const PxRigidActor* actor) { return resolveGhost(actor); });
+		}
+
+		LOG_INFO << "PhysX initialization complete!";
 	}
+	void applySceneProfile(PxSceneDesc& sceneDesc)
+	{
+		if (!profile_.overrideScene)
+			return;
+
+		sceneDesc.broadPhaseType = profile_.broadPhase;
+		sceneDesc.solverType = profile_.solver;
+
+		if (profile_.pcm)
+			sceneDesc.flags |= PxSceneFlag::eENABLE_PCM;
+		else
+			sceneDesc.flags.clear(PxSceneFlag::eENABLE_PCM);
+
+		if (profile_.stabilization)
+			sceneDesc.flags |= PxSceneFlag::eENABLE_STABILIZATION;
+	}
+
+	// MBP는 영역 밖 액터를 충돌에서 제외하므로 맵보다 넉넉하게 잡는다
+	PxBounds3 worldBounds() const
+	{
+		float half = mapSize_ * 2.0f;
+		return PxBounds3(PxVec3(-half, -10.0f, -half), PxVec3(half, 100.0f, half));
+	}
+
+	// 영역 씬의 MBP 범위: 가장자리 칸은 맵 밖까지, 안쪽 경계는 이전 전에 넘어오는 것과 고스트를 위해 반 칸 더
+	PxBounds3 regionBounds(uint32_t region) const
+	{
+		PxBounds3 bounds = worldBounds();
+		if (regionGrid_ == 1)
+			return bounds;
+
+		int ix = static_cast<int>(region) % regionGrid_;
+		int iz = static_cast<int>(region) / regionGrid_;
+		float slack = regionCellSize() * 0.5f;
+		if (ix > 0) bounds.minimum.x = regionEdge(ix) - slack;
+		if (ix < regionGrid_ - 1) bounds.maximum.x = regionEdge(ix + 1) + slack;
+		if (iz > 0) bounds.minimum.z = regionEdge(iz) - slack;
+		if (iz < regionGrid_ - 1) bounds.maximum.z = regionEdge(iz + 1) + slack;
+		return bounds;
+	}
+
+	void addBroadPhaseRegions(PxScene& scene, const PxBounds3& bounds)
+	{
+		PxU32 subdiv = profile_.mbpSubdivisions;
+		vector<PxBounds3> regions(subdiv * subdiv);
+		PxU32 count = PxBroadPhaseExt::createRegionsFromWorldBounds(regions.data(), bounds, subdiv);
+
+		for (PxU32 i = 0; i < count; ++i)
+		{
+			PxBroadPhaseRegion region;
+			region.mBounds = regions[i];
+			region.mUserData = nullptr;
+			scene.addBroadPhaseRegion(region);
+		}
+		LOG_DEBUG << "MBP regions: " << count;
+	}
+
+	// 정적 액터는 씬 사이에 공유할 수 없으므로 영역 씬마다 바닥 하나씩
 	void createGround()
 	{
-		PxRigidStatic* groundPlane = PxCreatePlane(*physics_, PxPlane(0, 1, 0, 0), *defaultMaterial_);
-		scene_->addActor(*groundPlane);
-		cout << "Ground plane created" << endl;
+		for (PxScene* scene : scenes_)
+		{
+			PxRigidStatic* groundPlane = PxCreatePlane(*physics_, PxPlane(0, 1, 0, 0), *defaultMaterial_);
+			scene->addActor(*groundPlane);
+		}
+		LOG_INFO << "Ground plane created";
 	}
 
 	PxRigidDynamic* createPlayerActor(int playerId, const Vector3& pos)
@@ -119,11 +440,13 @@ public:
 
 		actor->setLinearDamping(0.5f);
 		actor->setMaxLinearVelocity(20.0f); //�÷��̾� �ӵ�
+		actor->setSolverIterationCounts(profile_.playerPositionIterations, profile_.playerVelocityIterations);
 
-		scene_->addActor(*actor);
+		actor->userData = makeActorTag(ActorKind::PLAYER, playerId);
+		playerRegions_[playerId] = addEntityActor(actor);
 		playerActors_[playerId] = actor;
 
-		cout << "Player " << playerId << "actor created" << endl;
+		LOG_INFO << "Player " << playerId << "actor created";
 		return actor;
 		actor->setRigidDynamicLockFlag(PxRigidDynamicLockFlag::eLOCK_ANGULAR_X, true);
 		actor->setRigidDynamicLockFlag(PxRigidDynamicLockFlag::eLOCK_ANGULAR_X, true);
@@ -146,16 +469,110 @@ public:
 
 		PxRigidBodyExt::updateMassAndInertia(*actor, 5.0f);
 
-		actor->setSleepThreshold(0.0f); // �浹�� �ٷ� ����
+		// 기본 sleep threshold 유지: 착지 후 멈추면 잠들고, 점프 시 addForce가 깨운다
+		actor->userData = makeActorTag(ActorKind::DUMMY, dummyId);
 		actor->setLinearDamping(0.3f); // ������ �ս�
 		actor->setMaxLinearVelocity(20.0f);
+		actor->setSolverIterationCounts(profile_.dummyPositionIterations, profile_.dummyVelocityIterations);
 		
-		scene_->addActor(*actor);
+		registerDummyActor(dummyId, actor, addEntityActor(actor));
+
+		return actor;
+	}
+
+	// 씬에 들어간 더미 액터를 조회/기록/점프 테이블에 등록
+	void registerDummyActor(int dummyId, PxRigidDynamic* actor, uint32_t region)
+	{
 		dummyActors_[dummyId] = actor;
 
-		dummyJumpTimers_[dummyId] = (rand() % 100) / 100.0f;
+		dummyListIndex_[dummyId] = static_cast<uint32_t>(dummyList_.size());
+		dummyList_.push_back(actor);
+		dummyListIds_.push_back(dummyId);
+		dummyRegions_.push_back(region);
+		dummyBacking_.push_back(nullptr);
+		dummySetVersion_++;
 
-		return actor;
+		// 기록 버퍼는 여기서 미리 확보 (틱 중 할당 방지)
+		history_.reserveDummies(dummyList_.size());
+		rewound_.reserve(history_.dummyCapacity() + history_.playerSlots());
+
+		dummyJumpStates_[dummyId].initialPhase = (rand() % 100) / 100.0f;
+	}
+
+	// ---- 바이너리 직렬화 (방 스냅샷) ----
+
+	PxSerializationRegistry& serializationRegistry()
+	{
+		if (!serializationRegistry_)
+			serializationRegistry_ = PxSerialization::createSerializationRegistry(*physics_);
+		return *serializationRegistry_;
+	}
+
+	// 기본 재질은 스냅샷에 넣지 않고 외부 참조로 둔다 (복원 시 현재 월드 재질을 공유)
+	PxCollection* createExternalRefs()
+	{
+		PxCollection* refs = PxCreateCollection();
+		refs->add(*defaultMaterial_, MATERIAL_SERIAL_ID);
+		return refs;
+	}
+
+	// 더미 액터와 모양을 PhysX 바이너리 컬렉션으로 기록 (시뮬레이션 중이 아닐 때)
+	bool serializeDummies(PxOutputStream& stream)
+	{
+		PxSerializationRegistry& registry = serializationRegistry();
+		PxCollection* refs = createExternalRefs();
+		PxCollection* collection = PxCreateCollection();
+
+		for (uint32_t i = 0; i < dummyList_.size(); ++i)
+		{
+			collection->add(*dummyList_[i], dummySerialId(dummyListIds_[i]));
+		}
+		PxSerialization::complete(*collection, registry, refs);
+		bool ok = PxSerialization::serializeCollectionToBinary(stream, *collection, registry, refs);
+
+		collection->release();
+		refs->release();
+		return ok;
+	}
+
+	// 매핑된 스냅샷의 offset 위치(128바이트 정렬)에서 더미 액터를 복원해 위치에 맞는 영역 씬에 추가
+	// 메모리는 액터가 살아 있어야 하므로 넘겨받아 복원한 더미가 모두 해제될 때까지 보관한다
+	// beforeAdd: 컬렉션을 만든 뒤 씬에 넣기 전에 호출 (기존 더미 교체용, 실패하면 부르지 않는다)
+	bool deserializeDummies(unique_ptr<MappedFile> file, size_t offset, vector<int>& dummyIds,
+		const function<void()>& beforeAdd = nullptr)
+	{
+		PxSerializationRegistry& registry = serializationRegistry();
+		PxCollection* refs = createExternalRefs();
+		PxCollection* collection = PxSerialization::createCollectionFromBinary(file->data() + offset, registry, refs);
+		refs->release();
+		if (!collection)
+		{
+			LOG_ERROR << "PhysX snapshot deserialization failed";
+			return false;
+		}
+		if (beforeAdd)
+			beforeAdd();
+
+		shared_ptr<MappedFile> backing(move(file));
+
+		dummyIds.clear();
+		for (PxU32 i = 0; i < collection->getNbObjects(); ++i)
+		{
+			PxBase& object = collection->getObject(i);
+			PxRigidDynamic* actor = object.is<PxRigidDynamic>();
+			if (!actor)
+				continue; // 모양 등
+
+			int dummyId = static_cast<int>(collection->getId(object) & 0xFFFFFFFFu);
+			actor->userData = makeActorTag(ActorKind::DUMMY, dummyId);
+			actor->setSolverIterationCounts(profile_.dummyPositionIterations, profile_.dummyVelocityIterations);
+			registerDummyActor(dummyId, actor, addEntityActor(actor));
+			dummyBacking_.back() = backing;
+			dummyIds.push_back(dummyId);
+		}
+
+		collection->release();
+		return true;
 	}
 	void applyPlayerInput(int playerId, const Vector3& movement)
 	{
@@ -180,60 +597,230 @@ public:
 			PxRigidDynamic* actor = it->second;
 			PxVec3 velocity = actor->getLinearVelocity();
 
-			// 땅에 있을 때만 점프 (y속도가 작을 때)
-			if (abs(velocity.y) < 0.5f)
+			// 발밑에 무언가 있을 때만 점프 (바닥/플랫폼/쌓인 더미 모두, 지난 틱 배치 쿼리 결과)
+			// 올라가는 중에는 아직 접지로 남아 있을 수 있으므로 y속도도 본다
+			if (groundedPlayers_.count(playerId) && velocity.y < 0.5f)
 			{
-				PxTransform pose = actor->getGlobalPose();
-				// 바닥 근처에 있을 때만
-				if (pose.p.y < 2.0f)
+				const float PLAYER_JUMP_FORCE = 150.0f;
+				PxVec3 jumpForce(0.0f, PLAYER_JUMP_FORCE, 0.0f);
+				actor->addForce(jumpForce, PxForceMode::eIMPULSE);
+				LOG_DEBUG << "Player " << playerId << " jumped!";
+			}
+		}
+	}
+	// 만기된 더미만 처리 (전체 더미 순회 없음)
+	// 1) 타이머 휠에서 만기 id 수집 2) 점프 여부 판정은 청크 병렬 (읽기만)
+	// 3) 상태 갱신과 힘 적용은 호출 스레드에서 순서대로 (같은 id가 휠에 두 번 있어도 한 번만 점프)
+	void updateDummies(float deltaTime)
+	{
+		lastDeltaTime_ = deltaTime;
+		jumpsThisTick_ = 0;
+
+		dueDummies_.clear();
+		jumpWheel_.advance(tick_, [this](int dummyId) { dueDummies_.push_back(dummyId); });
+		if (dueDummies_.empty())
+			return;
+
+		jumpCandidates_.assign(dueDummies_.size(), nullptr);
+		parallelFor(taskPool_, dueDummies_.size(), DUE_GRAIN, [this](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
 				{
-					const float PLAYER_JUMP_FORCE = 150.0f;
-					PxVec3 jumpForce(0.0f, PLAYER_JUMP_FORCE, 0.0f);
-					actor->addForce(jumpForce, PxForceMode::eIMPULSE);
-					cout << "Player " << playerId << " jumped!" << endl;
+					auto stateIt = dummyJumpStates_.find(dueDummies_[i]);
+					if (stateIt == dummyJumpStates_.end())
+						continue;
+
+					// 재착지로 다시 예약된 경우 이전 예약은 무시, 받침이 없으면(공중) 점프 안 함
+					const DummyJumpState& state = stateIt->second;
+					if (!state.scheduled || state.jumpDueTick != tick_ || state.supportContacts <= 0)
+						continue;
+
+					auto actorIt = dummyActors_.find(dueDummies_[i]);
+					if (actorIt != dummyActors_.end())
+						jumpCandidates_[i] = actorIt->second;
 				}
+			});
+
+		for (size_t i = 0; i < dueDummies_.size(); ++i)
+		{
+			auto stateIt = dummyJumpStates_.find(dueDummies_[i]);
+			if (stateIt == dummyJumpStates_.end() || !stateIt->second.scheduled || stateIt->second.jumpDueTick != tick_)
+				continue;
+			stateIt->second.scheduled = false;
+
+			if (jumpCandidates_[i])
+			{
+				// 잠든 더미는 여기서 명시적으로 깨운다 (autowake)
+				PxVec3 jumpForce(0.0f, JUMP_FORCE, 0.0f);
+				jumpCandidates_[i]->addForce(jumpForce, PxForceMode::eIMPULSE, true);
+				jumpsThisTick_++;
 			}
 		}
 	}
-	void updateDummies(float deltaTime)
+
+	// 더미가 받침을 새로 얻었을 때 (공중 -> 착지)
+	void onDummyLanded(int dummyId, DummyJumpState& state)
 	{
-		for (auto& pair : dummyActors_)
+		int intervalTicks = std::max(1, static_cast<int>(JUMP_INTERVAL / lastDeltaTime_ + 0.5f));
+		int delay = intervalTicks;
+		if (!state.hasLanded)
 		{
-			int dummyId = pair.first;
-			PxRigidDynamic* actor = pair.second;
-			
-			if (!actor) continue;
+			delay = std::max(1, static_cast<int>(intervalTicks * (1.0f - state.initialPhase)));
+			state.hasLanded = true;
+		}
 
-			PxVec3 velocity = actor->getLinearVelocity();
-			bool isOnGround = abs(velocity.y) < 0.5f;
+		state.scheduled = true;
+		state.jumpDueTick = tick_ + delay;
+		jumpWheel_.schedule(dummyId, state.jumpDueTick);
+	}
+
+	static uint64_t contactPairKey(uint32_t tag0, uint32_t tag1)
+	{
+		if (tag0 > tag1) std::swap(tag0, tag1);
+		return (static_cast<uint64_t>(tag0) << 32) | tag1;
+	}
 
-			//�ٴڿ� �ְ�, ��ġ�� ������ ����
-			PxTransform pose = actor->getGlobalPose();
-			bool isLowEnough = pose.p.y < 1.0f;//�ٴ� ��ó
+	// PxSimulationEventCallback (fetchResults 안에서 호출)
+	void onContact(const PxContactPairHeader& pairHeader, const PxContactPair* pairs, PxU32 nbPairs) override
+	{
+		// 삭제된 액터가 섞인 쌍은 포인터가 무효 -> removeDummy에서 따로 정리
+		if (pairHeader.flags & (PxContactPairHeaderFlag::eREMOVED_ACTOR_0 | PxContactPairHeaderFlag::eREMOVED_ACTOR_1))
+			return;
 
-			if (isOnGround && isLowEnough)
+		uint32_t tag0 = actorTagValue(pairHeader.actors[0]);
+		uint32_t tag1 = actorTagValue(pairHeader.actors[1]);
+
+		for (PxU32 i = 0; i < nbPairs; ++i)
+		{
+			const PxContactPair& pair = pairs[i];
+			if (pair.events & PxPairFlag::eNOTIFY_TOUCH_FOUND)
 			{
-				dummyJumpTimers_[dummyId] += deltaTime;
-				if (dummyJumpTimers_[dummyId] >= JUMP_INTERVAL)
-				{
-					dummyJumpTimers_[dummyId] = 0.0f;
+				int supported = findSupportedDummy(
+					static_cast<PxRigidActor*>(pairHeader.actors[0]),
+					static_cast<PxRigidActor*>(pairHeader.actors[1]));
+				if (supported < 0)
+					continue;
+
+				auto stateIt = dummyJumpStates_.find(supported);
+				if (stateIt == dummyJumpStates_.end())
+					continue;
 
-					//����
-					PxVec3 jumpForce(0.0f, JUMP_FORCE, 0.0f);
-					actor->addForce(jumpForce, PxForceMode::eIMPULSE);
+				addSupportPair(contactPairKey(tag0, tag1), supported);
+
+				// 영역 이전으로 옮겨 온 받침이 새 씬에서 다시 잡힘: 이미 세어 둔 접촉이라 새 착지가 아니다
+				if (stateIt->second.carriedContacts > 0)
+				{
+					stateIt->second.carriedContacts--;
+					continue;
+				}
+				if (stateIt->second.supportContacts++ == 0)
+				{
+					onDummyLanded(supported, stateIt->second);
 				}
 			}
-			else
+			else if (pair.events & PxPairFlag::eNOTIFY_TOUCH_LOST)
 			{
-				//���߿� ������ Ÿ�̸� ����(���� ����)
+				auto pairIt = supportPairs_.find(contactPairKey(tag0, tag1));
+				if (pairIt == supportPairs_.end())
+					continue;
+
+				auto stateIt = dummyJumpStates_.find(pairIt->second);
+				if (stateIt != dummyJumpStates_.end() && stateIt->second.supportContacts > 0)
+				{
+					stateIt->second.supportContacts--;
+				}
+				unindexSupportPair(pairIt->first);
+				supportPairs_.erase(pairIt);
 			}
 		}
 	}
+	void onConstraintBreak(PxConstraintInfo*, PxU32) override {}
+	void onWake(PxActor**, PxU32) override {}
+	void onSleep(PxActor**, PxU32) override {}
+	void onTrigger(PxTriggerPair*, PxU32) override {}
+	void onAdvance(const PxRigidBody* const*, const PxTransform*, const PxU32) override {}
+
+	// 접촉 쌍에서 아래쪽에 받쳐지는 더미 id (없으면 -1)
+	// 정적 액터(바닥)와 닿으면 받침, 동적 액터끼리는 위에 올라탄 쪽이 받쳐짐
+	int findSupportedDummy(PxRigidActor* actor0, PxRigidActor* actor1)
+	{
+		uint32_t tag0 = actorTagValue(actor0);
+		uint32_t tag1 = actorTagValue(actor1);
+		ActorKind kind0 = actorTagKind(tag0);
+		ActorKind kind1 = actorTagKind(tag1);
+
+		if (kind0 == ActorKind::DUMMY && kind1 == ActorKind::STATIC)
+			return actorTagId(tag0);
+		if (kind1 == ActorKind::DUMMY && kind0 == ActorKind::STATIC)
+			return actorTagId(tag1);
+
+		const float STACK_HEIGHT = 0.5f; // 박스 반높이 이상 위에 있으면 올라탄 것
+		float dy = actor0->getGlobalPose().p.y - actor1->getGlobalPose().p.y;
+		if (kind0 == ActorKind::DUMMY && dy > STACK_HEIGHT)
+			return actorTagId(tag0);
+		if (kind1 == ActorKind::DUMMY && -dy > STACK_HEIGHT)
+			return actorTagId(tag1);
+		return -1;
+	}
+
+	int getJumpsThisTick() const { return jumpsThisTick_; }
+
+	// 깨어 있는 더미 수 (상태 출력/벤치용, O(n))
+	int countAwakeDummies() const
+	{
+		int awake = 0;
+		for (PxRigidDynamic* actor : dummyList_)
+		{
+			if (!actor->isSleeping())
+				awake++;
+		}
+		return awake;
+	}
+
+	// 이번 스텝에 움직인 더미만 순회 (잠든 더미는 건너뜀)
+	// 풀이 있으면 청크 병렬: func는 여러 스레드에서 불리므로 더미마다 다른 곳에만 써야 한다
+	// 영역이 여럿이면 이전/고스트 갱신 전에 모아 둔 목록으로 (그 뒤로 씬 구성이 바뀌었으므로)
+	template <typename F>
+	void forEachActiveDummy(F&& func)
+	{
+		if (scenes_.size() > 1)
+		{
+			parallelFor(taskPool_, activeDummies_.size(), SYNC_GRAIN, [this, &func](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; ++i)
+					{
+						PxTransform pose = activeDummies_[i].first->getGlobalPose();
+						func(activeDummies_[i].second, Vector3(pose.p.x, pose.p.y, pose.p.z));
+					}
+				});
+			return;
+		}
+
+		PxU32 count = 0;
+		PxActor** actors = scenes_[0]->getActiveActors(count);
+		parallelFor(taskPool_, count, SYNC_GRAIN, [actors, &func](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					uint32_t tag = actorTagValue(actors[i]);
+					if (actorTagKind(tag) == ActorKind::DUMMY)
+					{
+						PxTransform pose = static_cast<PxRigidActor*>(actors[i])->getGlobalPose();
+						func(actorTagId(tag), Vector3(pose.p.x, pose.p.y, pose.p.z));
+					}
+				}
+			});
+	}
 
 	void simulate(float deltaTime)
 	{
-		if (scene_)
+		if (!scenes_.empty())
 		{
+			tick_++;
+
+			// 지난 틱 쿼리 결과 반영 (접지 판정, 상호작용 콜백)
+			queryBatch_.dispatchResults();
+
 			//���� ���� ������Ʈ
 			updateDummies(deltaTime);
 
@@ -243,10 +830,217 @@ public:
 			{
 				deltaTime = fixedStep * 2.0f;
 			}
-			scene_->simulate(deltaTime);
-			scene_->fetchResults(true);
+			// 영역 씬을 모두 띄운 뒤 차례로 기다린다 (씬끼리 디스패처 스레드에서 겹쳐 돈다)
+			auto simulateStart = chrono::steady_clock::now();
+			for (PxScene* scene : scenes_)
+				scene->simulate(deltaTime);
+			for (PxScene* scene : scenes_)
+				scene->fetchResults(true);
+			float simulateMicros = chrono::duration<float, micro>(chrono::steady_clock::now() - simulateStart).count();
+			if (scenes_.size() > 1)
+			{
+				settleCarriedSupports();
+				updateRegions();
+			}
+			updateTickStats(simulateMicros);
+			if (pvdTransport_)
+				onPvdCaptureTick();
+
+			recordHistory();
+
+			queueGroundChecks();
+			queryBatch_.execute(scenes_);
+		}
+	}
+
+	// 플레이어마다 발바닥 크기의 얇은 박스를 아래로 스윕 (박스 반높이 0.5 + 여유 0.1)
+	void queueGroundChecks()
+	{
+		const PxBoxGeometry foot(0.45f, 0.05f, 0.45f);
+		const float GROUND_SWEEP_DISTANCE = 0.45f + 0.1f;
+
+		for (auto& pair : playerActors_)
+		{
+			if (!pair.second)
+				continue;
+
+			int playerId = pair.first;
+			PxRigidDynamic* actor = pair.second;
+			PxTransform pose(actor->getGlobalPose().p);
+			queryBatch_.sweep(foot, pose, PxVec3(0.0f, -1.0f, 0.0f), GROUND_SWEEP_DISTANCE,
+				[this, playerId, actor](const SceneQueryHit* hits, size_t count)
+				{
+					// 결과는 다음 틱에 오므로 그 사이 나간 플레이어(같은 슬롯의 새 플레이어 포함)는 건드리지 않는다
+					auto it = playerActors_.find(playerId);
+					if (it == playerActors_.end() || it->second != actor)
+						return;
+
+					// 벽 옆면은 접지가 아님
+					if (count > 0 && hits[0].actor && hits[0].normal.y > 0.5f)
+						groundedPlayers_.insert(playerId);
+					else
+						groundedPlayers_.erase(playerId);
+				},
+				pair.second);
+		}
+	}
+
+	// 현재 틱의 트랜스폼을 기록 (매 틱, 할당 없음)
+	void recordHistory()
+	{
+		auto start = chrono::steady_clock::now();
+
+		int frame = history_.beginFrame(tick_, dummySetVersion_);
+		for (auto& pair : playerActors_)
+		{
+			if (pair.second && pair.first >= 0 && pair.first < history_.playerSlots())
+			{
+				history_.writePlayer(frame, pair.first, pair.second->getGlobalPose());
+			}
+		}
+		parallelFor(taskPool_, dummyList_.size(), RECORD_GRAIN, [this, frame](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					history_.writeDummyPose(frame, static_cast<uint32_t>(i), dummyListIds_[i], dummyList_[i]->getGlobalPose());
+				}
+			});
+		history_.setDummyCount(frame, static_cast<uint32_t>(dummyList_.size()));
+
+		lastRecordMicros_ = chrono::duration<float, micro>(chrono::steady_clock::now() - start).count();
+	}
+
+	// 과거 시점으로 되감기 (랙 보정 판정용)
+	// viewTick: 클라이언트가 보고 있던 틱 (GAME_STATE의 tick, 보간 중이면 소수)
+	// center가 주어지면 radius 안에 있던 엔티티만 되감는다
+	// 판정이 끝나면 반드시 restoreRewind() 호출
+	bool rewindTo(double viewTick, const PxVec3* center = nullptr, float radius = 0.0f)
+	{
+		int older, newer;
+		float alpha;
+		if (!history_.findFrames(viewTick, older, newer, alpha))
+			return false;
+
+		rewound_.clear();
+		const StateHistory::FrameInfo& a = history_.frameInfo(older);
+		const StateHistory::FrameInfo& b = history_.frameInfo(newer);
+
+		for (auto& pair : playerActors_)
+		{
+			int slot = pair.first;
+			if (!pair.second || slot < 0 || slot >= history_.playerSlots())
+				continue;
+			if (!history_.hasPlayer(older, slot))
+				continue;
+
+			PxTransform pose = history_.playerPose(older, slot);
+			if (history_.hasPlayer(newer, slot))
+				pose = StateHistory::interpolate(pose, history_.playerPose(newer, slot), alpha);
+			applyRewindPose(pair.second, pose, center, radius);
+		}
+
+		// 더미 구성이 같으면 인덱스로 바로 매칭, 아니면 id로 찾는다
+		bool aligned = a.dummySetVersion == b.dummySetVersion;
+		bool current = a.dummySetVersion == dummySetVersion_;
+		for (uint32_t i = 0; i < a.dummyCount; ++i)
+		{
+			PxTransform pose = history_.dummyPose(older, i);
+			if (aligned && i < b.dummyCount)
+				pose = StateHistory::interpolate(pose, history_.dummyPose(newer, i), alpha);
+
+			PxRigidDynamic* actor = nullptr;
+			if (current)
+			{
+				actor = i < dummyList_.size() ? dummyList_[i] : nullptr;
+			}
+			else
+			{
+				auto it = dummyActors_.find(history_.dummyId(older, i));
+				actor = it != dummyActors_.end() ? it->second : nullptr;
+			}
+			if (actor)
+				applyRewindPose(actor, pose, center, radius);
+		}
+		return true;
+	}
+
+	void restoreRewind()
+	{
+		for (auto it = rewound_.rbegin(); it != rewound_.rend(); ++it)
+		{
+			it->first->setGlobalPose(it->second, false);
 		}
+		rewound_.clear();
+	}
+
+	// 되감은 상태에서 query 실행 후 복구
+	template <typename F>
+	bool withRewind(double viewTick, F&& query, const PxVec3* center = nullptr, float radius = 0.0f)
+	{
+		if (!rewindTo(viewTick, center, radius))
+			return false;
+		query();
+		restoreRewind();
+		return true;
+	}
+
+	uint32_t getTick() const { return tick_; }
+	const PhysicsTickStats& getTickStats() const { return tickStats_; }
+	int getRegionGrid() const { return regionGrid_; }
+	long long getHandoffsTotal() const { return handoffsTotal_; }
+
+	// 다음 틱부터 ticks 틱 동안 PVD 스트림을 path(.pxd2)에 기록, 틱별 통계는 path + ".stats.csv"
+	// 이미 캡처 중이면 false (씬이 시뮬레이션 중이 아닐 때 호출)
+	bool startPvdCapture(const string& path, uint32_t ticks)
+	{
+		if (!pvd_ || pvdTransport_ || ticks == 0)
+			return false;
+
+		pvdTransport_ = PxDefaultPvdFileTransportCreate(path.c_str());
+		if (!pvdTransport_)
+		{
+			LOG_ERROR << "PVD file transport failed: " << path;
+			return false;
+		}
+		if (!pvd_->connect(*pvdTransport_, PxPvdInstrumentationFlag::eALL))
+		{
+			LOG_ERROR << "PVD connect failed: " << path;
+			pvdTransport_->release();
+			pvdTransport_ = nullptr;
+			return false;
+		}
+
+		pvdPath_ = path;
+		pvdStopTick_ = tick_ + ticks;
+		pvdStatsCsv_.open(path + ".stats.csv", ios::trunc);
+		if (pvdStatsCsv_)
+			pvdStatsCsv_ << PhysicsTickStats::csvHeader() << '\n';
+		LOG_INFO << "PVD capture started: " << path << " (" << ticks << " ticks, until tick " << pvdStopTick_ << ")";
+		return true;
+	}
+
+	void stopPvdCapture()
+	{
+		if (!pvdTransport_)
+			return;
+
+		pvd_->disconnect();
+		pvdTransport_->release();
+		pvdTransport_ = nullptr;
+		pvdStatsCsv_.close();
+		LOG_INFO << "PVD capture finished: " << pvdPath_ << " (tick " << tick_ << ")";
 	}
+
+	bool isPvdCapturing() const { return pvdTransport_ != nullptr; }
+	const string& getPvdPath() const { return pvdPath_; }
+	uint32_t getPvdRemainingTicks() const { return pvdTransport_ && pvdStopTick_ > tick_ ? pvdStopTick_ - tick_ : 0; }
+
+	void setTaskPool(TaskPool* pool) { taskPool_ = pool; }
+	const SceneProfile& getSceneProfile() const { return profile_; }
+	float getLastRecordMicros() const { return lastRecordMicros_; }
+	SceneQueryBatch& getQueryBatch() { return queryBatch_; }
+	const SceneQueryBatch& getQueryBatch() const { return queryBatch_; }
+	const StateHistory& getHistory() const { return history_; }
 	Vector3 getPlayerPosition(int playerId)
 	{
 		auto it = playerActors_.find(playerId);
@@ -278,14 +1072,40 @@ public:
 		}
 		return Vector3();
 	}
+	Vector3 getDummyVelocity(int dummyId)
+	{
+		auto it = dummyActors_.find(dummyId);
+		if (it != dummyActors_.end() && it->second)
+		{
+			PxVec3 vel = it->second->getLinearVelocity();
+			return Vector3(vel.x, vel.y, vel.z);
+		}
+		return Vector3();
+	}
+	// 장식용 더미를 액터로 승격할 때 이어받는 속도
+	void setDummyVelocity(int dummyId, const Vector3& velocity)
+	{
+		auto it = dummyActors_.find(dummyId);
+		if (it != dummyActors_.end() && it->second)
+		{
+			it->second->setLinearVelocity(PxVec3(velocity.x, velocity.y, velocity.z));
+		}
+	}
 	void removePlayer(int playerId)
 	{
 		auto it = playerActors_.find(playerId);
 		if (it != playerActors_.end() && it->second)
 		{
-			it->second->release();
+			PxRigidDynamic* actor = it->second;
+			queryBatch_.forgetActors([actor](const PxRigidActor* other) { return other == actor; });
+			groundedPlayers_.erase(playerId);
+
+			releaseGhosts(actorTagValue(actor));
+			actor->release();
 			playerActors_.erase(it);
-			cout << "Player " << playerId << " actor removed" << endl;
+			playerRegions_.erase(playerId);
+			purgeSupportPairs(makeActorTag(ActorKind::PLAYER, playerId));
+			LOG_INFO << "Player " << playerId << " actor removed";
 		}
 	}
 	void removeDummy(int dummyId)
@@ -293,14 +1113,83 @@ public:
 		auto actorIt = dummyActors_.find(dummyId);
 		if (actorIt != dummyActors_.end() && actorIt->second)
 		{
-			actorIt->second->release();
+			PxRigidDynamic* actor = actorIt->second;
+			queryBatch_.forgetActors([actor](const PxRigidActor* other) { return other == actor; });
+			releaseGhosts(actorTagValue(actor));
+			actor->release();
 			dummyActors_.erase(actorIt);
 		}
-		dummyJumpTimers_.erase(dummyId);
+		dummyJumpStates_.erase(dummyId);
+		purgeSupportPairs(makeActorTag(ActorKind::DUMMY, dummyId));
+
+		// dense 목록에서 swap-remove
+		auto indexIt = dummyListIndex_.find(dummyId);
+		if (indexIt != dummyListIndex_.end())
+		{
+			uint32_t index = indexIt->second;
+			uint32_t last = static_cast<uint32_t>(dummyList_.size() - 1);
+			if (index != last)
+			{
+				dummyList_[index] = dummyList_[last];
+				dummyListIds_[index] = dummyListIds_[last];
+				dummyRegions_[index] = dummyRegions_[last];
+				dummyBacking_[index] = move(dummyBacking_[last]);
+				dummyListIndex_[dummyListIds_[index]] = index;
+			}
+			dummyList_.pop_back();
+			dummyListIds_.pop_back();
+			dummyRegions_.pop_back();
+			dummyBacking_.pop_back(); // 액터는 위에서 해제됨
+			dummyListIndex_.erase(indexIt);
+			dummySetVersion_++;
+		}
 	}
+	// 더미 전체 삭제 (개별 removeDummy 반복보다 빠름: 접촉 정리가 O(1))
+	void removeAllDummies()
+	{
+		queryBatch_.forgetActors([](const PxRigidActor* actor) {
+			return actorTagKind(actorTagValue(actor)) == ActorKind::DUMMY;
+		});
+
+		for (PxRigidDynamic* actor : dummyList_)
+		{
+			actor->release();
+		}
+		for (auto it = ghosts_.begin(); it != ghosts_.end();)
+		{
+			if (actorTagKind(it->first) != ActorKind::DUMMY)
+			{
+				++it;
+				continue;
+			}
+			for (uint32_t i = 0; i < it->second.count; ++i)
+				it->second.ghosts[i].actor->release();
+			ghostCount_ -= it->second.count;
+			it = ghosts_.erase(it);
+		}
+		dummyActors_.clear();
+		dummyList_.clear();
+		dummyListIds_.clear();
+		dummyListIndex_.clear();
+		dummyRegions_.clear();
+		dummyBacking_.clear(); // 액터를 모두 해제한 뒤
+		activeDummies_.clear();
+		dummySetVersion_++;
+
+		// 받침 쌍은 항상 더미 하나를 포함하므로 전부 비운다
+		dummyJumpStates_.clear();
+		supportPairs_.clear();
+		supportPairsByTag_.clear();
+		carriedDummies_.clear();
+		jumpWheel_.clear();
+	}
+
 	void cleanup()
 	{
-		cout << "Cleaning up PhysX..." << endl;
+		LOG_INFO << "Cleaning up PhysX...";
+
+		// PVD 연결을 먼저 끊는다 (액터/씬/피직스 해제 이벤트를 캡처 파일에 쓰지 않게)
+		stopPvdCapture();
 
 		for (auto& pair : playerActors_)
 		{
@@ -310,12 +1199,424 @@ public:
 		{
 			if (pair.second) pair.second->release();
 		}
+		dummyBacking_.clear(); // 스냅샷 매핑은 복원한 액터를 해제한 뒤
+		for (auto& pair : ghosts_)
+		{
+			for (uint32_t i = 0; i < pair.second.count; ++i)
+				pair.second.ghosts[i].actor->release();
+		}
+		ghosts_.clear();
+		if (ghostShape_) ghostShape_->release();
 
-		if (scene_) scene_->release();
+		queryBatch_.release();
+		if (serializationRegistry_) serializationRegistry_->release();
+		for (PxScene* scene : scenes_)
+			scene->release();
+		scenes_.clear();
 		if (dispatcher_) dispatcher_->release();
 		if (physics_) physics_->release();
+		if (pvd_) pvd_->release();
 		if (foundation_) foundation_->release();
 
-		cout << "PhysX cleaned up" << endl;
+		LOG_INFO << "PhysX cleaned up";
+	}
+
+private:
+	// 영역 씬 합계 (고스트도 동적 바디로 세어진다)
+	void updateTickStats(float simulateMicros)
+	{
+		tickStats_ = PhysicsTickStats();
+		for (PxScene* scene : scenes_)
+		{
+			PxSimulationStatistics stats;
+			scene->getSimulationStatistics(stats);
+
+			tickStats_.activeDynamicBodies += stats.nbActiveDynamicBodies;
+			tickStats_.dynamicBodies += stats.nbDynamicBodies;
+			tickStats_.staticBodies += stats.nbStaticBodies;
+			tickStats_.activeConstraints += stats.nbActiveConstraints;
+			tickStats_.axisSolverConstraints += stats.nbAxisSolverConstraints;
+			tickStats_.partitions += stats.nbPartitions;
+			tickStats_.contactPairs += stats.nbDiscreteContactPairsTotal;
+			tickStats_.contactPairsWithContacts += stats.nbDiscreteContactPairsWithContacts;
+			tickStats_.newPairs += stats.nbNewPairs;
+			tickStats_.lostPairs += stats.nbLostPairs;
+			tickStats_.newTouches += stats.nbNewTouches;
+			tickStats_.lostTouches += stats.nbLostTouches;
+		}
+		tickStats_.tick = tick_;
+		tickStats_.simulateMicros = simulateMicros;
+		tickStats_.regions = static_cast<uint32_t>(scenes_.size());
+		tickStats_.ghostActors = ghostCount_;
+		tickStats_.handoffs = handoffsThisTick_;
+	}
+
+	void onPvdCaptureTick()
+	{
+		if (pvdStatsCsv_)
+			tickStats_.writeCsv(pvdStatsCsv_);
+		if (tick_ >= pvdStopTick_)
+			stopPvdCapture();
+	}
+
+	// 삭제되는 액터가 걸린 받침 접촉 정리
+	// (삭제된 액터의 TOUCH_LOST는 포인터가 무효라 onContact에서 무시하므로 여기서 처리)
+	// 고스트는 같은 태그가 여러 씬에 있으므로 region을 주면 그 영역 더미가 받쳐진 쌍만
+	void purgeSupportPairs(void* removedTag, uint32_t region = ALL_REGIONS)
+	{
+		dropSupportPairs(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(removedTag)), region, false);
+	}
+
+	// 씬을 옮기는 액터(와 그 자리를 넘겨주는 고스트)의 받침 쌍: 쌍 키만 지우고 받침 수는 남겨 둔다
+	// 새 씬에서 다시 잡히는 접촉은 새 착지로 치지 않고, 다음 스텝에 안 잡힌 만큼만 settleCarriedSupports에서 뺀다
+	void carrySupportPairs(uint32_t tag, uint32_t region = ALL_REGIONS)
+	{
+		dropSupportPairs(tag, region, true);
+	}
+
+	void dropSupportPairs(uint32_t tag, uint32_t region, bool carry)
+	{
+		auto indexIt = supportPairsByTag_.find(tag);
+		if (indexIt == supportPairsByTag_.end())
+			return;
+
+		// unindexSupportPair가 이 목록을 고치므로 복사본으로 돈다
+		supportPurgeScratch_.assign(indexIt->second.begin(), indexIt->second.end());
+		for (uint64_t key : supportPurgeScratch_)
+		{
+			auto it = supportPairs_.find(key);
+			if (it == supportPairs_.end())
+				continue;
+			if (region != ALL_REGIONS && dummyRegion(it->second) != region)
+				continue;
+
+			auto stateIt = dummyJumpStates_.find(it->second);
+			if (stateIt != dummyJumpStates_.end() && stateIt->second.supportContacts > 0)
+			{
+				if (!carry)
+				{
+					// 삭제되는 액터 위에 있던 더미는 받침을 잃는다
+					stateIt->second.supportContacts--;
+				}
+				else if (stateIt->second.carriedContacts++ == 0)
+				{
+					carriedDummies_.push_back(it->second);
+				}
+			}
+			unindexSupportPair(key);
+			supportPairs_.erase(it);
+		}
+	}
+
+	// 이전 다음 스텝에서 다시 잡히지 않은 받침은 그때 잃은 것으로
+	void settleCarriedSupports()
+	{
+		for (int dummyId : carriedDummies_)
+		{
+			auto stateIt = dummyJumpStates_.find(dummyId);
+			if (stateIt == dummyJumpStates_.end())
+				continue;
+			DummyJumpState& state = stateIt->second;
+			state.supportContacts = std::max(0, state.supportContacts - state.carriedContacts);
+			state.carriedContacts = 0;
+		}
+		carriedDummies_.clear();
+	}
+
+	void addSupportPair(uint64_t key, int supported)
+	{
+		auto inserted = supportPairs_.emplace(key, supported);
+		if (!inserted.second)
+		{
+			inserted.first->second = supported;
+			return;
+		}
+		for (uint32_t tag : { static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key) })
+		{
+			if (actorTagKind(tag) != ActorKind::STATIC)
+				supportPairsByTag_[tag].push_back(key);
+		}
+	}
+
+	void unindexSupportPair(uint64_t key)
+	{
+		for (uint32_t tag : { static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key) })
+		{
+			if (actorTagKind(tag) == ActorKind::STATIC)
+				continue;
+			auto it = supportPairsByTag_.find(tag);
+			if (it == supportPairsByTag_.end())
+				continue;
+			vector<uint64_t>& keys = it->second;
+			auto keyIt = std::find(keys.begin(), keys.end(), key);
+			if (keyIt != keys.end())
+			{
+				*keyIt = keys.back();
+				keys.pop_back();
+			}
+			if (keys.empty())
+				supportPairsByTag_.erase(it);
+		}
+	}
+
+	// ---- 영역 격자 ----
+
+	float regionCellSize() const { return mapSize_ / regionGrid_; }
+	float regionEdge(int index) const { return -mapSize_ * 0.5f + index * regionCellSize(); }
+
+	// 격자는 맵 가운데 mapSize 범위를 나누고, 바깥은 가장자리 칸에 속한다
+	int regionCell(float coordinate) const
+	{
+		int index = static_cast<int>(floorf((coordinate + mapSize_ * 0.5f) / regionCellSize()));
+		return std::min(std::max(index, 0), regionGrid_ - 1);
+	}
+
+	uint32_t regionAt(const PxVec3& position) const
+	{
+		return static_cast<uint32_t>(regionCell(position.x) + regionCell(position.z) * regionGrid_);
+	}
+
+	// 칸을 margin 넘게 벗어나지 않았는지 (가장자리 칸은 바깥쪽 끝이 없다)
+	bool insideRegion(uint32_t region, const PxVec3& position, float margin) const
+	{
+		auto inside = [this, margin](int index, float coordinate) {
+			return (index == 0 || coordinate >= regionEdge(index) - margin)
+				&& (index == regionGrid_ - 1 || coordinate < regionEdge(index + 1) + margin);
+		};
+		return inside(static_cast<int>(region) % regionGrid_, position.x)
+			&& inside(static_cast<int>(region) / regionGrid_, position.z);
+	}
+
+	// 소유 영역 (지금 영역을 HANDOFF_MARGIN 안에서는 유지)과 고스트가 필요한 이웃 영역들
+	uint32_t planRegions(uint32_t current, const PxVec3& position, uint32_t* wanted, uint32_t& wantedCount) const
+	{
+		uint32_t owner = insideRegion(current, position, HANDOFF_MARGIN) ? current : regionAt(position);
+		wantedCount = 0;
+		for (int iz = regionCell(position.z - GHOST_MARGIN); iz <= regionCell(position.z + GHOST_MARGIN); ++iz)
+		{
+			for (int ix = regionCell(position.x - GHOST_MARGIN); ix <= regionCell(position.x + GHOST_MARGIN); ++ix)
+			{
+				uint32_t region = static_cast<uint32_t>(ix + iz * regionGrid_);
+				if (region != owner && wantedCount < 4)
+					wanted[wantedCount++] = region;
+			}
+		}
+		return owner;
+	}
+
+	uint32_t dummyRegion(int dummyId) const
+	{
+		auto it = dummyListIndex_.find(dummyId);
+		return it != dummyListIndex_.end() ? dummyRegions_[it->second] : ALL_REGIONS;
+	}
+
+	uint32_t entityRegion(uint32_t tag) const
+	{
+		if (actorTagKind(tag) == ActorKind::DUMMY)
+			return dummyRegion(actorTagId(tag));
+		auto it = playerRegions_.find(actorTagId(tag));
+		return it != playerRegions_.end() ? it->second : 0;
+	}
+
+	void setEntityRegion(uint32_t tag, uint32_t region)
+	{
+		if (actorTagKind(tag) == ActorKind::DUMMY)
+		{
+			auto it = dummyListIndex_.find(actorTagId(tag));
+			if (it != dummyListIndex_.end())
+				dummyRegions_[it->second] = region;
+		}
+		else
+		{
+			playerRegions_[actorTagId(tag)] = region;
+		}
+	}
+
+	// 새 엔티티 액터(태그 설정 후)를 위치의 영역 씬에 넣고 경계 근처면 고스트까지, 소유 영역 반환
+	uint32_t addEntityActor(PxRigidDynamic* actor)
+	{
+		PxTransform pose = actor->getGlobalPose();
+		uint32_t region = regionAt(pose.p);
+		scenes_[region]->addActor(*actor);
+		if (scenes_.size() > 1)
+		{
+			uint32_t wanted[4];
+			uint32_t wantedCount;
+			planRegions(region, pose.p, wanted, wantedCount);
+			syncGhosts(actorTagValue(actor), pose, wanted, wantedCount);
+		}
+		return region;
+	}
+
+	// 고스트 -> 주인 액터 (쿼리 결과가 영역과 무관하게 실제 엔티티를 가리키도록)
+	const PxRigidActor* resolveGhost(const PxRigidActor* actor) const
+	{
+		uint32_t tag = actorTagValue(actor);
+		if (actorTagKind(tag) != ActorKind::GHOST)
+			return actor;
+
+		uint32_t ownerTag = ghostOwnerTag(tag);
+		const auto& actors = actorTagKind(ownerTag) == ActorKind::PLAYER ? playerActors_ : dummyActors_;
+		auto it = actors.find(actorTagId(ownerTag));
+		return it != actors.end() ? it->second : actor;
+	}
+
+	// fetchResults 직후: 이번 스텝에 움직인 엔티티의 소유 영역/고스트 갱신
+	// 판정(포즈 읽기)은 청크 병렬, 씬 변경은 호출 스레드에서 (움직이지 않은 엔티티는 바뀔 것이 없다)
+	void updateRegions()
+	{
+		handoffsThisTick_ = 0;
+		regionCandidates_.clear();
+		activeDummies_.clear();
+		for (PxScene* scene : scenes_)
+		{
+			PxU32 count = 0;
+			PxActor** actors = scene->getActiveActors(count);
+			for (PxU32 i = 0; i < count; ++i)
+			{
+				uint32_t tag = actorTagValue(actors[i]);
+				ActorKind kind = actorTagKind(tag);
+				if (kind != ActorKind::DUMMY && kind != ActorKind::PLAYER)
+					continue; // 고스트는 주인을 따라갈 뿐
+
+				PxRigidDynamic* actor = static_cast<PxRigidDynamic*>(actors[i]);
+				if (kind == ActorKind::DUMMY)
+					activeDummies_.emplace_back(actor, actorTagId(tag));
+				RegionCandidate candidate;
+				candidate.actor = actor;
+				candidate.tag = tag;
+				regionCandidates_.push_back(candidate);
+			}
+		}
+
+		parallelFor(taskPool_, regionCandidates_.size(), REGION_GRAIN, [this](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					RegionCandidate& candidate = regionCandidates_[i];
+					candidate.pose = candidate.actor->getGlobalPose();
+					candidate.current = entityRegion(candidate.tag);
+					candidate.owner = planRegions(candidate.current, candidate.pose.p, candidate.wanted, candidate.wantedCount);
+					candidate.apply = candidate.owner != candidate.current || candidate.wantedCount > 0
+						|| ghosts_.count(candidate.tag) != 0;
+				}
+			});
+
+		for (const RegionCandidate& candidate : regionCandidates_)
+		{
+			if (!candidate.apply)
+				continue;
+			if (candidate.owner != candidate.current)
+				handOff(candidate.actor, candidate.tag, candidate.current, candidate.owner);
+			syncGhosts(candidate.tag, candidate.pose, candidate.wanted, candidate.wantedCount);
+		}
+	}
+
+	// 같은 액터를 다른 영역 씬으로 옮긴다
+	void handOff(PxRigidDynamic* actor, uint32_t tag, uint32_t from, uint32_t to)
+	{
+		// 옛 씬의 접촉은 통지 없이 끊긴다: 쌍 키만 지우고 받침 수는 넘겨서, 새 씬의 TOUCH_FOUND를 새 착지로 치지 않는다
+		carrySupportPairs(tag);
+		scenes_[from]->removeActor(*actor);
+
+		// 들어갈 씬에 있던 자기 고스트는 먼저 치운다 (주인과 겹치지 않도록)
+		auto it = ghosts_.find(tag);
+		if (it != ghosts_.end())
+		{
+			GhostSet& set = it->second;
+			for (uint32_t i = 0; i < set.count; ++i)
+			{
+				if (set.ghosts[i].region == to)
+				{
+					// 고스트 위의 더미는 곧 같은 자리의 주인 액터 위로 다시 잡힌다
+					carrySupportPairs(actorTagValue(set.ghosts[i].actor), to);
+					releaseGhost(set.ghosts[i]);
+					set.ghosts[i] = set.ghosts[--set.count];
+					break;
+				}
+			}
+		}
+
+		scenes_[to]->addActor(*actor);
+		setEntityRegion(tag, to);
+		handoffsThisTick_++;
+		handoffsTotal_++;
+	}
+
+	// 엔티티의 고스트를 wanted 영역에 맞춘다: 필요 없어진 것은 해제, 있는 것은 주인 포즈로, 없는 것은 새로
+	void syncGhosts(uint32_t tag, const PxTransform& pose, const uint32_t* wanted, uint32_t wantedCount)
+	{
+		auto it = ghosts_.find(tag);
+		if (it == ghosts_.end())
+		{
+			if (wantedCount == 0)
+				return;
+			it = ghosts_.emplace(tag, GhostSet()).first;
+		}
+
+		GhostSet& set = it->second;
+		for (uint32_t i = set.count; i-- > 0;)
+		{
+			if (std::find(wanted, wanted + wantedCount, set.ghosts[i].region) == wanted + wantedCount)
+			{
+				releaseGhost(set.ghosts[i]);
+				set.ghosts[i] = set.ghosts[--set.count];
+			}
+		}
+		for (uint32_t w = 0; w < wantedCount; ++w)
+		{
+			RegionGhost* existing = nullptr;
+			for (uint32_t i = 0; i < set.count; ++i)
+			{
+				if (set.ghosts[i].region == wanted[w])
+					existing = &set.ghosts[i];
+			}
+			if (existing)
+				existing->actor->setKinematicTarget(pose);
+			else if (set.count < 4)
+				set.ghosts[set.count++] = createGhost(tag, wanted[w], pose);
+		}
+		if (set.count == 0)
+			ghosts_.erase(it);
+	}
+
+	RegionGhost createGhost(uint32_t ownerTag, uint32_t region, const PxTransform& pose)
+	{
+		PxRigidDynamic* actor = physics_->createRigidDynamic(pose);
+		actor->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, true);
+		actor->attachShape(*ghostShape_);
+		actor->userData = makeGhostTag(ownerTag);
+		scenes_[region]->addActor(*actor);
+		ghostCount_++;
+		return RegionGhost{ region, actor };
+	}
+
+	void releaseGhost(const RegionGhost& ghost)
+	{
+		purgeSupportPairs(ghost.actor->userData, ghost.region);
+		ghost.actor->release();
+		ghostCount_--;
+	}
+
+	void releaseGhosts(uint32_t ownerTag)
+	{
+		auto it = ghosts_.find(ownerTag);
+		if (it == ghosts_.end())
+			return;
+		for (uint32_t i = 0; i < it->second.count; ++i)
+			releaseGhost(it->second.ghosts[i]);
+		ghosts_.erase(it);
+	}
+
+	void applyRewindPose(PxRigidDynamic* actor, const PxTransform& pose, const PxVec3* center, float radius)
+	{
+		if (center)
+		{
+			PxVec3 d(pose.p.x - center->x, pose.p.y - center->y, pose.p.z - center->z);
+			if (d.x * d.x + d.y * d.y + d.z * d.z > radius * radius)
+				return;
+		}
+		rewound_.emplace_back(actor, actor->getGlobalPose());
+		actor->setGlobalPose(pose, false);
 	}
 };
\ No newline at end of file
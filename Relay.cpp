@@ -0,0 +1,598 @@
+// 관전 릴레이: GameServer에 관전자 하나로 붙어서 받은 스냅샷을 많은 관전자에게 다시 나눠준다
+// 사용법: Relay [--port=9010] [--upstream=127.0.0.1:9002] [--io-threads=0] [--max-spectators=100000]
+//              [--max-write-stall-ms=10000] [--log-level=info]
+// 관전자 프로토콜은 GameServer와 같다: SPECTATE_REQUEST(9) -> SPECTATE_RESPONSE(10) -> GAME_STATE(4)...
+// 릴레이끼리 이어 붙일 수도 있다 (upstream을 다른 릴레이로)
+//
+// - 게임 서버 입장에서는 관전자 하나 -> 관전자 수가 늘어도 틱 스레드 비용은 그대로
+// - 샤드(io_context + 스레드)마다 자기 관전자 목록을 갖고, 새 스냅샷은 샤드마다 한 번씩 post
+// - 관전자마다 최신 스냅샷 하나만 들고 있다 (느린 관전자는 중간 프레임을 건너뛴다, 큐가 자라지 않음)
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/websocket.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ClientMessage.h"
+#include "Logger.h"
+#include "ServerConfig.h"
+
+using namespace std;
+
+namespace beast = boost::beast;
+namespace websocket = beast::websocket;
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+
+struct RelayConfig
+{
+	int port = 9010;
+	string upstream = "127.0.0.1:9002";
+	int ioThreads = 0;           // 0이면 hardware_concurrency
+	int maxSpectators = 100000;
+	int maxWriteStallMs = 10000; // 쓰기 하나가 이보다 오래 안 끝나면 끊는다
+	string logLevel = "info";
+};
+
+static RelayConfig parseRelayConfig(int argc, char *argv[])
+{
+	RelayConfig config;
+	for (int i = 1; i < argc; ++i)
+	{
+		const char *value = nullptr;
+		if (matchArg(argv[i], "--port", value))
+			config.port = atoi(value);
+		else if (matchArg(argv[i], "--upstream", value))
+			config.upstream = value;
+		else if (matchArg(argv[i], "--io-threads", value))
+			config.ioThreads = atoi(value);
+		else if (matchArg(argv[i], "--max-spectators", value))
+			config.maxSpectators = atoi(value);
+		else if (matchArg(argv[i], "--max-write-stall-ms", value))
+			config.maxWriteStallMs = atoi(value);
+		else if (matchArg(argv[i], "--log-level", value))
+			config.logLevel = value;
+		else
+			cerr << "Unknown option: " << argv[i] << endl;
+	}
+	return config;
+}
+
+struct RelayStats
+{
+	atomic<int> spectators{ 0 };
+	atomic<long long> rejected{ 0 };
+	atomic<long long> framesIn{ 0 };
+	atomic<long long> framesOut{ 0 };
+	atomic<long long> framesSkipped{ 0 }; // 느린 관전자가 건너뛴 프레임
+	atomic<long long> bytesOut{ 0 };
+	atomic<long long> stalled{ 0 };       // 쓰기 정체로 끊은 관전자
+};
+
+class RelayHub;
+
+// 관전자 연결 하나 (자기 샤드 스레드에서만 접근)
+class Spectator : public enable_shared_from_this<Spectator>
+{
+private:
+	websocket::stream<tcp::socket> ws_;
+	beast::flat_buffer buffer_;
+	RelayHub &hub_;
+	RelayStats &stats_;
+	int shardIndex_;
+
+	bool subscribed_ = false;
+	bool alive_ = true;
+	bool writing_ = false;
+	string response_;
+	shared_ptr<const string> current_; // 보내는 중
+	shared_ptr<const string> latest_;  // 다음에 보낼 최신 스냅샷
+	chrono::steady_clock::time_point writeStart_;
+
+public:
+	Spectator(tcp::socket socket, RelayHub &hub, RelayStats &stats, int shardIndex)
+		: ws_(move(socket)), hub_(hub), stats_(stats), shardIndex_(shardIndex)
+	{
+	}
+
+	bool alive() const { return alive_; }
+	bool subscribed() const { return subscribed_; }
+
+	void start()
+	{
+		beast::error_code ec;
+		ws_.next_layer().set_option(tcp::no_delay(true), ec);
+		ws_.set_option(websocket::stream_base::timeout::suggested(beast::role_type::server));
+		ws_.async_accept([self = shared_from_this()](beast::error_code ec)
+			{
+				if (ec)
+					return self->close();
+				self->doRead();
+			});
+	}
+
+	// 새 스냅샷 (샤드 스레드): 쓰는 중이면 최신 것만 남긴다
+	void publish(const shared_ptr<const string> &message)
+	{
+		if (!alive_ || !subscribed_)
+			return;
+		if (writing_)
+		{
+			if (latest_)
+				stats_.framesSkipped.fetch_add(1, memory_order_relaxed);
+			latest_ = message;
+			return;
+		}
+		write(message);
+	}
+
+	// 쓰기 정체 검사 (샤드 스레드, 주기적으로)
+	void checkStall(chrono::steady_clock::time_point now, chrono::milliseconds limit)
+	{
+		if (alive_ && writing_ && limit.count() > 0 && now - writeStart_ > limit)
+		{
+			stats_.stalled.fetch_add(1, memory_order_relaxed);
+			beast::error_code ec;
+			ws_.next_layer().close(ec);
+			close();
+		}
+	}
+
+private:
+	// 관전 요청 외의 메시지는 무시 (연결 종료 감지용으로 계속 읽는다)
+	void doRead()
+	{
+		ws_.async_read(buffer_, [self = shared_from_this()](beast::error_code ec, size_t)
+			{
+				if (ec)
+					return self->close();
+
+				if (!self->subscribed_)
+				{
+					// 닉네임 같은 문자열이 있으면 스캐너가 거절하므로 그때만 DOM으로
+					auto data = self->buffer_.data();
+					boost::string_view text(static_cast<const char *>(data.data()), data.size());
+					ClientMessage message;
+					if (!scanClientMessage(text, message))
+					{
+						message = ClientMessage();
+						nlohmann::json parsed = nlohmann::json::parse(text.begin(), text.end(), nullptr, false);
+						if (parsed.is_object())
+							readClientMessage(parsed, message);
+					}
+					if (message.type != 9)
+					{
+						LOG_EVERY_MS(LogLevel::WARN, 1000) << "Relay expected SPECTATE_REQUEST";
+						return self->close();
+					}
+					self->subscribe();
+				}
+				self->buffer_.consume(self->buffer_.size());
+				self->doRead();
+			});
+	}
+
+	void subscribe();
+
+	void write(shared_ptr<const string> message)
+	{
+		writing_ = true;
+		writeStart_ = chrono::steady_clock::now();
+		current_ = move(message);
+		ws_.text(true);
+		ws_.async_write(net::buffer(*current_), [self = shared_from_this()](beast::error_code ec, size_t bytes)
+			{
+				self->writing_ = false;
+				self->current_.reset();
+				if (ec)
+					return self->close();
+
+				self->stats_.framesOut.fetch_add(1, memory_order_relaxed);
+				self->stats_.bytesOut.fetch_add(static_cast<long long>(bytes), memory_order_relaxed);
+				if (self->latest_)
+					self->write(move(self->latest_));
+			});
+	}
+
+	void close();
+
+	friend class RelayHub;
+	void sendResponse(bool success, const shared_ptr<const string> &latest);
+};
+
+// 관전자 샤드들 + 업스트림 스냅샷 배포
+class RelayHub
+{
+private:
+	struct Shard
+	{
+		net::io_context ioc{ 1 };
+		vector<shared_ptr<Spectator>> spectators; // 샤드 스레드에서만
+		net::steady_timer stallTimer{ ioc };
+		thread worker;
+	};
+
+	const RelayConfig &config_;
+	RelayStats &stats_;
+	vector<unique_ptr<Shard>> shards_;
+	tcp::acceptor acceptor_;
+	int nextShard_ = 0;
+
+	mutex latestMutex_;
+	shared_ptr<const string> latest_; // 새 관전자에게 바로 줄 마지막 스냅샷
+
+public:
+	RelayHub(const RelayConfig &config, RelayStats &stats)
+		: config_(config), stats_(stats), shards_(createShards(config)), acceptor_(shards_[0]->ioc)
+	{
+		tcp::endpoint endpoint(tcp::v4(), static_cast<unsigned short>(config.port));
+		acceptor_.open(endpoint.protocol());
+		acceptor_.set_option(net::socket_base::reuse_address(true));
+		acceptor_.bind(endpoint);
+		acceptor_.listen(net::socket_base::max_listen_connections);
+	}
+
+	net::io_context &upstreamContext() { return shards_[0]->ioc; }
+	size_t shardCount() const { return shards_.size(); }
+
+	void start()
+	{
+		doAccept();
+		for (auto &shard : shards_)
+			scheduleStallCheck(shard.get());
+	}
+
+	// 업스트림 스레드(0번 샤드)에서 호출: 샤드마다 한 번씩 post
+	void publish(shared_ptr<const string> message)
+	{
+		stats_.framesIn.fetch_add(1, memory_order_relaxed);
+		{
+			lock_guard<mutex> lock(latestMutex_);
+			latest_ = message;
+		}
+		for (auto &shard : shards_)
+		{
+			net::post(shard->ioc, [shard = shard.get(), message]()
+				{
+					for (auto &spectator : shard->spectators)
+						spectator->publish(message);
+				});
+		}
+	}
+
+	shared_ptr<const string> latest()
+	{
+		lock_guard<mutex> lock(latestMutex_);
+		return latest_;
+	}
+
+	// 관전자 자리 (상한이면 false)
+	bool addSpectator()
+	{
+		int count = stats_.spectators.load();
+		do
+		{
+			if (count >= config_.maxSpectators)
+				return false;
+		} while (!stats_.spectators.compare_exchange_weak(count, count + 1));
+		return true;
+	}
+
+	void onSpectatorClosed(int shardIndex, Spectator *spectator)
+	{
+		auto &list = shards_[shardIndex]->spectators;
+		auto it = find_if(list.begin(), list.end(),
+			[spectator](const shared_ptr<Spectator> &item) { return item.get() == spectator; });
+		if (it != list.end())
+		{
+			if ((*it)->subscribed())
+				stats_.spectators--;
+			*it = move(list.back());
+			list.pop_back();
+		}
+	}
+
+	void run()
+	{
+		for (size_t i = 1; i < shards_.size(); ++i)
+		{
+			Shard *shard = shards_[i].get();
+			shard->worker = thread([shard] { shard->ioc.run(); });
+		}
+		shards_[0]->ioc.run();
+		for (size_t i = 1; i < shards_.size(); ++i)
+		{
+			if (shards_[i]->worker.joinable())
+				shards_[i]->worker.join();
+		}
+	}
+
+	void stop()
+	{
+		for (auto &shard : shards_)
+			shard->ioc.stop();
+	}
+
+private:
+	static vector<unique_ptr<Shard>> createShards(const RelayConfig &config)
+	{
+		int count = config.ioThreads > 0
+			? config.ioThreads
+			: std::max<int>(1, std::thread::hardware_concurrency());
+		vector<unique_ptr<Shard>> shards;
+		for (int i = 0; i < count; ++i)
+			shards.push_back(make_unique<Shard>());
+		return shards;
+	}
+
+	void doAccept()
+	{
+		// 라운드로빈으로 샤드 배정, 소켓은 처음부터 그 샤드의 io_context에
+		int shardIndex = nextShard_;
+		nextShard_ = (nextShard_ + 1) % static_cast<int>(shards_.size());
+		acceptor_.async_accept(shards_[shardIndex]->ioc,
+			[this, shardIndex](beast::error_code ec, tcp::socket socket)
+			{
+				if (ec == net::error::operation_aborted)
+					return;
+				if (!ec)
+				{
+					Shard *shard = shards_[shardIndex].get();
+					net::post(shard->ioc, [this, shard, shardIndex, socket = move(socket)]() mutable
+						{
+							auto spectator = make_shared<Spectator>(move(socket), *this, stats_, shardIndex);
+							shard->spectators.push_back(spectator);
+							spectator->start();
+						});
+				}
+				else
+				{
+					LOG_EVERY_MS(LogLevel::WARN, 1000) << "Relay accept failed: " << ec.message();
+				}
+				doAccept();
+			});
+	}
+
+	void scheduleStallCheck(Shard *shard)
+	{
+		shard->stallTimer.expires_after(chrono::seconds(1));
+		shard->stallTimer.async_wait([this, shard](beast::error_code ec)
+			{
+				if (ec)
+					return;
+				auto now = chrono::steady_clock::now();
+				chrono::milliseconds limit(config_.maxWriteStallMs);
+				// checkStall이 목록을 바꿀 수 있으므로 복사본으로 돈다
+				vector<shared_ptr<Spectator>> spectators = shard->spectators;
+				for (auto &spectator : spectators)
+					spectator->checkStall(now, limit);
+				scheduleStallCheck(shard);
+			});
+	}
+};
+
+void Spectator::subscribe()
+{
+	if (!hub_.addSpectator())
+	{
+		stats_.rejected.fetch_add(1, memory_order_relaxed);
+		sendResponse(false, nullptr);
+		return;
+	}
+	subscribed_ = true;
+	sendResponse(true, hub_.latest());
+}
+
+// SPECTATE_RESPONSE 다음에 마지막 스냅샷 (있으면)
+void Spectator::sendResponse(bool success, const shared_ptr<const string> &latest)
+{
+	response_ = success
+		? "{\"relay\":true,\"success\":true,\"type\":10}"
+		: "{\"message\":\"Spectator limit reached\",\"success\":false,\"type\":10}";
+	writing_ = true;
+	writeStart_ = chrono::steady_clock::now();
+	ws_.text(true);
+	ws_.async_write(net::buffer(response_), [self = shared_from_this(), success, latest](beast::error_code ec, size_t)
+		{
+			self->writing_ = false;
+			if (ec || !success)
+				return self->close();
+
+			// 응답을 쓰는 동안 온 스냅샷이 있으면 그것이 더 새롭다
+			if (self->latest_)
+				self->write(move(self->latest_));
+			else if (latest)
+				self->write(latest);
+		});
+}
+
+void Spectator::close()
+{
+	if (!alive_)
+		return;
+	alive_ = false;
+	beast::error_code ec;
+	ws_.next_layer().close(ec);
+	hub_.onSpectatorClosed(shardIndex_, this);
+}
+
+// 게임 서버 쪽 연결 (관전자 하나), 끊기면 다시 붙는다
+class Upstream : public enable_shared_from_this<Upstream>
+{
+private:
+	net::io_context &ioc_;
+	tcp::endpoint endpoint_;
+	string host_;
+	RelayHub &hub_;
+	unique_ptr<websocket::stream<tcp::socket>> ws_;
+	beast::flat_buffer buffer_;
+	net::steady_timer retryTimer_;
+	string request_ = "{\"type\":9,\"nickname\":\"relay\"}";
+	bool subscribed_ = false;
+	atomic<bool> connected_{ false };
+
+	const chrono::seconds RETRY_DELAY{ 2 };
+
+public:
+	Upstream(net::io_context &ioc, const string &upstream, RelayHub &hub)
+		: ioc_(ioc), hub_(hub), retryTimer_(ioc)
+	{
+		size_t colon = upstream.rfind(':');
+		if (colon == string::npos)
+			throw runtime_error("upstream must be host:port: " + upstream);
+		host_ = upstream.substr(0, colon);
+		endpoint_ = tcp::endpoint(net::ip::make_address(host_), static_cast<unsigned short>(stoi(upstream.substr(colon + 1))));
+	}
+
+	bool connected() const { return connected_; }
+
+	void start()
+	{
+		subscribed_ = false;
+		buffer_.consume(buffer_.size());
+		ws_ = make_unique<websocket::stream<tcp::socket>>(ioc_);
+		ws_->read_message_max(64 * 1024 * 1024);
+		ws_->next_layer().async_connect(endpoint_, [self = shared_from_this()](beast::error_code ec)
+			{
+				if (ec)
+					return self->retry(ec);
+				beast::error_code ignored;
+				self->ws_->next_layer().set_option(tcp::no_delay(true), ignored);
+				self->ws_->async_handshake(self->host_, "/", [self](beast::error_code ec)
+					{
+						if (ec)
+							return self->retry(ec);
+						self->ws_->text(true);
+						self->ws_->async_write(net::buffer(self->request_), [self](beast::error_code ec, size_t)
+							{
+								if (ec)
+									return self->retry(ec);
+								self->doRead();
+							});
+					});
+			});
+	}
+
+private:
+	void doRead()
+	{
+		ws_->async_read(buffer_, [self = shared_from_this()](beast::error_code ec, size_t)
+			{
+				if (ec)
+					return self->retry(ec);
+
+				auto data = self->buffer_.data();
+				if (!self->subscribed_)
+				{
+					// 첫 메시지는 SPECTATE_RESPONSE
+					string response = beast::buffers_to_string(data);
+					if (response.find("\"success\":true") == string::npos)
+					{
+						LOG_WARN << "Upstream refused spectator: " << response;
+						return self->retry(beast::error_code());
+					}
+					self->subscribed_ = true;
+					self->connected_ = true;
+					LOG_INFO << "Relay subscribed to " << self->host_ << ":" << self->endpoint_.port();
+				}
+				else
+				{
+					// 그대로 나눠준다 (파싱하지 않음)
+					self->hub_.publish(make_shared<const string>(static_cast<const char *>(data.data()), data.size()));
+				}
+				self->buffer_.consume(self->buffer_.size());
+				self->doRead();
+			});
+	}
+
+	void retry(beast::error_code ec)
+	{
+		if (connected_.exchange(false) || ec)
+		{
+			LOG_EVERY_MS(LogLevel::WARN, 5000) << "Upstream " << host_ << ":" << endpoint_.port()
+				<< " lost" << (ec ? ": " + ec.message() : string()) << ", retrying";
+		}
+		beast::error_code ignored;
+		ws_->next_layer().close(ignored);
+		retryTimer_.expires_after(RETRY_DELAY);
+		retryTimer_.async_wait([self = shared_from_this()](beast::error_code ec)
+			{
+				if (!ec)
+					self->start();
+			});
+	}
+};
+
+int main(int argc, char *argv[])
+{
+	RelayConfig config = parseRelayConfig(argc, argv);
+
+	LogLevel logLevel;
+	if (!Logger::parseLevel(config.logLevel, logLevel))
+	{
+		cerr << "Unknown log level: " << config.logLevel << endl;
+		return 1;
+	}
+	Logger::instance().setLevel(logLevel);
+
+	try
+	{
+		RelayStats stats;
+		RelayHub hub(config, stats);
+		auto upstream = make_shared<Upstream>(hub.upstreamContext(), config.upstream, hub);
+
+		hub.start();
+		upstream->start();
+		LOG_INFO << "Relay on port " << config.port << " (" << hub.shardCount() << " shards), upstream " << config.upstream;
+
+		net::signal_set signals(hub.upstreamContext(), SIGINT, SIGTERM);
+		signals.async_wait([&hub](beast::error_code, int) { hub.stop(); });
+
+		// 상태 출력 (5초마다)
+		net::steady_timer statusTimer(hub.upstreamContext());
+		long long lastOut = 0, lastBytes = 0;
+		function<void()> printStatus = [&]()
+		{
+			statusTimer.expires_after(chrono::seconds(5));
+			statusTimer.async_wait([&](beast::error_code ec)
+				{
+					if (ec)
+						return;
+					long long out = stats.framesOut, bytes = stats.bytesOut;
+					cout << "=== Relay Status ===" << endl;
+					cout << "Upstream: " << (upstream->connected() ? "connected" : "disconnected")
+						<< "  Frames in: " << stats.framesIn << endl;
+					cout << "Spectators: " << stats.spectators << " / " << config.maxSpectators
+						<< "  Rejected: " << stats.rejected << "  Stalled: " << stats.stalled << endl;
+					cout << "Frames out/s: " << (out - lastOut) / 5
+						<< "  Skipped: " << stats.framesSkipped
+						<< "  Out: " << fixed << setprecision(1) << ((bytes - lastBytes) / 5.0 / 1048576.0) << " MB/s" << endl;
+					lastOut = out;
+					lastBytes = bytes;
+					printStatus();
+				});
+		};
+		printStatus();
+
+		hub.run();
+		LOG_INFO << "Relay stopped";
+	}
+	catch (const exception &e)
+	{
+		LOG_ERROR << "Relay error: " << e.what();
+		Logger::instance().stop();
+		return 1;
+	}
+	Logger::instance().stop();
+	return 0;
+}
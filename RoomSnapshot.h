@@ -0,0 +1,145 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// 방 스냅샷 파일 레이아웃
+// [RoomSnapshotHeader][더미 id 테이블 int32 x dummyCount][패딩][PhysX 바이너리 컬렉션]
+// - PhysX 바이너리는 128바이트(PX_SERIAL_FILE_ALIGN) 정렬이 필요해서 오프셋을 정렬해 둔다
+// - 매핑 시작 주소는 페이지 정렬이므로 파일 오프셋만 맞추면 메모리에서도 정렬된다
+// - checksum: 헤더 뒤 전체(테이블 + 패딩 + PhysX)의 FNV-1a 64 (PhysX 역직렬화는 내용을 검사하지 않으므로 손상된 파일을 미리 거른다)
+struct RoomSnapshotHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t dummyCount;
+	int32_t nextDummyId;
+	uint32_t physxOffset;
+	uint64_t physxSize;
+	uint64_t checksum;
+
+	static const uint32_t VERSION = 2;
+	static const uint32_t PHYSX_ALIGN = 128;
+
+	static const char *expectedMagic() { return "ROOMSNAP"; }
+
+	bool valid(size_t fileSize) const
+	{
+		return memcmp(magic, expectedMagic(), sizeof(magic)) == 0
+			&& version == VERSION
+			&& physxOffset % PHYSX_ALIGN == 0
+			&& sizeof(RoomSnapshotHeader) + static_cast<uint64_t>(dummyCount) * sizeof(int32_t) <= physxOffset
+			&& static_cast<uint64_t>(physxOffset) + physxSize <= fileSize;
+	}
+
+	// data: 파일 시작 (valid 통과 후, 역직렬화가 제자리에서 고치기 전에)
+	static uint64_t computeChecksum(const char *data, size_t begin, size_t end)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (size_t i = begin; i < end; ++i)
+		{
+			hash ^= static_cast<unsigned char>(data[i]);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+};
+
+// 스냅샷 파일을 쓰기 가능한 사본으로 매핑 (PhysX가 역직렬화 중 포인터를 제자리에서 고친다)
+// - Linux/macOS: mmap(MAP_PRIVATE), 고친 페이지만 복사되고 나머지는 페이지 캐시를 공유
+// - Windows: 정렬된 버퍼로 한 번에 읽는다
+// 역직렬화한 액터가 살아 있는 동안 해제하면 안 된다
+class MappedFile
+{
+private:
+	char *data_ = nullptr;
+	size_t size_ = 0;
+
+	MappedFile() = default;
+
+public:
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	~MappedFile()
+	{
+		if (!data_)
+			return;
+#ifdef _WIN32
+		_aligned_free(data_);
+#else
+		munmap(data_, size_);
+#endif
+	}
+
+	static unique_ptr<MappedFile> open(const string &path)
+	{
+		unique_ptr<MappedFile> file(new MappedFile());
+#ifdef _WIN32
+		ifstream in(path, ios::binary | ios::ate);
+		if (!in)
+			return nullptr;
+		file->size_ = static_cast<size_t>(in.tellg());
+		if (file->size_ == 0)
+			return nullptr;
+		file->data_ = static_cast<char *>(_aligned_malloc(file->size_, 4096));
+		in.seekg(0);
+		if (!file->data_ || !in.read(file->data_, file->size_))
+			return nullptr;
+#else
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return nullptr;
+
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size == 0)
+		{
+			::close(fd);
+			return nullptr;
+		}
+		file->size_ = static_cast<size_t>(st.st_size);
+
+		int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+		flags |= MAP_POPULATE; // 어차피 전부 읽으므로 미리 올린다
+#endif
+		void *mapped = mmap(nullptr, file->size_, PROT_READ | PROT_WRITE, flags, fd, 0);
+		::close(fd);
+		if (mapped == MAP_FAILED)
+			return nullptr;
+		file->data_ = static_cast<char *>(mapped);
+#endif
+		return file;
+	}
+
+	char *data() { return data_; }
+	size_t size() const { return size_; }
+};
+
+// 임시 파일에 다 쓴 뒤 이름을 바꿔서, 쓰는 도중 죽어도 이전 스냅샷이 남도록
+inline bool writeFileAtomically(const string &path, const string &data)
+{
+	string temp = path + ".tmp";
+	{
+		ofstream out(temp, ios::binary | ios::trunc);
+		if (!out.write(data.data(), data.size()) || !out.flush())
+			return false;
+	}
+#ifdef _WIN32
+	remove(path.c_str()); // Windows rename은 대상이 있으면 실패
+#endif
+	return rename(temp.c_str(), path.c_str()) == 0;
+}
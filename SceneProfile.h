@@ -0,0 +1,108 @@
+#pragma once
+#include <PxPhysicsAPI.h>
+#include <string>
+#include <vector>
+
+using namespace physx;
+using namespace std;
+
+// PhysX 씬 튜닝 프로필
+// 시작 시 --scene-profile=이름 으로 고르고, 월드(방)마다 다른 프로필로 만들 수 있다
+struct SceneProfile
+{
+	string name;
+	string description;
+
+	// false면 PxSceneDesc 기본값 그대로 (튜닝 전 기준선)
+	bool overrideScene = true;
+
+	PxBroadPhaseType::Enum broadPhase = PxBroadPhaseType::eABP;
+	PxU32 mbpSubdivisions = 4; // MBP 영역 분할 (맵 경계를 N x N으로)
+	PxSolverType::Enum solver = PxSolverType::ePGS;
+
+	// 솔버 반복 횟수 (위치, 속도) - 플레이어는 정확도, 더미는 비용 우선
+	PxU32 playerPositionIterations = 4;
+	PxU32 playerVelocityIterations = 1;
+	PxU32 dummyPositionIterations = 4;
+	PxU32 dummyVelocityIterations = 1;
+
+	// 씬 플래그
+	bool pcm = true;            // 지속 접촉 매니폴드
+	bool stabilization = false; // 더미가 쌓일 때 떨림 억제
+
+	// 기본 재질
+	float staticFriction = 0.6f;
+	float dynamicFriction = 0.5f;
+	float restitution = 0.5f;
+
+	PxU32 dispatcherThreads = 2;
+};
+
+inline const vector<SceneProfile> &sceneProfiles()
+{
+	static const vector<SceneProfile> profiles = [] {
+		vector<SceneProfile> list;
+
+		SceneProfile baseline;
+		baseline.name = "default";
+		baseline.description = "PxSceneDesc defaults (pre-tuning baseline)";
+		baseline.overrideScene = false;
+		list.push_back(baseline);
+
+		SceneProfile sap;
+		sap.name = "sap";
+		sap.description = "SAP broadphase, PGS, 4/1 everywhere";
+		sap.broadPhase = PxBroadPhaseType::eSAP;
+		list.push_back(sap);
+
+		SceneProfile mbp;
+		mbp.name = "mbp";
+		mbp.description = "MBP over map bounds, PGS, dummies 2/1";
+		mbp.broadPhase = PxBroadPhaseType::eMBP;
+		mbp.dummyPositionIterations = 2;
+		list.push_back(mbp);
+
+		SceneProfile abp;
+		abp.name = "abp";
+		abp.description = "ABP, PGS, dummies 2/1";
+		abp.broadPhase = PxBroadPhaseType::eABP;
+		abp.dummyPositionIterations = 2;
+		list.push_back(abp);
+
+		SceneProfile tgs;
+		tgs.name = "tgs";
+		tgs.description = "ABP, TGS solver, dummies 2/1";
+		tgs.broadPhase = PxBroadPhaseType::eABP;
+		tgs.solver = PxSolverType::eTGS;
+		tgs.dummyPositionIterations = 2;
+		list.push_back(tgs);
+
+		SceneProfile crowd;
+		crowd.name = "crowd";
+		crowd.description = "Parallel ABP, PGS, dummies 1/1, stabilization, 4 threads";
+		crowd.broadPhase = PxBroadPhaseType::ePABP;
+		crowd.dummyPositionIterations = 1;
+		crowd.stabilization = true;
+		crowd.dispatcherThreads = 4;
+		list.push_back(crowd);
+
+		return list;
+	}();
+	return profiles;
+}
+
+// 이름으로 찾기 (없으면 nullptr)
+inline const SceneProfile *findSceneProfile(const string &name)
+{
+	for (const auto &profile : sceneProfiles())
+	{
+		if (profile.name == name)
+			return &profile;
+	}
+	return nullptr;
+}
+
+inline const SceneProfile &defaultSceneProfile()
+{
+	return sceneProfiles().front();
+}
@@ -0,0 +1,354 @@
+#pragma once
+#include <PxPhysicsAPI.h>
+#include <extensions/PxBatchQueryExt.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+using namespace physx;
+using namespace std;
+
+struct SceneQueryHit
+{
+	const PxRigidActor* actor = nullptr;
+	PxVec3 position = PxVec3(0.0f);
+	PxVec3 normal = PxVec3(0.0f); // 오버랩은 없음
+	float distance = 0.0f;
+};
+
+// 틱당 한 번 실행하는 배치 씬 쿼리 (PxBatchQueryExt)
+// - 틱 동안 레이캐스트/스윕/오버랩 요청을 모아 두었다가 fetchResults 뒤에 한꺼번에 실행
+// - 결과는 바로 복사해 두고 (쿼리 버퍼는 다음 execute에서 재사용됨) 다음 틱 시작 때 콜백으로 넘긴다
+// - 모든 히트를 touch로 받아서 ignore 액터(쿼리 주체 자신)를 빼고,
+//   레이캐스트/스윕은 가장 가까운 히트 하나, 오버랩은 전부 넘긴다
+// - 씬이 여럿이면 (영역 격자) 요청 위치로 씬을 고르고, 고스트 히트는 주인 액터로 바꿔서 넘긴다
+class SceneQueryBatch
+{
+public:
+	using ResultHandler = function<void(const SceneQueryHit* hits, size_t count)>;
+	using SceneRouter = function<uint32_t(const PxVec3& position)>;                // 위치 -> 씬 인덱스
+	using ActorResolver = function<const PxRigidActor*(const PxRigidActor* actor)>; // 고스트 -> 주인
+
+	static const PxU16 CAST_TOUCHES = 8;     // 레이캐스트/스윕 하나당 (자기 자신 포함)
+	static const PxU16 OVERLAP_TOUCHES = 32; // 오버랩 하나당
+
+private:
+	enum class QueryType : uint8_t
+	{
+		RAYCAST,
+		SWEEP,
+		OVERLAP,
+	};
+
+	struct Request
+	{
+		QueryType type;
+		PxGeometryHolder geometry; // 스윕/오버랩
+		PxTransform pose;          // 레이캐스트는 p만 원점으로 사용
+		PxVec3 direction;
+		float distance;
+		const PxRigidActor* ignore;
+		ResultHandler onResult;
+	};
+
+	struct Completed
+	{
+		ResultHandler onResult;
+		uint32_t firstHit;
+		uint32_t hitCount;
+	};
+
+	// 씬마다 배치 하나 (PxBatchQueryExt는 만들 때 씬이 정해진다)
+	struct SceneBatch
+	{
+		PxBatchQueryExt* batch = nullptr;
+		PxU32 raycastCapacity = 0;
+		PxU32 sweepCapacity = 0;
+		PxU32 overlapCapacity = 0;
+		PxU32 raycasts = 0; // 이번 execute 요청 수
+		PxU32 sweeps = 0;
+		PxU32 overlaps = 0;
+	};
+
+	vector<SceneBatch> batches_;
+	SceneRouter router_;
+	ActorResolver resolver_;
+
+	vector<Request> requests_;
+	vector<uint32_t> requestScenes_; // 요청별 씬 인덱스
+	vector<const void*> buffers_; // 요청별 PxRaycastBuffer/PxSweepBuffer/PxOverlapBuffer
+
+	// 실행된 결과 (다음 틱 dispatchResults까지 보관)
+	vector<Completed> completed_;
+	vector<SceneQueryHit> hits_;
+
+	float lastExecuteMicros_ = 0.0f;
+	uint32_t lastQueryCount_ = 0;
+
+public:
+	SceneQueryBatch() = default;
+	SceneQueryBatch(const SceneQueryBatch&) = delete;
+	SceneQueryBatch& operator=(const SceneQueryBatch&) = delete;
+
+	~SceneQueryBatch()
+	{
+		release();
+	}
+
+	// 씬보다 먼저 해제해야 한다
+	void release()
+	{
+		for (SceneBatch& sceneBatch : batches_)
+		{
+			if (sceneBatch.batch)
+				sceneBatch.batch->release();
+		}
+		batches_.clear();
+		requests_.clear();
+		completed_.clear();
+		hits_.clear();
+	}
+
+	// ---- 요청 (틱 사이 아무 때나, 월드 잠금 안에서) ----
+
+	void raycast(const PxVec3& origin, const PxVec3& unitDir, float distance, ResultHandler onResult, const PxRigidActor* ignore = nullptr)
+	{
+		requests_.push_back({ QueryType::RAYCAST, PxGeometryHolder(), PxTransform(origin), unitDir, distance, ignore, move(onResult) });
+	}
+
+	void sweep(const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, float distance, ResultHandler onResult, const PxRigidActor* ignore = nullptr)
+	{
+		requests_.push_back({ QueryType::SWEEP, PxGeometryHolder(geometry), pose, unitDir, distance, ignore, move(onResult) });
+	}
+
+	void overlap(const PxGeometry& geometry, const PxTransform& pose, ResultHandler onResult, const PxRigidActor* ignore = nullptr)
+	{
+		requests_.push_back({ QueryType::OVERLAP, PxGeometryHolder(geometry), pose, PxVec3(0.0f), 0.0f, ignore, move(onResult) });
+	}
+
+	size_t pendingCount() const { return requests_.size(); }
+
+	// 영역 격자용 (씬이 하나면 필요 없음)
+	void setRouting(SceneRouter router, ActorResolver resolver)
+	{
+		router_ = move(router);
+		resolver_ = move(resolver);
+	}
+
+	// ---- 틱 단계 ----
+
+	// 모인 요청을 한꺼번에 실행 (시뮬레이션 중이 아닐 때, fetchResults 뒤)
+	void execute(const PxScene& scene)
+	{
+		const PxScene* scenes[] = { &scene };
+		execute(scenes, 1);
+	}
+
+	void execute(const vector<PxScene*>& scenes)
+	{
+		execute(scenes.data(), scenes.size());
+	}
+
+	// 씬이 여럿이면 요청 위치(레이 원점, 스윕 시작, 오버랩 중심)의 씬에서만 실행
+	// 영역 경계 너머는 그 씬에 있는 고스트(경계 여유 안)까지만 보인다
+	void execute(const PxScene* const* scenes, size_t sceneCount)
+	{
+		auto start = chrono::steady_clock::now();
+
+		completed_.clear();
+		hits_.clear();
+		lastQueryCount_ = static_cast<uint32_t>(requests_.size());
+		if (requests_.empty())
+		{
+			lastExecuteMicros_ = 0.0f;
+			return;
+		}
+
+		if (batches_.size() < sceneCount)
+			batches_.resize(sceneCount);
+		for (SceneBatch& sceneBatch : batches_)
+			sceneBatch.raycasts = sceneBatch.sweeps = sceneBatch.overlaps = 0;
+
+		requestScenes_.clear();
+		for (const Request& request : requests_)
+		{
+			uint32_t index = sceneCount > 1 && router_
+				? std::min<uint32_t>(router_(request.pose.p), static_cast<uint32_t>(sceneCount - 1))
+				: 0;
+			requestScenes_.push_back(index);
+			SceneBatch& sceneBatch = batches_[index];
+			if (request.type == QueryType::RAYCAST) sceneBatch.raycasts++;
+			else if (request.type == QueryType::SWEEP) sceneBatch.sweeps++;
+			else sceneBatch.overlaps++;
+		}
+
+		// 전부 touch로 받는다 (블록 히트 하나만 받으면 자기 자신에 막힘)
+		PxQueryFilterData filter(PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC | PxQueryFlag::eNO_BLOCK);
+		PxHitFlags hitFlags = PxHitFlag::ePOSITION | PxHitFlag::eNORMAL;
+
+		buffers_.assign(requests_.size(), nullptr);
+		for (size_t index = 0; index < sceneCount; ++index)
+		{
+			SceneBatch& sceneBatch = batches_[index];
+			if (sceneBatch.raycasts + sceneBatch.sweeps + sceneBatch.overlaps == 0)
+				continue;
+			ensureCapacity(sceneBatch, *scenes[index]);
+
+			for (size_t i = 0; i < requests_.size(); ++i)
+			{
+				if (requestScenes_[i] != index)
+					continue;
+
+				const Request& request = requests_[i];
+				switch (request.type)
+				{
+				case QueryType::RAYCAST:
+					buffers_[i] = sceneBatch.batch->raycast(request.pose.p, request.direction, request.distance,
+						CAST_TOUCHES, hitFlags, filter);
+					break;
+				case QueryType::SWEEP:
+					buffers_[i] = sceneBatch.batch->sweep(request.geometry.any(), request.pose, request.direction, request.distance,
+						CAST_TOUCHES, hitFlags, filter);
+					break;
+				case QueryType::OVERLAP:
+					buffers_[i] = sceneBatch.batch->overlap(request.geometry.any(), request.pose, OVERLAP_TOUCHES, filter);
+					break;
+				}
+			}
+			sceneBatch.batch->execute();
+		}
+
+		for (size_t i = 0; i < requests_.size(); ++i)
+		{
+			Request& request = requests_[i];
+			uint32_t first = static_cast<uint32_t>(hits_.size());
+
+			switch (request.type)
+			{
+			case QueryType::RAYCAST:
+				collectClosest(static_cast<const PxRaycastBuffer*>(buffers_[i]), request.ignore);
+				break;
+			case QueryType::SWEEP:
+				collectClosest(static_cast<const PxSweepBuffer*>(buffers_[i]), request.ignore);
+				break;
+			case QueryType::OVERLAP:
+				collectOverlaps(static_cast<const PxOverlapBuffer*>(buffers_[i]), request.ignore);
+				break;
+			}
+
+			completed_.push_back({ move(request.onResult), first, static_cast<uint32_t>(hits_.size()) - first });
+		}
+		requests_.clear();
+
+		lastExecuteMicros_ = chrono::duration<float, micro>(chrono::steady_clock::now() - start).count();
+	}
+
+	// 지난 execute 결과를 콜백으로 전달 (다음 틱 시작 때)
+	// 그 사이 해제된 액터는 forgetActors()로 지워져 hit.actor가 nullptr일 수 있다
+	void dispatchResults()
+	{
+		for (const Completed& result : completed_)
+		{
+			result.onResult(result.hitCount > 0 ? &hits_[result.firstHit] : nullptr, result.hitCount);
+		}
+		completed_.clear();
+		hits_.clear();
+	}
+
+	// 해제 직전의 액터를 결과/요청에서 지운다 (shouldForget(actor)가 true인 것)
+	template <typename F>
+	void forgetActors(F&& shouldForget)
+	{
+		for (SceneQueryHit& hit : hits_)
+		{
+			if (hit.actor && shouldForget(hit.actor))
+				hit.actor = nullptr;
+		}
+		for (Request& request : requests_)
+		{
+			if (request.ignore && shouldForget(request.ignore))
+				request.ignore = nullptr;
+		}
+	}
+
+	float lastExecuteMicros() const { return lastExecuteMicros_; }
+	uint32_t lastQueryCount() const { return lastQueryCount_; }
+
+private:
+	// 버퍼 수용량이 모자라면 두 배로 다시 만든다 (대부분의 틱은 할당 없음)
+	void ensureCapacity(SceneBatch& sceneBatch, const PxScene& scene)
+	{
+		if (sceneBatch.batch && sceneBatch.raycasts <= sceneBatch.raycastCapacity
+			&& sceneBatch.sweeps <= sceneBatch.sweepCapacity && sceneBatch.overlaps <= sceneBatch.overlapCapacity)
+			return;
+
+		auto grow = [](PxU32 capacity, PxU32 needed) {
+			capacity = std::max<PxU32>(capacity, 64);
+			while (capacity < needed)
+				capacity *= 2;
+			return capacity;
+		};
+		sceneBatch.raycastCapacity = grow(sceneBatch.raycastCapacity, sceneBatch.raycasts);
+		sceneBatch.sweepCapacity = grow(sceneBatch.sweepCapacity, sceneBatch.sweeps);
+		sceneBatch.overlapCapacity = grow(sceneBatch.overlapCapacity, sceneBatch.overlaps);
+
+		if (sceneBatch.batch)
+			sceneBatch.batch->release();
+		sceneBatch.batch = PxCreateBatchQueryExt(scene, nullptr,
+			sceneBatch.raycastCapacity, sceneBatch.raycastCapacity * CAST_TOUCHES,
+			sceneBatch.sweepCapacity, sceneBatch.sweepCapacity * CAST_TOUCHES,
+			sceneBatch.overlapCapacity, sceneBatch.overlapCapacity * OVERLAP_TOUCHES);
+	}
+
+	const PxRigidActor* resolve(const PxRigidActor* actor) const
+	{
+		return resolver_ ? resolver_(actor) : actor;
+	}
+
+	template <typename Buffer>
+	void collectClosest(const Buffer* buffer, const PxRigidActor* ignore)
+	{
+		if (!buffer)
+			return;
+
+		int best = -1;
+		for (PxU32 i = 0; i < buffer->getNbTouches(); ++i)
+		{
+			const auto& touch = buffer->getTouch(i);
+			if (resolve(touch.actor) == ignore)
+				continue;
+			if (best < 0 || touch.distance < buffer->getTouch(best).distance)
+				best = static_cast<int>(i);
+		}
+		if (best < 0)
+			return;
+
+		const auto& touch = buffer->getTouch(best);
+		SceneQueryHit hit;
+		hit.actor = resolve(touch.actor);
+		hit.position = touch.position;
+		hit.normal = touch.normal;
+		hit.distance = touch.distance;
+		hits_.push_back(hit);
+	}
+
+	void collectOverlaps(const PxOverlapBuffer* buffer, const PxRigidActor* ignore)
+	{
+		if (!buffer)
+			return;
+
+		for (PxU32 i = 0; i < buffer->getNbTouches(); ++i)
+		{
+			const PxOverlapHit& touch = buffer->getTouch(i);
+			const PxRigidActor* actor = resolve(touch.actor);
+			if (actor == ignore)
+				continue;
+			SceneQueryHit hit;
+			hit.actor = actor;
+			hit.position = actor->getGlobalPose().p;
+			hits_.push_back(hit);
+		}
+	}
+};
@@ -0,0 +1,173 @@
+#pragma once
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+// 서버 실행 옵션
+// 사용법: GameServer [--port=9002] [--nodelay=1] [--sndbuf=0] [--notsent-lowat=0]
+//                   [--io-threads=0] [--world-threads=1] [--pin-threads=0]
+//                   [--udp-port=0] [--udp-mtu=1200] [--udp-rate-kbps=0] [--udp-loss=0]
+//                   [--scene-profile=default] [--regions=1] [--max-players=50]
+//                   [--room-snapshot=] [--snapshot-interval=0]
+//                   [--log-level=info]
+//                   [--client-budget-kbps=0] [--client-budget-adaptive=0]
+//                   [--stats-port=0] [--max-queue-kb=4096] [--max-write-stall-ms=5000] [--max-rtt-ms=10000]
+//                   [--gateway=] [--spectator-rate=15] [--max-spectators=10000]
+//                   [--shm-export=] [--shm-slots=8] [--shm-capacity=131072]
+//                   [--pvd-capture=] [--pvd-ticks=600] [--pvd-dir=.]
+struct ServerConfig
+{
+	int port = 9002;
+
+	// 소켓 옵션 (accept 시 적용, 0이면 OS 기본값 유지)
+	bool tcpNoDelay = true;   // Nagle 끄기
+	int sendBufferBytes = 0;  // SO_SNDBUF
+	int notSentLowat = 0;     // TCP_NOTSENT_LOWAT (Linux)
+
+	// I/O 샤드 (샤드 하나 = io_context 하나 + 스레드 하나)
+	int ioThreads = 0;        // 0이면 hardware_concurrency
+	bool pinThreads = false;  // 샤드 스레드를 코어에 고정
+
+	// 게임 루프의 더미별 단계(동기화, 상태 기록, 장식용 적분, 스냅샷 인코딩)를 나눌 스레드 수 (게임 루프 스레드 포함, 1이면 단일)
+	int worldThreads = 1;
+
+	// UDP 스냅샷 채널 (0이면 끔)
+	int udpPort = 0;
+	int udpMtu = 1200;
+	int udpRateKbps = 0;      // 클라이언트당 송신 제한, 0이면 무제한
+	float udpLoss = 0.0f;     // 손실 시뮬레이션 비율 (루프백 테스트용)
+
+	// PhysX 씬 프로필 (SceneProfile.h)
+	string sceneProfile = "default";
+	int regions = 1;          // 맵을 N x N 영역 씬으로 나눠 병렬 스텝 (1..8, 칸마다 기본 맵 크기)
+	int maxPlayers = 50;      // 플레이어 정원 (1..4096, 영역을 늘릴 때 함께 늘림)
+
+	// 방 스냅샷 (RoomSnapshot.h): 시작 시 있으면 복원, 종료 시 저장
+	string roomSnapshot;      // 빈 문자열이면 끔
+	int snapshotInterval = 0; // 초, 0이면 종료 시에만 저장 (크래시 복구용 주기 저장)
+
+	// 로그 (Logger.h): debug / info / warn / error
+	string logLevel = "info";
+
+	// 클라이언트별 웹소켓 스냅샷 예산 (SnapshotScheduler.h), 0이면 매 틱 전체 스냅샷
+	int clientBudgetKbps = 0;
+	bool clientBudgetAdaptive = false; // 쓰기 완료 지연에 따라 예산을 줄이고 늘림 (최대 clientBudgetKbps)
+
+	// 로컬 통계 조회 (127.0.0.1 HTTP GET /stats, 0이면 끔)
+	int statsPort = 0;
+
+	// 느린 소비자 축출 기준 (0이면 해당 검사 끔)
+	int maxQueueKb = 4096;        // 세션 쓰기 큐 상한
+	int maxWriteStallMs = 5000;   // 쓰기 하나가 이보다 오래 안 끝나면
+	int maxRttMs = 10000;         // ping 응답이 이보다 늦으면
+
+	// 게이트웨이 제어 주소 "host:port" (GatewayControl.h), 빈 문자열이면 단독 실행
+	string gateway;
+
+	// 관전자 (SPECTATE_REQUEST, 월드 슬롯 없음): 스냅샷 주기(Hz)와 상한 (0이면 관전 거부)
+	int spectatorRate = 15;
+	int maxSpectators = 10000;
+
+	// 공유 메모리 스냅샷 내보내기 (SnapshotRing.h, 로컬 사이드카용): shm 이름, 빈 문자열이면 끔
+	string shmExport;
+	int shmSlots = 8;            // 링 길이 (프레임), 소비자가 이만큼 뒤처지면 덮어써진다
+	int shmCapacity = 131072;    // 프레임당 최대 개체 수 (플레이어 + 더미)
+
+	// PhysX Visual Debugger 파일 캡처 (profile/checked PhysX 라이브러리 필요)
+	// pvdCapture: 시작하자마자 캡처할 .pxd2 경로 (빈 문자열이면 안 함)
+	// 실행 중에는 통계 포트로: curl -X POST "http://127.0.0.1:<stats-port>/pvd-capture?ticks=300" -> pvdDir에 기록
+	string pvdCapture;
+	int pvdTicks = 600;          // 캡처 창 (틱)
+	string pvdDir = ".";
+};
+
+// "--key=value" 형식 인자에서 value 추출
+inline bool matchArg(const char *arg, const char *key, const char *&value)
+{
+	size_t keyLen = strlen(key);
+	if (strncmp(arg, key, keyLen) == 0 && arg[keyLen] == '=')
+	{
+		value = arg + keyLen + 1;
+		return true;
+	}
+	return false;
+}
+
+inline ServerConfig parseServerConfig(int argc, char *argv[])
+{
+	ServerConfig config;
+	for (int i = 1; i < argc; ++i)
+	{
+		const char *value = nullptr;
+		if (matchArg(argv[i], "--port", value))
+			config.port = atoi(value);
+		else if (matchArg(argv[i], "--nodelay", value))
+			config.tcpNoDelay = atoi(value) != 0;
+		else if (matchArg(argv[i], "--sndbuf", value))
+			config.sendBufferBytes = atoi(value);
+		else if (matchArg(argv[i], "--notsent-lowat", value))
+			config.notSentLowat = atoi(value);
+		else if (matchArg(argv[i], "--io-threads", value))
+			config.ioThreads = atoi(value);
+		else if (matchArg(argv[i], "--world-threads", value))
+			config.worldThreads = atoi(value);
+		else if (matchArg(argv[i], "--pin-threads", value))
+			config.pinThreads = atoi(value) != 0;
+		else if (matchArg(argv[i], "--udp-port", value))
+			config.udpPort = atoi(value);
+		else if (matchArg(argv[i], "--udp-mtu", value))
+			config.udpMtu = atoi(value);
+		else if (matchArg(argv[i], "--udp-rate-kbps", value))
+			config.udpRateKbps = atoi(value);
+		else if (matchArg(argv[i], "--udp-loss", value))
+			config.udpLoss = static_cast<float>(atof(value));
+		else if (matchArg(argv[i], "--scene-profile", value))
+			config.sceneProfile = value;
+		else if (matchArg(argv[i], "--regions", value))
+			config.regions = atoi(value);
+		else if (matchArg(argv[i], "--max-players", value))
+			config.maxPlayers = atoi(value);
+		else if (matchArg(argv[i], "--room-snapshot", value))
+			config.roomSnapshot = value;
+		else if (matchArg(argv[i], "--snapshot-interval", value))
+			config.snapshotInterval = atoi(value);
+		else if (matchArg(argv[i], "--log-level", value))
+			config.logLevel = value;
+		else if (matchArg(argv[i], "--client-budget-kbps", value))
+			config.clientBudgetKbps = atoi(value);
+		else if (matchArg(argv[i], "--client-budget-adaptive", value))
+			config.clientBudgetAdaptive = atoi(value) != 0;
+		else if (matchArg(argv[i], "--stats-port", value))
+			config.statsPort = atoi(value);
+		else if (matchArg(argv[i], "--max-queue-kb", value))
+			config.maxQueueKb = atoi(value);
+		else if (matchArg(argv[i], "--max-write-stall-ms", value))
+			config.maxWriteStallMs = atoi(value);
+		else if (matchArg(argv[i], "--max-rtt-ms", value))
+			config.maxRttMs = atoi(value);
+		else if (matchArg(argv[i], "--gateway", value))
+			config.gateway = value;
+		else if (matchArg(argv[i], "--spectator-rate", value))
+			config.spectatorRate = atoi(value);
+		else if (matchArg(argv[i], "--max-spectators", value))
+			config.maxSpectators = atoi(value);
+		else if (matchArg(argv[i], "--shm-export", value))
+			config.shmExport = value;
+		else if (matchArg(argv[i], "--shm-slots", value))
+			config.shmSlots = atoi(value);
+		else if (matchArg(argv[i], "--shm-capacity", value))
+			config.shmCapacity = atoi(value);
+		else if (matchArg(argv[i], "--pvd-capture", value))
+			config.pvdCapture = value;
+		else if (matchArg(argv[i], "--pvd-ticks", value))
+			config.pvdTicks = atoi(value);
+		else if (matchArg(argv[i], "--pvd-dir", value))
+			config.pvdDir = value;
+		else
+			cerr << "Unknown option: " << argv[i] << endl;
+	}
+	return config;
+}
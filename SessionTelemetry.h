@@ -0,0 +1,95 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <nlohmann/json.hpp>
+
+using namespace std;
+
+// 세션별 네트워크 지표 (세션의 샤드 스레드에서만 갱신)
+// 샤드가 주기적으로 복사본을 모아 두면 통계 조회(StatsEndpoint)는 그 복사본만 읽는다
+struct SessionTelemetry
+{
+	long long bytesIn = 0;
+	long long bytesOut = 0;
+	long long messagesIn = 0;
+	long long messagesOut = 0;
+
+	size_t queueDepth = 0;     // 보내는 중인 것 포함
+	size_t queueHighWater = 0;
+	size_t queuedBytes = 0;
+
+	int64_t rttMicros = -1;           // 웹소켓 ping/pong 왕복, 평활값 (아직 없으면 -1)
+	int64_t lastRttMicros = -1;
+	int64_t writeLatencyMicros = 0;   // async_write 시작 ~ 완료, 평활값
+	int64_t maxWriteLatencyMicros = 0;
+
+	// TCP SRTT처럼 1/8 가중 평균
+	static int64_t smooth(int64_t current, int64_t sample)
+	{
+		return current < 0 ? sample : current + (sample - current) / 8;
+	}
+
+	void recordRtt(int64_t micros)
+	{
+		lastRttMicros = micros;
+		rttMicros = smooth(rttMicros, micros);
+	}
+
+	void recordWriteLatency(int64_t micros)
+	{
+		writeLatencyMicros = smooth(writeLatencyMicros, micros);
+		maxWriteLatencyMicros = max(maxWriteLatencyMicros, micros);
+	}
+
+	void recordQueue(size_t depth, size_t bytes)
+	{
+		queueDepth = depth;
+		queuedBytes = bytes;
+		queueHighWater = max(queueHighWater, depth);
+	}
+};
+
+// 통계 조회용 세션 한 줄
+struct SessionStatsRow
+{
+	int shard = 0;
+	int playerId = -1;
+	string nickname;
+	bool spectator = false;
+	string remote;
+	double connectedSeconds = 0.0;
+	SessionTelemetry telemetry;
+
+	nlohmann::json toJson() const
+	{
+		nlohmann::json row;
+		row["shard"] = shard;
+		row["playerId"] = playerId;
+		row["nickname"] = nickname;
+		row["spectator"] = spectator;
+		row["remote"] = remote;
+		row["connectedSeconds"] = connectedSeconds;
+		row["bytesIn"] = telemetry.bytesIn;
+		row["bytesOut"] = telemetry.bytesOut;
+		row["messagesIn"] = telemetry.messagesIn;
+		row["messagesOut"] = telemetry.messagesOut;
+		row["queueDepth"] = telemetry.queueDepth;
+		row["queueHighWater"] = telemetry.queueHighWater;
+		row["queuedBytes"] = telemetry.queuedBytes;
+		row["rttMs"] = telemetry.rttMicros < 0 ? -1.0 : telemetry.rttMicros / 1000.0;
+		row["lastRttMs"] = telemetry.lastRttMicros < 0 ? -1.0 : telemetry.lastRttMicros / 1000.0;
+		row["writeLatencyMs"] = telemetry.writeLatencyMicros / 1000.0;
+		row["maxWriteLatencyMs"] = telemetry.maxWriteLatencyMicros / 1000.0;
+		return row;
+	}
+};
+
+// 느린 소비자 축출 기준 (0이면 해당 검사 끔)
+struct EvictionLimits
+{
+	size_t maxQueueBytes = 0;     // 쓰기 큐에 쌓인 바이트
+	int maxWriteStallMs = 0;      // 쓰기 하나가 끝나지 않고 걸려 있는 시간
+	int maxRttMs = 0;             // 평활 RTT 또는 응답 없는 ping의 대기 시간
+};
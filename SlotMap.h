@@ -0,0 +1,120 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+using namespace std;
+
+// 슬롯 핸들 (인덱스 + 세대)
+// 세대 값으로 이미 해제된 슬롯을 가리키는 오래된 핸들을 걸러낸다
+struct SlotHandle
+{
+	uint32_t index = UINT32_MAX;
+	uint32_t generation = 0;
+
+	bool valid() const { return index != UINT32_MAX; }
+};
+
+// 슬롯 맵
+// - 삽입/삭제/조회 모두 O(1)
+// - 값은 dense 배열에 빈틈없이 저장되므로 순회가 캐시 친화적
+// - 삭제는 마지막 원소와 swap 후 pop (순서는 보장하지 않음)
+template <typename T>
+class SlotMap
+{
+private:
+	struct Slot
+	{
+		uint32_t denseIndex = 0;
+		uint32_t generation = 0;
+		bool occupied = false;
+	};
+
+	vector<T> dense_;
+	vector<uint32_t> denseToSlot_;
+	vector<Slot> slots_;
+	vector<uint32_t> freeSlots_;
+
+public:
+	SlotHandle insert(T value)
+	{
+		uint32_t slotIndex;
+		if (!freeSlots_.empty())
+		{
+			slotIndex = freeSlots_.back();
+			freeSlots_.pop_back();
+		}
+		else
+		{
+			slotIndex = static_cast<uint32_t>(slots_.size());
+			slots_.emplace_back();
+		}
+
+		Slot &slot = slots_[slotIndex];
+		slot.denseIndex = static_cast<uint32_t>(dense_.size());
+		slot.occupied = true;
+
+		dense_.push_back(move(value));
+		denseToSlot_.push_back(slotIndex);
+
+		return SlotHandle{ slotIndex, slot.generation };
+	}
+
+	bool erase(SlotHandle handle)
+	{
+		if (!contains(handle))
+			return false;
+
+		Slot &slot = slots_[handle.index];
+		uint32_t removeIndex = slot.denseIndex;
+		uint32_t lastIndex = static_cast<uint32_t>(dense_.size() - 1);
+
+		// 마지막 원소를 빈 자리로 옮기고 그 슬롯의 dense 인덱스 갱신
+		if (removeIndex != lastIndex)
+		{
+			dense_[removeIndex] = move(dense_[lastIndex]);
+			denseToSlot_[removeIndex] = denseToSlot_[lastIndex];
+			slots_[denseToSlot_[removeIndex]].denseIndex = removeIndex;
+		}
+		dense_.pop_back();
+		denseToSlot_.pop_back();
+
+		slot.occupied = false;
+		slot.generation++; // 기존 핸들 무효화
+		freeSlots_.push_back(handle.index);
+		return true;
+	}
+
+	bool contains(SlotHandle handle) const
+	{
+		return handle.index < slots_.size()
+			&& slots_[handle.index].occupied
+			&& slots_[handle.index].generation == handle.generation;
+	}
+
+	T *get(SlotHandle handle)
+	{
+		return contains(handle) ? &dense_[slots_[handle.index].denseIndex] : nullptr;
+	}
+
+	size_t size() const { return dense_.size(); }
+	bool empty() const { return dense_.empty(); }
+
+	void clear()
+	{
+		for (uint32_t slotIndex : denseToSlot_)
+		{
+			slots_[slotIndex].occupied = false;
+			slots_[slotIndex].generation++;
+			freeSlots_.push_back(slotIndex);
+		}
+		dense_.clear();
+		denseToSlot_.clear();
+	}
+
+	// dense 배열 순회
+	typename vector<T>::iterator begin() { return dense_.begin(); }
+	typename vector<T>::iterator end() { return dense_.end(); }
+	typename vector<T>::const_iterator begin() const { return dense_.begin(); }
+	typename vector<T>::const_iterator end() const { return dense_.end(); }
+};
@@ -0,0 +1,137 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "GameObject.h"
+
+using namespace std;
+
+// 스냅샷 JSON 조각 직접 쓰기 (json DOM/임시 문자열 없이)
+// 출력은 append(const char*, size_t)/push_back(char)이 있는 버퍼 (string, FrameText)
+// 좌표는 mm 단위(%.3f)로 잘라 크기를 줄인다 (예산 스냅샷과 전체 스냅샷이 같은 형식)
+
+// {"id":1,"pos":[x,y,z]} 최대 길이 (float 최댓값을 %.3f로 써도 44자 x 3 + 여유)
+static const size_t DUMMY_JSON_MAX_BYTES = 192;
+// 플레이어 한 명에서 닉네임을 뺀 최대 길이 (실수 9개 + 키)
+static const size_t PLAYER_JSON_MAX_BYTES = 512;
+
+// 소수점 셋째 자리 고정 ("%.3f"와 같은 모양, snprintf보다 훨씬 빠르다), out에 48바이트 이상
+// mm 정수로 반올림해서 쓰고 (딱 0.5mm 동률과 -0.000만 %.3f와 다르다), 정수로 못 담는 값(NaN, 아주 큰 값)만 snprintf로
+inline char *writeFixed3(char *out, float value)
+{
+	double scaled = static_cast<double>(value) * 1000.0;
+	if (!(fabs(scaled) < 9.0e15))
+		return out + std::min(snprintf(out, 48, "%.3f", value), 47);
+
+	long long millis = llround(scaled);
+	if (millis < 0)
+	{
+		*out++ = '-';
+		millis = -millis;
+	}
+	out = to_chars(out, out + 24, millis / 1000).ptr;
+	int fraction = static_cast<int>(millis % 1000);
+	out[0] = '.';
+	out[1] = static_cast<char>('0' + fraction / 100);
+	out[2] = static_cast<char>('0' + fraction / 10 % 10);
+	out[3] = static_cast<char>('0' + fraction % 10);
+	return out + 4;
+}
+
+// out에 DUMMY_JSON_MAX_BYTES 이상 공간이 있어야 한다, 쓴 길이 반환
+inline size_t writeDummyJson(char *out, int id, const Vector3 &position)
+{
+	char *begin = out;
+	memcpy(out, "{\"id\":", 6);
+	out = to_chars(out + 6, out + 18, id).ptr;
+	memcpy(out, ",\"pos\":[", 8);
+	out = writeFixed3(out + 8, position.x);
+	*out++ = ',';
+	out = writeFixed3(out, position.y);
+	*out++ = ',';
+	out = writeFixed3(out, position.z);
+	memcpy(out, "]}", 2);
+	return static_cast<size_t>(out + 2 - begin);
+}
+
+// "..." (따옴표, 역슬래시, 제어 문자만 이스케이프, UTF-8은 그대로)
+template <typename Out>
+void appendJsonString(Out &out, const string &text)
+{
+	out.push_back('"');
+	for (unsigned char c : text)
+	{
+		switch (c)
+		{
+		case '"': out.append("\\\"", 2); break;
+		case '\\': out.append("\\\\", 2); break;
+		case '\b': out.append("\\b", 2); break;
+		case '\f': out.append("\\f", 2); break;
+		case '\n': out.append("\\n", 2); break;
+		case '\r': out.append("\\r", 2); break;
+		case '\t': out.append("\\t", 2); break;
+		default:
+			if (c < 0x20)
+			{
+				char escaped[8];
+				snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+				out.append(escaped, 6);
+			}
+			else
+			{
+				out.push_back(static_cast<char>(c));
+			}
+		}
+	}
+	out.push_back('"');
+}
+
+// {"id":1,"nickname":"...","pos":[...],"vel":[...],"color":[r,g,b]}
+template <typename Out>
+void appendPlayerJson(Out &out, const Player &player)
+{
+	char text[PLAYER_JSON_MAX_BYTES];
+	int length = snprintf(text, sizeof(text), "{\"id\":%d,\"nickname\":", player.id);
+	out.append(text, static_cast<size_t>(length));
+	appendJsonString(out, player.nickname);
+	length = snprintf(text, sizeof(text), ",\"pos\":[%.3f,%.3f,%.3f],\"vel\":[%.3f,%.3f,%.3f],\"color\":[%.3f,%.3f,%.3f]}",
+		player.position.x, player.position.y, player.position.z,
+		player.velocity.x, player.velocity.y, player.velocity.z,
+		player.color.r, player.color.g, player.color.b);
+	out.append(text, std::min<size_t>(static_cast<size_t>(length), sizeof(text) - 1));
+}
+
+// 플레이어 배열 "[...]" (players: unique_ptr<Player> 컨테이너, 빈 슬롯은 nullptr)
+template <typename Out, typename Players>
+void appendPlayersJson(Out &out, const Players &players)
+{
+	out.push_back('[');
+	bool first = true;
+	for (const auto &player : players)
+	{
+		if (player == nullptr)
+			continue;
+		if (!first)
+			out.push_back(',');
+		appendPlayerJson(out, *player);
+		first = false;
+	}
+	out.push_back(']');
+}
+
+// appendPlayersJson 출력 상한 (고정 용량 버퍼를 잡을 때)
+template <typename Players>
+size_t playersJsonMaxBytes(const Players &players)
+{
+	size_t bytes = 2;
+	for (const auto &player : players)
+	{
+		if (player != nullptr)
+			bytes += PLAYER_JSON_MAX_BYTES + 2 + player->nickname.size() * 6 + 1;
+	}
+	return bytes;
+}
@@ -0,0 +1,189 @@
+// 공유 메모리 스냅샷 링 테스트 리더 (SnapshotRing.h 사용 예)
+// 사용법: SnapshotReader [--name=/gameserver] [--mode=follow] [--seconds=0] [--dump=0]
+//   follow : 모든 프레임을 순서대로 읽는다 (뒤처져 덮어써진 프레임 수, 틱 연속성 확인)
+//   latest : 1초마다 최신 프레임만 읽는다
+//   --dump=N : 1초마다 읽은 프레임의 앞 N개 개체 출력
+// 서버가 아직 안 떴거나 재시작하면 다시 연다 (서버: GameServer --shm-export=/gameserver)
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "ServerConfig.h"
+#include "SnapshotRing.h"
+
+using namespace std;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+struct ReaderStats
+{
+	long long frames = 0;
+	long long missed = 0;      // 덮어써져 못 읽은 프레임
+	long long tickGaps = 0;    // 연속 프레임인데 틱이 1 이상 건너뜀 (서버가 내보내기를 건너뛰었거나 찢어진 읽기)
+	long long entities = 0;
+	double latencySumUs = 0.0; // 게시 ~ 복사 완료
+	double latencyMaxUs = 0.0;
+
+	void record(const SnapshotRingFrame &frame)
+	{
+		frames++;
+		entities += static_cast<long long>(frame.entities.size());
+		double latencyUs = (snapshotRingNowNs() - frame.timestampNs) / 1000.0;
+		latencySumUs += latencyUs;
+		latencyMaxUs = std::max(latencyMaxUs, latencyUs);
+	}
+};
+
+static void dumpFrame(const SnapshotRingFrame &frame, int count)
+{
+	cout << "  frame " << frame.frame << " tick " << frame.tick << " entities " << frame.entities.size();
+	if (frame.truncated())
+		cout << " (truncated from " << frame.totalCount << ")";
+	cout << endl;
+	int shown = std::min<int>(count, static_cast<int>(frame.entities.size()));
+	for (int i = 0; i < shown; ++i)
+	{
+		const SnapshotRingEntity &entity = frame.entities[i];
+		cout << "    " << (entity.kind == SnapshotRingEntity::PLAYER ? "player " : "dummy  ") << setw(7) << entity.id
+			<< fixed << setprecision(2)
+			<< "  pos (" << entity.position[0] << ", " << entity.position[1] << ", " << entity.position[2] << ")"
+			<< "  vel (" << entity.velocity[0] << ", " << entity.velocity[1] << ", " << entity.velocity[2] << ")" << endl;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	string name = "/gameserver";
+	string mode = "follow";
+	int seconds = 0;
+	int dump = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		const char *value = nullptr;
+		if (matchArg(argv[i], "--name", value))
+			name = value;
+		else if (matchArg(argv[i], "--mode", value))
+			mode = value;
+		else if (matchArg(argv[i], "--seconds", value))
+			seconds = atoi(value);
+		else if (matchArg(argv[i], "--dump", value))
+			dump = atoi(value);
+		else
+		{
+			cerr << "Unknown option: " << argv[i] << endl;
+			return 1;
+		}
+	}
+	if (mode != "follow" && mode != "latest")
+	{
+		cerr << "Unknown mode: " << mode << endl;
+		return 1;
+	}
+
+	signal(SIGINT, [](int) { stopRequested = 1; });
+	signal(SIGTERM, [](int) { stopRequested = 1; });
+
+	auto begin = chrono::steady_clock::now();
+	auto lastReport = begin;
+	ReaderStats stats, total;
+	SnapshotRingFrame frame;
+	unique_ptr<SnapshotRingReader> reader;
+	uint64_t next = 0;
+	uint32_t lastTick = 0;
+	bool hasLastTick = false;
+	bool waitingLogged = false;
+
+	while (!stopRequested)
+	{
+		auto now = chrono::steady_clock::now();
+		if (seconds > 0 && now - begin >= chrono::seconds(seconds))
+			break;
+
+		// 열기 / 서버 재시작 감지
+		if (!reader || reader->writerClosed())
+		{
+			if (reader)
+				cout << "Writer closed, reopening " << name << endl;
+			reader = SnapshotRingReader::open(name);
+			if (!reader)
+			{
+				if (!waitingLogged)
+					cout << "Waiting for " << name << "..." << endl;
+				waitingLogged = true;
+				this_thread::sleep_for(chrono::milliseconds(200));
+				continue;
+			}
+			waitingLogged = false;
+			frame.entities.reserve(reader->entityCapacity());
+			next = reader->latest() + 1; // 지난 프레임은 건너뛰고 지금부터
+			hasLastTick = false;
+			cout << "Opened " << name << " (pid " << reader->writerPid() << ", " << reader->slotCount() << " slots x "
+				<< reader->entityCapacity() << " entities, " << reader->tickRate() << " Hz)" << endl;
+		}
+
+		if (mode == "follow")
+		{
+			SnapshotRingReader::ReadResult result = reader->read(next, frame);
+			if (result == SnapshotRingReader::ReadResult::OK)
+			{
+				if (hasLastTick && frame.tick != lastTick + 1)
+					stats.tickGaps++;
+				lastTick = frame.tick;
+				hasLastTick = true;
+				stats.record(frame);
+				next++;
+			}
+			else if (result == SnapshotRingReader::ReadResult::OVERWRITTEN)
+			{
+				// 아직 남아 있을 가장 오래된 프레임으로 건너뛴다 (생산자가 쓰는 중인 슬롯 하나는 빼고)
+				uint64_t latest = reader->latest();
+				uint64_t oldest = latest + 2 > reader->slotCount() ? latest + 2 - reader->slotCount() : 1;
+				uint64_t skipTo = std::max(next + 1, oldest);
+				stats.missed += static_cast<long long>(skipTo - next);
+				next = skipTo;
+				hasLastTick = false;
+			}
+			else
+			{
+				// 다음 틱까지 기다린다 (틱 간격보다 충분히 짧게)
+				this_thread::sleep_for(chrono::microseconds(500));
+			}
+		}
+		else
+		{
+			if (reader->readLatest(frame))
+				stats.record(frame);
+			this_thread::sleep_for(chrono::seconds(1));
+		}
+
+		now = chrono::steady_clock::now();
+		if (now - lastReport >= chrono::seconds(1))
+		{
+			double elapsed = chrono::duration<double>(now - lastReport).count();
+			cout << "frames/s: " << fixed << setprecision(1) << (stats.frames / elapsed)
+				<< "  missed: " << stats.missed << "  tick gaps: " << stats.tickGaps
+				<< "  entities/frame: " << (stats.frames > 0 ? stats.entities / stats.frames : 0)
+				<< "  latency avg/max: " << setprecision(1) << (stats.frames > 0 ? stats.latencySumUs / stats.frames : 0.0)
+				<< " / " << stats.latencyMaxUs << " us"
+				<< "  torn retries: " << reader->tornRetries() << endl;
+			if (dump > 0 && stats.frames > 0)
+				dumpFrame(frame, dump);
+
+			total.frames += stats.frames;
+			total.missed += stats.missed;
+			total.tickGaps += stats.tickGaps;
+			stats = ReaderStats();
+			lastReport = now;
+		}
+	}
+
+	total.frames += stats.frames;
+	total.missed += stats.missed;
+	total.tickGaps += stats.tickGaps;
+	cout << "=== Result ===" << endl;
+	cout << "Frames: " << total.frames << "  Missed: " << total.missed << "  Tick gaps: " << total.tickGaps << endl;
+	return 0;
+}
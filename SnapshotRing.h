@@ -0,0 +1,415 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// 공유 메모리 스냅샷 링 (/dev/shm, 단일 생산자 / 다중 소비자)
+// 게임 서버가 틱마다 월드 상태(id, 위치, 속도, 틱)를 여기에 쓰고, 같은 머신의 사이드카
+// (분석, 리플레이 녹화, 치트 탐지)가 웹소켓/JSON 없이 읽는다. 소비자는 공유 메모리에 아무것도 쓰지 않으므로
+// 소비자 수와 관계없이 게임 루프 비용은 프레임당 한 번 쓰는 것뿐이다
+//
+// 레이아웃: [SnapshotRingHeader][슬롯 0][슬롯 1]...  슬롯 = [SnapshotRingSlot][SnapshotRingEntity x 용량]
+// - 프레임 번호 n(1부터)은 슬롯 (n - 1) % slotCount 에 쓴다
+// - 슬롯마다 seqlock: 쓰는 동안 sequence가 홀수, 다 쓰면 짝수. 읽은 뒤 sequence가 그대로면 찢어지지 않은 사본
+// - 소비자가 한 바퀴(slotCount 프레임) 이상 뒤처지면 그 프레임은 덮어써져 OVERWRITTEN
+// - POSIX 전용 (Windows에서는 create/open이 nullptr)
+// 헤더 하나로 끝나므로 사이드카는 이 파일만 include 하면 된다 (PhysX/Boost 불필요)
+
+// 개체 하나 (32바이트)
+struct SnapshotRingEntity
+{
+	enum Kind : uint8_t
+	{
+		PLAYER = 0,
+		DUMMY = 1,
+	};
+
+	int32_t id;
+	uint8_t kind;
+	uint8_t reserved[3];
+	float position[3];
+	float velocity[3];
+};
+static_assert(sizeof(SnapshotRingEntity) == 32, "SnapshotRingEntity layout is part of the shared-memory ABI");
+
+// 슬롯 앞부분 (캐시 라인 하나)
+struct alignas(64) SnapshotRingSlot
+{
+	atomic<uint64_t> sequence; // seqlock, 홀수면 쓰는 중
+	uint64_t frame;            // 이 슬롯에 든 프레임 번호 (0이면 아직 없음)
+	uint64_t timestampNs;      // 게시 시각 (steady_clock = CLOCK_MONOTONIC, 프로세스 간 비교 가능)
+	uint32_t tick;             // 게임 틱
+	uint32_t count;            // 개체 수
+	uint32_t totalCount;       // 월드의 실제 개체 수 (용량을 넘으면 count < totalCount)
+};
+
+struct alignas(64) SnapshotRingHeader
+{
+	enum State : uint32_t
+	{
+		LIVE = 1,
+		CLOSED = 2, // 서버가 정상 종료 (재시작하면 같은 이름으로 새 링이 생긴다)
+	};
+
+	char magic[8];
+	uint32_t version;
+	uint32_t slotCount;
+	uint32_t entityCapacity;
+	uint32_t tickRate;
+	uint64_t slotBytes;          // 슬롯 하나의 크기 (헤더 포함, 64바이트 배수)
+	uint64_t epoch;              // 링 생성 시각 (재시작 구분용)
+	int32_t writerPid;
+	atomic<uint32_t> state;
+	atomic<uint64_t> published;  // 마지막으로 다 쓴 프레임 번호 (0이면 아직 없음)
+
+	static const uint32_t VERSION = 1;
+
+	static const char *expectedMagic() { return "SNAPRING"; }
+
+	static uint64_t slotBytesFor(uint32_t entityCapacity)
+	{
+		uint64_t bytes = sizeof(SnapshotRingSlot) + static_cast<uint64_t>(entityCapacity) * sizeof(SnapshotRingEntity);
+		return (bytes + 63) / 64 * 64;
+	}
+
+	static uint64_t totalBytesFor(uint32_t slotCount, uint32_t entityCapacity)
+	{
+		return sizeof(SnapshotRingHeader) + slotCount * slotBytesFor(entityCapacity);
+	}
+
+	bool valid(size_t mappedSize) const
+	{
+		return memcmp(magic, expectedMagic(), sizeof(magic)) == 0
+			&& version == VERSION
+			&& slotCount >= 2
+			&& slotBytes == slotBytesFor(entityCapacity)
+			&& totalBytesFor(slotCount, entityCapacity) <= mappedSize;
+	}
+};
+static_assert(atomic<uint64_t>::is_always_lock_free, "shared-memory atomics must be lock-free");
+
+inline uint64_t snapshotRingNowNs()
+{
+	return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(
+		chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// 매핑 공용 부분
+class SnapshotRingMapping
+{
+protected:
+	char *data_ = nullptr;
+	size_t size_ = 0;
+
+	SnapshotRingMapping() = default;
+
+	~SnapshotRingMapping()
+	{
+#ifndef _WIN32
+		if (data_)
+			munmap(data_, size_);
+#endif
+	}
+
+	SnapshotRingHeader &header() const { return *reinterpret_cast<SnapshotRingHeader *>(data_); }
+
+	SnapshotRingSlot &slotFor(uint64_t frame) const
+	{
+		uint64_t index = (frame - 1) % header().slotCount;
+		return *reinterpret_cast<SnapshotRingSlot *>(data_ + sizeof(SnapshotRingHeader) + index * header().slotBytes);
+	}
+
+	static SnapshotRingEntity *entitiesOf(SnapshotRingSlot &slot)
+	{
+		return reinterpret_cast<SnapshotRingEntity *>(reinterpret_cast<char *>(&slot) + sizeof(SnapshotRingSlot));
+	}
+
+public:
+	SnapshotRingMapping(const SnapshotRingMapping &) = delete;
+	SnapshotRingMapping &operator=(const SnapshotRingMapping &) = delete;
+
+	uint32_t slotCount() const { return header().slotCount; }
+	uint32_t entityCapacity() const { return header().entityCapacity; }
+	uint32_t tickRate() const { return header().tickRate; }
+	size_t mappedBytes() const { return size_; }
+};
+
+// 생산자 (게임 루프 스레드 하나에서만)
+// begin -> add... -> commit 사이에 할당/시스템 콜 없음
+class SnapshotRingWriter : public SnapshotRingMapping
+{
+private:
+	string name_;
+	SnapshotRingSlot *current_ = nullptr;
+	SnapshotRingEntity *entities_ = nullptr;
+	uint64_t frame_ = 0;
+	uint32_t count_ = 0;
+	uint32_t totalCount_ = 0;
+
+	SnapshotRingWriter() = default;
+
+public:
+	~SnapshotRingWriter()
+	{
+		if (!data_)
+			return;
+		header().state.store(SnapshotRingHeader::CLOSED, memory_order_release);
+#ifndef _WIN32
+		// 이미 열어 둔 소비자는 매핑이 남아 있으므로 CLOSED를 볼 수 있다
+		shm_unlink(name_.c_str());
+#endif
+	}
+
+	// name: "/gameserver" 같은 shm 이름 (Linux에서는 /dev/shm/gameserver)
+	// 같은 이름의 이전 링(크래시한 서버가 남긴 것)은 지우고 새로 만든다
+	static unique_ptr<SnapshotRingWriter> create(const string &name, uint32_t slotCount, uint32_t entityCapacity, uint32_t tickRate)
+	{
+#ifdef _WIN32
+		return nullptr;
+#else
+		if (slotCount < 2 || entityCapacity == 0)
+			return nullptr;
+
+		shm_unlink(name.c_str());
+		int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+		if (fd < 0)
+			return nullptr;
+
+		size_t size = static_cast<size_t>(SnapshotRingHeader::totalBytesFor(slotCount, entityCapacity));
+		if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+		{
+			::close(fd);
+			shm_unlink(name.c_str());
+			return nullptr;
+		}
+
+		int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+		flags |= MAP_POPULATE; // 첫 바퀴에서 게임 루프가 페이지 폴트를 맞지 않도록
+#endif
+		void *mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+		::close(fd);
+		if (mapped == MAP_FAILED)
+		{
+			shm_unlink(name.c_str());
+			return nullptr;
+		}
+
+		unique_ptr<SnapshotRingWriter> writer(new SnapshotRingWriter());
+		writer->data_ = static_cast<char *>(mapped);
+		writer->size_ = size;
+		writer->name_ = name;
+
+		// ftruncate로 0으로 채워져 있으므로 슬롯(sequence 0, frame 0)은 그대로 둔다
+		SnapshotRingHeader &header = writer->header();
+		header.version = SnapshotRingHeader::VERSION;
+		header.slotCount = slotCount;
+		header.entityCapacity = entityCapacity;
+		header.tickRate = tickRate;
+		header.slotBytes = SnapshotRingHeader::slotBytesFor(entityCapacity);
+		header.epoch = snapshotRingNowNs();
+		header.writerPid = static_cast<int32_t>(getpid());
+		header.published.store(0, memory_order_relaxed);
+		header.state.store(SnapshotRingHeader::LIVE, memory_order_relaxed);
+		// magic을 마지막에 (소비자는 magic이 맞아야 나머지를 믿는다)
+		atomic_thread_fence(memory_order_release);
+		memcpy(header.magic, SnapshotRingHeader::expectedMagic(), sizeof(header.magic));
+		return writer;
+#endif
+	}
+
+	const string &name() const { return name_; }
+	uint64_t published() const { return frame_; }
+
+	// 다음 프레임 시작: 슬롯을 쓰는 중(홀수)으로 표시
+	void begin(uint32_t tick)
+	{
+		frame_++;
+		current_ = &slotFor(frame_);
+		entities_ = entitiesOf(*current_);
+		count_ = 0;
+		totalCount_ = 0;
+
+		uint64_t sequence = current_->sequence.load(memory_order_relaxed);
+		current_->sequence.store(sequence + 1, memory_order_relaxed);
+		atomic_thread_fence(memory_order_release); // 아래 쓰기가 홀수 표시보다 먼저 보이지 않도록
+		current_->frame = frame_;
+		current_->tick = tick;
+	}
+
+	// 용량을 넘는 개체는 세기만 한다 (Vec은 x/y/z 멤버가 있는 아무 타입)
+	template <typename Vec>
+	void add(int32_t id, SnapshotRingEntity::Kind kind, const Vec &position, const Vec &velocity)
+	{
+		totalCount_++;
+		if (count_ >= header().entityCapacity)
+			return;
+		SnapshotRingEntity &entity = entities_[count_++];
+		entity.id = id;
+		entity.kind = kind;
+		entity.position[0] = position.x;
+		entity.position[1] = position.y;
+		entity.position[2] = position.z;
+		entity.velocity[0] = velocity.x;
+		entity.velocity[1] = velocity.y;
+		entity.velocity[2] = velocity.z;
+	}
+
+	// 프레임 게시: 슬롯을 짝수로 되돌리고 published를 올린다
+	void commit()
+	{
+		current_->count = count_;
+		current_->totalCount = totalCount_;
+		current_->timestampNs = snapshotRingNowNs();
+		current_->sequence.store(current_->sequence.load(memory_order_relaxed) + 1, memory_order_release);
+		header().published.store(frame_, memory_order_release);
+		current_ = nullptr;
+	}
+
+	uint32_t lastCount() const { return count_; }
+	uint32_t lastTotalCount() const { return totalCount_; }
+};
+
+// 소비자가 복사해 가는 프레임 (entities는 용량만큼 한 번 reserve 되면 이후 할당 없음)
+struct SnapshotRingFrame
+{
+	uint64_t frame = 0;
+	uint64_t timestampNs = 0;
+	uint32_t tick = 0;
+	uint32_t totalCount = 0;
+	vector<SnapshotRingEntity> entities;
+
+	bool truncated() const { return entities.size() < totalCount; }
+};
+
+// 소비자 (프로세스 수, 스레드 수 제한 없음, 공유 메모리는 읽기 전용으로 매핑)
+class SnapshotRingReader : public SnapshotRingMapping
+{
+public:
+	enum class ReadResult
+	{
+		OK,
+		NOT_READY,   // 아직 게시되지 않은 프레임
+		OVERWRITTEN, // 너무 뒤처져 생산자가 덮어씀 (또는 계속 찢어짐)
+	};
+
+private:
+	uint64_t epoch_ = 0;
+	long long tornRetries_ = 0;
+
+	static const int MAX_TORN_RETRIES = 16;
+
+	SnapshotRingReader() = default;
+
+public:
+	// 링이 없거나 아직 초기화 중이면 nullptr (서버가 뜰 때까지 재시도하면 된다)
+	static unique_ptr<SnapshotRingReader> open(const string &name)
+	{
+#ifdef _WIN32
+		return nullptr;
+#else
+		int fd = shm_open(name.c_str(), O_RDONLY, 0);
+		if (fd < 0)
+			return nullptr;
+
+		struct stat st;
+		if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SnapshotRingHeader))
+		{
+			::close(fd);
+			return nullptr;
+		}
+		size_t size = static_cast<size_t>(st.st_size);
+		void *mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (mapped == MAP_FAILED)
+			return nullptr;
+
+		unique_ptr<SnapshotRingReader> reader(new SnapshotRingReader());
+		reader->data_ = static_cast<char *>(mapped);
+		reader->size_ = size;
+		if (!reader->header().valid(size))
+			return nullptr;
+		atomic_thread_fence(memory_order_acquire);
+		reader->epoch_ = reader->header().epoch;
+		return reader;
+#endif
+	}
+
+	// 마지막으로 게시된 프레임 번호 (0이면 아직 없음)
+	uint64_t latest() const { return header().published.load(memory_order_acquire); }
+
+	// 서버가 정상 종료했으면 true -> 다시 open 해서 새 링을 찾는다
+	// (크래시는 latest()가 더 이상 오르지 않는 것으로 판단)
+	bool writerClosed() const { return header().state.load(memory_order_acquire) == SnapshotRingHeader::CLOSED; }
+	int writerPid() const { return header().writerPid; }
+	uint64_t epoch() const { return epoch_; }
+	long long tornRetries() const { return tornRetries_; }
+
+	// 프레임 하나를 out에 복사 (순서대로 따라가려면 frame을 1씩 올리며 호출)
+	ReadResult read(uint64_t frame, SnapshotRingFrame &out)
+	{
+		if (frame == 0 || frame > latest())
+			return ReadResult::NOT_READY;
+
+		SnapshotRingSlot &slot = slotFor(frame);
+		for (int attempt = 0; attempt < MAX_TORN_RETRIES; ++attempt)
+		{
+			uint64_t before = slot.sequence.load(memory_order_acquire);
+			if (before & 1)
+				return ReadResult::OVERWRITTEN; // 생산자가 이 슬롯에 더 새 프레임을 쓰는 중
+
+			uint64_t slotFrame = slot.frame;
+			uint32_t count = slot.count;
+			if (slotFrame != frame || count > header().entityCapacity)
+			{
+				atomic_thread_fence(memory_order_acquire);
+				if (slot.sequence.load(memory_order_relaxed) != before)
+				{
+					tornRetries_++;
+					continue;
+				}
+				return slotFrame > frame ? ReadResult::OVERWRITTEN : ReadResult::NOT_READY;
+			}
+
+			out.frame = slotFrame;
+			out.tick = slot.tick;
+			out.timestampNs = slot.timestampNs;
+			out.totalCount = slot.totalCount;
+			out.entities.resize(count);
+			memcpy(out.entities.data(), entitiesOf(slot), count * sizeof(SnapshotRingEntity));
+
+			// 복사하는 동안 sequence가 그대로였으면 일관된 사본
+			atomic_thread_fence(memory_order_acquire);
+			if (slot.sequence.load(memory_order_relaxed) == before)
+				return ReadResult::OK;
+			tornRetries_++;
+		}
+		return ReadResult::OVERWRITTEN;
+	}
+
+	// 가장 최근 프레임 (중간 프레임이 필요 없는 소비자용)
+	bool readLatest(SnapshotRingFrame &out)
+	{
+		for (int attempt = 0; attempt < MAX_TORN_RETRIES; ++attempt)
+		{
+			uint64_t frame = latest();
+			if (frame == 0)
+				return false;
+			if (read(frame, out) == ReadResult::OK)
+				return true;
+		}
+		return false;
+	}
+};
@@ -0,0 +1,272 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GameObject.h"
+#include "SnapshotJson.h"
+
+using namespace std;
+
+// 다른 스레드들이 다 쓰고 놓은 객체(use_count == 1)를 다시 꺼내 쓰는 풀
+// 동기화는 호출자가 한다 (acquire는 한 번에 한 스레드만)
+template <typename T>
+class SharedPool
+{
+private:
+	vector<shared_ptr<T>> items_;
+	size_t maxItems_;
+
+public:
+	explicit SharedPool(size_t maxItems)
+		: maxItems_(maxItems)
+	{
+	}
+
+	shared_ptr<T> acquire()
+	{
+		for (auto &item : items_)
+		{
+			if (item.use_count() == 1)
+			{
+				// 마지막 참조를 놓은 스레드의 읽기가 끝난 뒤에 덮어쓰도록
+				atomic_thread_fence(memory_order_acquire);
+				return item;
+			}
+		}
+
+		auto item = make_shared<T>();
+		if (items_.size() < maxItems_)
+		{
+			items_.push_back(item);
+		}
+		return item;
+	}
+};
+
+// 틱마다 게임 루프가 한 번 만드는 스냅샷 재료 (모든 세션이 공유, 읽기 전용)
+// 더미는 JSON 조각을 미리 만들어 두고 세션은 고른 조각만 이어 붙인다
+struct SnapshotFrame
+{
+	struct Entity
+	{
+		int id;
+		Vector3 position;
+		float speed;
+		uint32_t offset; // text 안의 JSON 조각 위치
+		uint32_t length;
+	};
+
+	uint32_t tick = 0;
+	string playersJson; // 플레이어 배열 "[...]" (플레이어는 항상 전부 보낸다)
+	vector<pair<int, Vector3>> playerPositions; // 거리 계산용
+	vector<Entity> dummies;
+	string dummyText;
+
+	void clear()
+	{
+		playersJson.clear();
+		playerPositions.clear();
+		dummies.clear();
+		dummyText.clear();
+	}
+
+	// {"id":1,"pos":[x,y,z]} (SnapshotJson.h)
+	void addDummy(int id, const Vector3 &position, const Vector3 &velocity)
+	{
+		char text[DUMMY_JSON_MAX_BYTES];
+		size_t length = writeDummyJson(text, id, position);
+		float speed = sqrtf(velocity.x * velocity.x + velocity.y * velocity.y + velocity.z * velocity.z);
+		dummies.push_back({ id, position, speed, static_cast<uint32_t>(dummyText.size()), static_cast<uint32_t>(length) });
+		dummyText.append(text, length);
+	}
+};
+
+// 세션별 스냅샷 스케줄러 (세션의 샤드 스레드에서만 사용)
+// - 바이트 예산 안에서 우선순위가 높은 더미부터 채운다
+// - 우선순위는 매 틱 누적된다: 가까울수록, 빠를수록 많이 쌓이고, 보내면 0으로 돌아간다
+//   -> 멀리 있거나 멈춘 더미도 오래 밀리면 결국 보내진다
+// - 적응형이면 쓰기 완료 지연으로 예산을 조절 (AIMD: 밀리면 줄이고, 아니면 천천히 늘림)
+// 예산에 다 들어가면 전체 스냅샷, 아니면 "partial": true (클라이언트는 빠진 더미를 마지막 위치로 유지)
+class SnapshotScheduler
+{
+public:
+	struct Options
+	{
+		int budgetKbps = 0;    // 최대(초기) 예산, 0이면 스케줄러 안 씀
+		bool adaptive = false; // 쓰기 지연에 따라 예산 조절
+		int tickRate = 60;
+	};
+
+	// 우선순위 가중치
+	static constexpr float DISTANCE_SCALE = 5.0f;  // m, 이 거리에서 가중치 절반
+	static constexpr float SPEED_WEIGHT = 0.5f;    // m/s 당 추가 가중치
+	static constexpr float NEW_ENTITY_PRIORITY = 1000.0f; // 처음 보는 더미는 바로 보내도록
+
+	// 적응형 예산
+	static constexpr float MIN_BUDGET_BYTES = 8 * 1024.0f;   // 초당
+	static constexpr float DECREASE_FACTOR = 0.75f;
+	static constexpr float INCREASE_FRACTION = 0.02f;         // 쓰기 완료당 최대 예산의 2%
+	const chrono::milliseconds DECREASE_COOLDOWN{ 200 };
+
+private:
+	struct Accumulator
+	{
+		int id = -1;
+		float priority = 0.0f;
+	};
+
+	Options options_;
+	float maxBudgetBytes_;
+	float budgetBytes_;
+	chrono::steady_clock::time_point lastDecrease_;
+
+	vector<Accumulator> accumulators_; // 프레임의 더미 인덱스별 (id가 바뀌면 새 더미로 보고 초기화)
+	vector<uint32_t> order_;           // 선택용 스크래치
+	vector<uint32_t> selected_;
+
+	uint32_t lastSent_ = 0;
+	uint32_t lastTotal_ = 0;
+
+public:
+	explicit SnapshotScheduler(const Options &options)
+		: options_(options)
+		, maxBudgetBytes_(options.budgetKbps * 1000.0f / 8.0f)
+		, budgetBytes_(maxBudgetBytes_)
+	{
+	}
+
+	uint32_t lastSent() const { return lastSent_; }
+	uint32_t lastTotal() const { return lastTotal_; }
+	float budgetBytesPerSecond() const { return budgetBytes_; }
+
+	// 이번 틱 스냅샷을 out에 쓴다 (out은 비워서 재사용, 용량이 충분하면 할당 없음)
+	void build(const SnapshotFrame &frame, int playerId, string &out)
+	{
+		Vector3 origin;
+		for (const auto &player : frame.playerPositions)
+		{
+			if (player.first == playerId)
+			{
+				origin = player.second;
+				break;
+			}
+		}
+
+		const size_t count = frame.dummies.size();
+		if (accumulators_.size() != count)
+			accumulators_.resize(count);
+
+		// 우선순위 누적
+		size_t totalBytes = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const SnapshotFrame::Entity &entity = frame.dummies[i];
+			Accumulator &accumulator = accumulators_[i];
+			if (accumulator.id != entity.id)
+			{
+				accumulator.id = entity.id;
+				accumulator.priority = NEW_ENTITY_PRIORITY;
+			}
+
+			float dx = entity.position.x - origin.x;
+			float dy = entity.position.y - origin.y;
+			float dz = entity.position.z - origin.z;
+			float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+			accumulator.priority += (1.0f + entity.speed * SPEED_WEIGHT) / (1.0f + distance / DISTANCE_SCALE);
+
+			totalBytes += entity.length + 1;
+		}
+
+		// 고정 부분(헤더 + 플레이어)을 뺀 나머지가 더미 예산
+		static const size_t HEADER_BYTES = 96;
+		size_t tickBudget = static_cast<size_t>(budgetBytes_ / max(1, options_.tickRate));
+		size_t fixedBytes = HEADER_BYTES + frame.playersJson.size();
+		size_t dummyBudget = tickBudget > fixedBytes ? tickBudget - fixedBytes : 0;
+
+		selected_.clear();
+		bool partial = totalBytes > dummyBudget;
+		if (!partial)
+		{
+			for (size_t i = 0; i < count; ++i)
+				selected_.push_back(static_cast<uint32_t>(i));
+		}
+		else if (count > 0)
+		{
+			// 평균 크기로 몇 개 들어갈지 어림잡고 상위 그만큼만 부분 정렬 없이 골라낸다 (O(n))
+			size_t average = max<size_t>(1, totalBytes / count);
+			size_t candidates = min(count, dummyBudget / average + 1);
+
+			order_.resize(count);
+			for (size_t i = 0; i < count; ++i)
+				order_[i] = static_cast<uint32_t>(i);
+			nth_element(order_.begin(), order_.begin() + (candidates - 1), order_.end(),
+				[this](uint32_t a, uint32_t b) { return accumulators_[a].priority > accumulators_[b].priority; });
+
+			size_t used = 0;
+			for (size_t i = 0; i < candidates; ++i)
+			{
+				uint32_t index = order_[i];
+				size_t bytes = frame.dummies[index].length + 1;
+				if (used + bytes > dummyBudget)
+					continue;
+				used += bytes;
+				selected_.push_back(index);
+			}
+			// 클라이언트가 만드는 순서와 비슷하게 (필수는 아님)
+			sort(selected_.begin(), selected_.end());
+		}
+
+		for (uint32_t index : selected_)
+			accumulators_[index].priority = 0.0f;
+
+		lastSent_ = static_cast<uint32_t>(selected_.size());
+		lastTotal_ = static_cast<uint32_t>(count);
+
+		// {"type":4,"tick":T[,"partial":true,"dummyCount":N],"players":[...],"dummies":[...]}
+		char header[HEADER_BYTES];
+		int headerLength = partial
+			? snprintf(header, sizeof(header), "{\"type\":4,\"tick\":%u,\"partial\":true,\"dummyCount\":%u,\"players\":", frame.tick, lastTotal_)
+			: snprintf(header, sizeof(header), "{\"type\":4,\"tick\":%u,\"players\":", frame.tick);
+
+		out.clear();
+		out.append(header, static_cast<size_t>(headerLength));
+		out += frame.playersJson;
+		out += ",\"dummies\":[";
+		for (size_t i = 0; i < selected_.size(); ++i)
+		{
+			const SnapshotFrame::Entity &entity = frame.dummies[selected_[i]];
+			if (i > 0)
+				out += ',';
+			out.append(frame.dummyText, entity.offset, entity.length);
+		}
+		out += "]}";
+	}
+
+	// 쓰기 완료 통보 (적응형 예산)
+	// 웹소켓 쓰기는 커널 송신 버퍼에 다 들어가야 완료되므로, 한 틱보다 오래 걸리면 링크가 못 따라오는 것
+	void onWriteCompleted(chrono::microseconds latency)
+	{
+		if (!options_.adaptive)
+			return;
+
+		auto now = chrono::steady_clock::now();
+		if (latency > chrono::microseconds(1000000 / max(1, options_.tickRate)))
+		{
+			if (now - lastDecrease_ >= DECREASE_COOLDOWN)
+			{
+				budgetBytes_ = max(MIN_BUDGET_BYTES, budgetBytes_ * DECREASE_FACTOR);
+				lastDecrease_ = now;
+			}
+		}
+		else
+		{
+			budgetBytes_ = min(maxBudgetBytes_, budgetBytes_ + maxBudgetBytes_ * INCREASE_FRACTION);
+		}
+	}
+};
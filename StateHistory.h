@@ -0,0 +1,242 @@
+#pragma once
+#include <PxPhysicsAPI.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <iostream>
+
+using namespace physx;
+using namespace std;
+
+// 랙 보정용 틱별 상태 기록 (링 버퍼)
+// - 최근 CAPACITY 틱의 플레이어/더미 트랜스폼을 SoA로 보관
+// - 메모리는 reserveDummies()에서만 잡고, 매 틱 기록은 할당 없이 float 복사만 한다
+// - 레이아웃: [프레임][성분(x,y,z,qx,qy,qz,qw)][엔티티] -> 성분별로 연속이라 복사/보간이 선형 접근
+// - 플레이어 슬롯 수는 생성 시 정한다 (서버 정원 --max-players)
+class StateHistory
+{
+public:
+	static const int CAPACITY = 64;       // 60Hz 기준 약 1초 (2의 거듭제곱)
+	static const int COMPONENTS = 7;      // 위치 3 + 회전 4
+
+	struct FrameInfo
+	{
+		uint32_t tick = 0;
+		bool valid = false;
+		uint32_t dummyCount = 0;
+		uint32_t dummySetVersion = 0; // 더미 구성(추가/삭제) 버전, 같으면 인덱스 정렬이 같다
+	};
+
+private:
+	array<FrameInfo, CAPACITY> frames_;
+	int playerSlots_;
+	vector<float> playerData_;   // CAPACITY * COMPONENTS * playerSlots_
+	vector<uint8_t> playerRecorded_; // CAPACITY * playerSlots_, 그 프레임에 기록된 플레이어 슬롯
+	vector<float> dummyData_;    // CAPACITY * COMPONENTS * dummyCapacity_
+	vector<int32_t> dummyIds_;   // CAPACITY * dummyCapacity_
+	size_t dummyCapacity_ = 0;
+	uint32_t head_ = 0;          // 다음에 기록할 프레임
+
+public:
+	explicit StateHistory(int playerSlots = 50)
+		: playerSlots_(std::max(1, playerSlots)),
+		playerData_(static_cast<size_t>(CAPACITY) * COMPONENTS * playerSlots_, 0.0f),
+		playerRecorded_(static_cast<size_t>(CAPACITY) * playerSlots_, 0)
+	{
+	}
+
+	int playerSlots() const { return playerSlots_; }
+
+	// 더미 수용량 확보 (스폰 시점에 호출, 틱 중에는 할당하지 않기 위함)
+	// 수용량이 바뀌면 기존 더미 기록은 버린다
+	void reserveDummies(size_t count)
+	{
+		if (count <= dummyCapacity_)
+			return;
+
+		size_t capacity = dummyCapacity_ == 0 ? 1024 : dummyCapacity_;
+		while (capacity < count)
+			capacity *= 2;
+
+		dummyCapacity_ = capacity;
+		dummyData_.assign(static_cast<size_t>(CAPACITY) * COMPONENTS * capacity, 0.0f);
+		dummyIds_.assign(static_cast<size_t>(CAPACITY) * capacity, -1);
+		for (auto &frame : frames_)
+		{
+			frame.dummyCount = 0;
+		}
+	}
+
+	size_t dummyCapacity() const { return dummyCapacity_; }
+	size_t memoryBytes() const
+	{
+		return playerData_.size() * sizeof(float) + playerRecorded_.size() + dummyData_.size() * sizeof(float) + dummyIds_.size() * sizeof(int32_t);
+	}
+
+	// ---- 기록 ----
+
+	// 새 프레임 슬롯을 열고 인덱스 반환 (가장 오래된 프레임을 덮어씀)
+	int beginFrame(uint32_t tick, uint32_t dummySetVersion)
+	{
+		int frame = static_cast<int>(head_);
+		head_ = (head_ + 1) & (CAPACITY - 1);
+
+		FrameInfo &info = frames_[frame];
+		info.tick = tick;
+		info.valid = true;
+		info.dummyCount = 0;
+		fill_n(&playerRecorded_[static_cast<size_t>(frame) * playerSlots_], playerSlots_, uint8_t(0));
+		info.dummySetVersion = dummySetVersion;
+		return frame;
+	}
+
+	// slot은 [0, playerSlots())
+	void writePlayer(int frame, int slot, const PxTransform &pose)
+	{
+		writeComponents(playerColumn(frame, 0), playerSlots_, slot, pose);
+		playerRecorded_[static_cast<size_t>(frame) * playerSlots_ + slot] = 1;
+	}
+
+	// 더미는 dense 인덱스 순서대로 기록 (수용량 초과분은 기록하지 않음)
+	void writeDummy(int frame, uint32_t index, int id, const PxTransform &pose)
+	{
+		if (!writeDummyPose(frame, index, id, pose))
+			return;
+		if (index + 1 > frames_[frame].dummyCount)
+			frames_[frame].dummyCount = index + 1;
+	}
+
+	// 프레임 정보는 건드리지 않는 버전 (서로 다른 index면 여러 스레드에서 동시에 써도 된다)
+	// 다 쓴 뒤 setDummyCount로 개수를 한 번에 기록
+	bool writeDummyPose(int frame, uint32_t index, int id, const PxTransform &pose)
+	{
+		if (index >= dummyCapacity_)
+			return false;
+		writeComponents(dummyColumn(frame, 0), dummyCapacity_, index, pose);
+		dummyIds_[static_cast<size_t>(frame) * dummyCapacity_ + index] = id;
+		return true;
+	}
+
+	void setDummyCount(int frame, uint32_t count)
+	{
+		frames_[frame].dummyCount = static_cast<uint32_t>(std::min<size_t>(count, dummyCapacity_));
+	}
+
+	// ---- 조회 ----
+
+	// viewTick(소수 허용)을 감싸는 두 프레임과 보간 비율 찾기
+	// 기록 범위 밖이면 가장 가까운 끝 프레임으로 고정
+	bool findFrames(double viewTick, int &older, int &newer, float &alpha) const
+	{
+		int best0 = -1, best1 = -1;
+		for (int i = 0; i < CAPACITY; ++i)
+		{
+			const FrameInfo &info = frames_[i];
+			if (!info.valid)
+				continue;
+			if (info.tick <= viewTick && (best0 < 0 || info.tick > frames_[best0].tick))
+				best0 = i;
+			if (info.tick >= viewTick && (best1 < 0 || info.tick < frames_[best1].tick))
+				best1 = i;
+		}
+		if (best0 < 0 && best1 < 0)
+			return false;
+		if (best0 < 0) best0 = best1;
+		if (best1 < 0) best1 = best0;
+
+		older = best0;
+		newer = best1;
+		uint32_t span = frames_[newer].tick - frames_[older].tick;
+		alpha = span == 0 ? 0.0f : static_cast<float>((viewTick - frames_[older].tick) / span);
+		return true;
+	}
+
+	const FrameInfo &frameInfo(int frame) const { return frames_[frame]; }
+
+	bool hasPlayer(int frame, int slot) const
+	{
+		return playerRecorded_[static_cast<size_t>(frame) * playerSlots_ + slot] != 0;
+	}
+
+	int dummyId(int frame, uint32_t index) const
+	{
+		return dummyIds_[static_cast<size_t>(frame) * dummyCapacity_ + index];
+	}
+
+	PxTransform playerPose(int frame, int slot) const
+	{
+		return readComponents(playerColumn(frame, 0), playerSlots_, slot);
+	}
+
+	PxTransform dummyPose(int frame, uint32_t index) const
+	{
+		return readComponents(dummyColumn(frame, 0), dummyCapacity_, index);
+	}
+
+	// 두 포즈 보간 (위치 lerp, 회전 nlerp)
+	static PxTransform interpolate(const PxTransform &a, const PxTransform &b, float t)
+	{
+		PxVec3 p(a.p.x + (b.p.x - a.p.x) * t, a.p.y + (b.p.y - a.p.y) * t, a.p.z + (b.p.z - a.p.z) * t);
+
+		// 최단 경로로 보간
+		float dot = a.q.x * b.q.x + a.q.y * b.q.y + a.q.z * b.q.z + a.q.w * b.q.w;
+		float sign = dot < 0.0f ? -1.0f : 1.0f;
+		float qx = a.q.x + (b.q.x * sign - a.q.x) * t;
+		float qy = a.q.y + (b.q.y * sign - a.q.y) * t;
+		float qz = a.q.z + (b.q.z * sign - a.q.z) * t;
+		float qw = a.q.w + (b.q.w * sign - a.q.w) * t;
+		float len = sqrtf(qx * qx + qy * qy + qz * qz + qw * qw);
+		if (len > 0.0f)
+		{
+			qx /= len; qy /= len; qz /= len; qw /= len;
+		}
+		return PxTransform(p, PxQuat(qx, qy, qz, qw));
+	}
+
+	void clear()
+	{
+		for (auto &frame : frames_)
+		{
+			frame.valid = false;
+		}
+	}
+
+private:
+	float *playerColumn(int frame, int component)
+	{
+		return &playerData_[(static_cast<size_t>(frame) * COMPONENTS + component) * playerSlots_];
+	}
+	const float *playerColumn(int frame, int component) const
+	{
+		return &playerData_[(static_cast<size_t>(frame) * COMPONENTS + component) * playerSlots_];
+	}
+	float *dummyColumn(int frame, int component)
+	{
+		return &dummyData_[(static_cast<size_t>(frame) * COMPONENTS + component) * dummyCapacity_];
+	}
+	const float *dummyColumn(int frame, int component) const
+	{
+		return &dummyData_[(static_cast<size_t>(frame) * COMPONENTS + component) * dummyCapacity_];
+	}
+
+	// base부터 성분별로 stride 간격의 열에 기록
+	static void writeComponents(float *base, size_t stride, size_t index, const PxTransform &pose)
+	{
+		base[0 * stride + index] = pose.p.x;
+		base[1 * stride + index] = pose.p.y;
+		base[2 * stride + index] = pose.p.z;
+		base[3 * stride + index] = pose.q.x;
+		base[4 * stride + index] = pose.q.y;
+		base[5 * stride + index] = pose.q.z;
+		base[6 * stride + index] = pose.q.w;
+	}
+
+	static PxTransform readComponents(const float *base, size_t stride, size_t index)
+	{
+		return PxTransform(
+			PxVec3(base[0 * stride + index], base[1 * stride + index], base[2 * stride + index]),
+			PxQuat(base[3 * stride + index], base[4 * stride + index], base[5 * stride + index], base[6 * stride + index]));
+	}
+};
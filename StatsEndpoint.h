@@ -0,0 +1,160 @@
+#pragma once
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include "Logger.h"
+
+using namespace std;
+
+// 로컬 통계 조회 (127.0.0.1 전용 HTTP)
+// curl http://127.0.0.1:<port>/stats -> render()가 만든 JSON
+// 운영 명령은 POST (addCommand로 등록): curl -X POST "http://127.0.0.1:<port>/pvd-capture?ticks=300"
+// 요청 하나 처리하고 연결을 닫는다 (운영 도구용, 동시 접속 많지 않음)
+class StatsEndpoint
+{
+public:
+	using Renderer = function<string()>;
+	using Command = function<string(const string &query)>; // 쿼리 문자열("a=1&b=2") -> 응답 본문
+	using Commands = map<string, Command>;
+
+private:
+	using tcp = boost::asio::ip::tcp;
+
+	class Connection : public enable_shared_from_this<Connection>
+	{
+	private:
+		tcp::socket socket_;
+		boost::beast::flat_buffer buffer_;
+		boost::beast::http::request<boost::beast::http::string_body> request_;
+		boost::beast::http::response<boost::beast::http::string_body> response_;
+		const Renderer &render_;
+		const Commands &commands_;
+
+	public:
+		Connection(tcp::socket socket, const Renderer &render, const Commands &commands)
+			: socket_(move(socket)), render_(render), commands_(commands)
+		{
+		}
+
+		void run()
+		{
+			namespace http = boost::beast::http;
+			http::async_read(socket_, buffer_, request_,
+				[self = shared_from_this()](boost::beast::error_code ec, size_t)
+				{
+					if (ec)
+						return;
+					self->respond();
+				});
+		}
+
+	private:
+		void respond()
+		{
+			namespace http = boost::beast::http;
+			response_.version(request_.version());
+			response_.keep_alive(false);
+
+			string target(request_.target());
+			size_t question = target.find('?');
+			string path = target.substr(0, question);
+			string query = question == string::npos ? string() : target.substr(question + 1);
+			auto command = commands_.find(path);
+
+			if (request_.method() == http::verb::get && (path == "/stats" || path == "/"))
+			{
+				response_.result(http::status::ok);
+				response_.set(http::field::content_type, "application/json");
+				response_.body() = render_();
+			}
+			else if (request_.method() == http::verb::post && command != commands_.end())
+			{
+				response_.result(http::status::ok);
+				response_.set(http::field::content_type, "application/json");
+				response_.body() = command->second(query);
+			}
+			else
+			{
+				response_.result(http::status::not_found);
+				response_.set(http::field::content_type, "text/plain");
+				string usage = "GET /stats\n";
+				for (const auto &pair : commands_)
+					usage += "POST " + pair.first + "\n";
+				response_.body() = usage;
+			}
+			response_.prepare_payload();
+
+			http::async_write(socket_, response_,
+				[self = shared_from_this()](boost::beast::error_code, size_t)
+				{
+					boost::beast::error_code ignored;
+					self->socket_.shutdown(tcp::socket::shutdown_send, ignored);
+				});
+		}
+	};
+
+	tcp::acceptor acceptor_;
+	Renderer render_;
+	Commands commands_;
+
+public:
+	StatsEndpoint(boost::asio::io_context &ioc, int port, Renderer render)
+		: acceptor_(ioc, tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), static_cast<unsigned short>(port)))
+		, render_(move(render))
+	{
+	}
+
+	// start 전에 등록 (핸들러는 이 엔드포인트의 io_context 스레드에서 불린다)
+	void addCommand(const string &path, Command command)
+	{
+		commands_[path] = move(command);
+	}
+
+	// "ticks=300&x=1" 에서 key의 값 (없으면 fallback)
+	static string queryValue(const string &query, const string &key, const string &fallback = string())
+	{
+		size_t pos = 0;
+		while (pos <= query.size())
+		{
+			size_t end = query.find('&', pos);
+			if (end == string::npos)
+				end = query.size();
+			size_t equals = query.find('=', pos);
+			if (equals != string::npos && equals < end && query.compare(pos, equals - pos, key) == 0 && equals - pos == key.size())
+				return query.substr(equals + 1, end - equals - 1);
+			pos = end + 1;
+		}
+		return fallback;
+	}
+
+	void start()
+	{
+		doAccept();
+	}
+
+private:
+	void doAccept()
+	{
+		acceptor_.async_accept(
+			[this](boost::beast::error_code ec, tcp::socket socket)
+			{
+				if (!ec)
+				{
+					make_shared<Connection>(move(socket), render_, commands_)->run();
+				}
+				else if (ec == boost::asio::error::operation_aborted)
+				{
+					return;
+				}
+				else
+				{
+					LOG_EVERY_MS(LogLevel::WARN, 1000) << "Stats accept failed: " << ec.message();
+				}
+				doAccept();
+			});
+	}
+};
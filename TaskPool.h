@@ -0,0 +1,203 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// 게임 루프용 작업 훔치기 스레드 풀 (청크 단위 parallel-for 전용)
+// - 범위를 grain 크기 청크로 나눠 참여자(호출 스레드 + 워커)마다 연속 구간씩 나눠 준다
+// - 참여자는 자기 덱 앞에서 꺼내고(캐시 지역성), 비면 다른 참여자 덱 뒤에서 훔친다
+// - 호출 스레드도 일하므로 워커가 늦게 깨어나도 그만큼 덜 훔칠 뿐 기다리지 않는다
+// - 한 번에 작업 하나 (제출이 겹치면 순서대로), func는 예외를 던지면 안 된다
+// - 청크 안에서 PhysX 쓰기 금지: 읽기만 하고 쓰기는 결과를 모아 호출 스레드에서 적용
+class TaskPool
+{
+private:
+	struct Chunk
+	{
+		size_t begin;
+		size_t end;
+	};
+
+	// 청크 덱: [head, chunks.size()) 가 남은 청크, 앞은 주인이 꺼내고 뒤는 도둑이 꺼낸다
+	// 비면 clear해서 용량을 재사용 (deque는 노드 경계를 넘을 때마다 할당/해제하므로 vector로)
+	struct alignas(64) Participant
+	{
+		mutex lock;
+		vector<Chunk> chunks;
+		size_t head = 0;
+	};
+
+	vector<unique_ptr<Participant>> participants_; // 0번 = 호출 스레드
+	vector<thread> workers_;
+
+	// 현재 작업 (청크를 넣기 전에 설정, 덱 잠금이 가시성을 보장)
+	void (*invoke_)(void *, size_t, size_t) = nullptr;
+	void *context_ = nullptr;
+	atomic<size_t> remaining_{ 0 };
+
+	mutex submitMutex_;
+	mutex wakeMutex_;
+	condition_variable wake_;
+	uint64_t generation_ = 0;
+	bool stopping_ = false;
+
+	atomic<long long> steals_{ 0 };
+	atomic<long long> jobs_{ 0 };
+
+public:
+	// threads: 호출 스레드를 포함한 참여자 수 (1이면 워커 없이 항상 호출 스레드에서)
+	explicit TaskPool(int threads)
+	{
+		int count = std::max(1, threads);
+		for (int i = 0; i < count; ++i)
+			participants_.push_back(make_unique<Participant>());
+		for (int i = 1; i < count; ++i)
+			workers_.emplace_back([this, i] { workerLoop(i); });
+	}
+
+	~TaskPool()
+	{
+		{
+			lock_guard<mutex> lock(wakeMutex_);
+			stopping_ = true;
+		}
+		wake_.notify_all();
+		for (auto &worker : workers_)
+			worker.join();
+	}
+
+	TaskPool(const TaskPool &) = delete;
+	TaskPool &operator=(const TaskPool &) = delete;
+
+	int threadCount() const { return static_cast<int>(participants_.size()); }
+	long long steals() const { return steals_; }
+	long long jobs() const { return jobs_; }
+
+	// [0, count)를 grain 크기 청크로 나눠 func(begin, end) 실행, 모두 끝나면 반환
+	// 청크 경계는 항상 grain의 배수 (SIMD 정렬이 필요하면 grain을 맞춰 준다)
+	template <typename F>
+	void parallelFor(size_t count, size_t grain, F &&func)
+	{
+		grain = std::max<size_t>(1, grain);
+		if (count == 0)
+			return;
+		if (participants_.size() == 1 || count <= grain)
+		{
+			func(size_t(0), count);
+			return;
+		}
+
+		lock_guard<mutex> submit(submitMutex_);
+		using Func = typename remove_reference<F>::type;
+		invoke_ = [](void *context, size_t begin, size_t end) { (*static_cast<Func *>(context))(begin, end); };
+		context_ = const_cast<void *>(static_cast<const void *>(&func));
+
+		size_t chunkCount = (count + grain - 1) / grain;
+		size_t participantCount = participants_.size();
+		remaining_.store(chunkCount, memory_order_relaxed);
+
+		// 참여자마다 연속된 청크 구간 (앞쪽 참여자가 하나씩 더 가져간다)
+		size_t next = 0;
+		for (size_t p = 0; p < participantCount; ++p)
+		{
+			size_t share = chunkCount / participantCount + (p < chunkCount % participantCount ? 1 : 0);
+			Participant &participant = *participants_[p];
+			lock_guard<mutex> lock(participant.lock);
+			for (size_t c = 0; c < share; ++c, ++next)
+				participant.chunks.push_back(Chunk{ next * grain, std::min(count, (next + 1) * grain) });
+		}
+
+		{
+			lock_guard<mutex> lock(wakeMutex_);
+			generation_++;
+		}
+		wake_.notify_all();
+		jobs_.fetch_add(1, memory_order_relaxed);
+
+		runChunks(0);
+		// 남은 건 다른 참여자가 이미 꺼내서 실행 중인 청크뿐
+		while (remaining_.load(memory_order_acquire) != 0)
+			this_thread::yield();
+	}
+
+private:
+	static void clearChunks(Participant &participant)
+	{
+		participant.chunks.clear();
+		participant.head = 0;
+	}
+
+	bool popOwn(size_t index, Chunk &chunk)
+	{
+		Participant &participant = *participants_[index];
+		lock_guard<mutex> lock(participant.lock);
+		if (participant.head == participant.chunks.size())
+			return false;
+		chunk = participant.chunks[participant.head++];
+		if (participant.head == participant.chunks.size())
+			clearChunks(participant);
+		return true;
+	}
+
+	bool steal(size_t thief, Chunk &chunk)
+	{
+		size_t count = participants_.size();
+		for (size_t offset = 1; offset < count; ++offset)
+		{
+			Participant &victim = *participants_[(thief + offset) % count];
+			lock_guard<mutex> lock(victim.lock);
+			if (victim.head == victim.chunks.size())
+				continue;
+			chunk = victim.chunks.back();
+			victim.chunks.pop_back();
+			if (victim.head == victim.chunks.size())
+				clearChunks(victim);
+			steals_.fetch_add(1, memory_order_relaxed);
+			return true;
+		}
+		return false;
+	}
+
+	void runChunks(size_t index)
+	{
+		Chunk chunk;
+		while (popOwn(index, chunk) || steal(index, chunk))
+		{
+			invoke_(context_, chunk.begin, chunk.end);
+			remaining_.fetch_sub(1, memory_order_acq_rel);
+		}
+	}
+
+	void workerLoop(size_t index)
+	{
+		uint64_t seen = 0;
+		while (true)
+		{
+			{
+				unique_lock<mutex> lock(wakeMutex_);
+				wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+				if (stopping_)
+					return;
+				seen = generation_;
+			}
+			runChunks(index);
+		}
+	}
+};
+
+// 풀이 없으면 (단일 스레드 설정) 호출 스레드에서 한 번에
+template <typename F>
+inline void parallelFor(TaskPool *pool, size_t count, size_t grain, F &&func)
+{
+	if (pool)
+		pool->parallelFor(count, grain, forward<F>(func));
+	else if (count > 0)
+		func(size_t(0), count);
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+// 틱 단위 해시드 타이머 휠
+// - 예약 O(1), 틱당 비용은 그 틱 슬롯에 걸린 항목 수에만 비례 (전체 개수와 무관)
+// - SLOTS보다 먼 예약은 같은 슬롯에서 바퀴 수만큼 기다린다
+// - 취소는 없음: 발화 시점에 호출자가 유효한 예약인지 확인 (예약 틱 비교 등)
+template <typename T>
+class TimerWheel
+{
+private:
+	static const uint32_t SLOTS = 256; // 2의 거듭제곱
+
+	struct Entry
+	{
+		T value;
+		uint32_t dueTick;
+	};
+
+	array<vector<Entry>, SLOTS> slots_;
+	vector<T> fired_; // 발화 콜백 중 재예약이 같은 슬롯을 건드려도 안전하도록 분리
+	uint32_t currentTick_ = 0;
+	size_t size_ = 0;
+
+public:
+	explicit TimerWheel(uint32_t startTick = 0)
+		: currentTick_(startTick)
+	{
+	}
+
+	// dueTick이 이미 지났으면 다음 틱에 발화
+	void schedule(T value, uint32_t dueTick)
+	{
+		if (static_cast<int32_t>(dueTick - currentTick_) <= 0)
+			dueTick = currentTick_ + 1;
+		slots_[dueTick & (SLOTS - 1)].push_back({ value, dueTick });
+		size_++;
+	}
+
+	// tick까지 진행하며 만기된 항목마다 fire(value) 호출
+	template <typename F>
+	void advance(uint32_t tick, F &&fire)
+	{
+		while (static_cast<int32_t>(tick - currentTick_) > 0)
+		{
+			currentTick_++;
+			vector<Entry> &slot = slots_[currentTick_ & (SLOTS - 1)];
+
+			fired_.clear();
+			size_t keep = 0;
+			for (size_t i = 0; i < slot.size(); ++i)
+			{
+				if (slot[i].dueTick == currentTick_)
+					fired_.push_back(slot[i].value);
+				else
+					slot[keep++] = slot[i];
+			}
+			slot.resize(keep);
+			size_ -= fired_.size();
+
+			for (const T &value : fired_)
+			{
+				fire(value);
+			}
+		}
+	}
+
+	uint32_t currentTick() const { return currentTick_; }
+	size_t size() const { return size_; }
+
+	void clear()
+	{
+		for (auto &slot : slots_)
+		{
+			slot.clear();
+		}
+		size_ = 0;
+	}
+};
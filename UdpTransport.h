@@ -0,0 +1,388 @@
+#pragma once
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/post.hpp>
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "GameObject.h"
+#include "Logger.h"
+
+using namespace std;
+
+// UDP 데이터 채널
+// - 웹소켓 JOIN_RESPONSE 뒤에 UDP_OFFER(포트, 토큰)를 보내고, 클라이언트가 HELLO로 주소를 등록
+// - 스냅샷: 비신뢰, 시퀀스 번호, MTU 단위 분할, 최신 것만 유효 (밀린 조각은 버림)
+// - 입력: 시퀀스 번호가 더 큰 것만 적용
+// - 패킷은 리틀엔디언 고정 레이아웃 (x86/ARM 서버 기준)
+
+enum UdpPacketType : uint8_t
+{
+	UDP_HELLO = 1,     // C->S: 토큰 등록
+	UDP_HELLO_ACK = 2, // S->C
+	UDP_SNAPSHOT = 3,  // S->C: 스냅샷 조각
+	UDP_INPUT = 4,     // C->S: 이동 입력
+};
+
+#pragma pack(push, 1)
+struct UdpHelloPacket
+{
+	uint8_t type;
+	uint64_t token;
+};
+
+struct UdpSnapshotHeader
+{
+	uint8_t type;
+	uint32_t sequence;
+	uint16_t fragmentIndex;
+	uint16_t fragmentCount;
+};
+
+struct UdpInputPacket
+{
+	uint8_t type;
+	uint64_t token;
+	uint32_t sequence;
+	float x, y, z;
+};
+#pragma pack(pop)
+
+// 시퀀스 번호 비교 (wrap-around 고려)
+inline bool sequenceNewer(uint32_t a, uint32_t b)
+{
+	return static_cast<int32_t>(a - b) > 0;
+}
+
+class UdpTransport
+{
+public:
+	using udp = boost::asio::ip::udp;
+	using InputHandler = function<void(int playerId, const Vector3 &movement)>;
+
+	struct Options
+	{
+		int port = 0;
+		int mtu = 1200;        // UDP 페이로드 상한 (헤더 포함)
+		int rateKbps = 0;      // 클라이언트당 송신 속도 제한, 0이면 무제한
+		float lossRate = 0.0f; // 손실 시뮬레이션 (송수신 양방향), 0~1
+	};
+
+private:
+	struct Peer
+	{
+		int playerId = -1;
+		function<void()> onBound; // HELLO 수신 시 호출 (세션이 웹소켓 스냅샷을 끄도록)
+
+		udp::endpoint endpoint;
+		bool bound = false;
+		uint32_t lastInputSequence = 0;
+		bool hasInput = false;
+
+		// 송신 페이싱 (토큰 버킷)
+		float tokens = 0.0f;
+		chrono::steady_clock::time_point lastRefill;
+
+		// 보내는 중인 스냅샷 (새 스냅샷이 오면 남은 조각은 버림)
+		shared_ptr<const string> pending;
+		uint32_t pendingSequence = 0;
+		uint16_t nextFragment = 0;
+		uint16_t fragmentCount = 0;
+	};
+
+	boost::asio::io_context &ioc_;
+	udp::socket socket_;
+	Options options_;
+	InputHandler onInput_;
+
+	// 아래는 모두 ioc_ 스레드에서만 접근
+	unordered_map<uint64_t, Peer> peers_;
+	uint32_t sequence_ = 0;
+	array<char, 2048> recvBuffer_;
+	udp::endpoint remote_;
+	vector<char> sendBuffer_;
+	boost::asio::steady_timer paceTimer_;
+	mt19937 rng_;
+	uniform_real_distribution<float> lossDist_{ 0.0f, 1.0f };
+
+	atomic<uint64_t> tokenCounter_;
+	uint64_t tokenSeed_;
+
+	const chrono::milliseconds PACE_INTERVAL{ 5 };
+
+public:
+	// 통계 (상태 화면용)
+	atomic<long long> packetsOut{ 0 };
+	atomic<long long> packetsIn{ 0 };
+	atomic<long long> packetsLost{ 0 };       // 손실 시뮬레이션으로 버린 패킷
+	atomic<long long> fragmentsSkipped{ 0 };  // 새 스냅샷에 밀려 못 보낸 조각
+	atomic<long long> bytesOut{ 0 };
+
+	UdpTransport(boost::asio::io_context &ioc, const Options &options, InputHandler onInput)
+		: ioc_(ioc)
+		, socket_(ioc, udp::endpoint(udp::v4(), static_cast<unsigned short>(options.port)))
+		, options_(options)
+		, onInput_(move(onInput))
+		, sendBuffer_(static_cast<size_t>(std::max<int>(options.mtu, sizeof(UdpSnapshotHeader) + 1)))
+		, paceTimer_(ioc)
+		, rng_(random_device{}())
+		, tokenCounter_(0)
+	{
+		// 블로킹 없이 보내고, 커널 버퍼가 차면 그 패킷은 버린다 (어차피 비신뢰)
+		socket_.non_blocking(true);
+
+		mt19937_64 seedRng(random_device{}());
+		tokenSeed_ = seedRng();
+	}
+
+	int port() const { return options_.port; }
+	int mtu() const { return options_.mtu; }
+
+	void start()
+	{
+		doReceive();
+		schedulePacing();
+	}
+
+	// 세션 토큰 발급 (스레드 안전)
+	// JSON 숫자로 주고받으므로 53비트 이내로 자른다
+	uint64_t nextToken()
+	{
+		uint64_t z = tokenSeed_ + (++tokenCounter_) * 0x9E3779B97F4A7C15ull;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		z ^= z >> 31;
+		return z & ((1ull << 53) - 1);
+	}
+
+	// 아래 API는 아무 스레드에서나 호출 가능 (ioc_ 스레드로 넘긴다)
+	void registerPeer(uint64_t token, int playerId, function<void()> onBound)
+	{
+		boost::asio::post(ioc_, [this, token, playerId, onBound = move(onBound)]()
+			{
+				Peer &peer = peers_[token];
+				peer.playerId = playerId;
+				peer.onBound = onBound;
+			});
+	}
+
+	void unregisterPeer(uint64_t token)
+	{
+		boost::asio::post(ioc_, [this, token]()
+			{
+				peers_.erase(token);
+			});
+	}
+
+	void sendSnapshot(shared_ptr<const string> snapshot)
+	{
+		boost::asio::post(ioc_, [this, snapshot = move(snapshot)]()
+			{
+				uint32_t sequence = ++sequence_;
+				size_t payloadPerFragment = sendBuffer_.size() - sizeof(UdpSnapshotHeader);
+				size_t count = (snapshot->size() + payloadPerFragment - 1) / payloadPerFragment;
+				if (count == 0 || count > UINT16_MAX)
+				{
+					LOG_EVERY_MS(LogLevel::WARN, 1000) << "UDP snapshot too large: " << snapshot->size() << " bytes";
+					return;
+				}
+
+				for (auto &pair : peers_)
+				{
+					Peer &peer = pair.second;
+					if (!peer.bound)
+						continue;
+
+					// 최신 것만 유효: 이전 스냅샷의 남은 조각 폐기
+					if (peer.pending)
+					{
+						fragmentsSkipped += peer.fragmentCount - peer.nextFragment;
+					}
+					peer.pending = snapshot;
+					peer.pendingSequence = sequence;
+					peer.nextFragment = 0;
+					peer.fragmentCount = static_cast<uint16_t>(count);
+
+					flushPeer(peer);
+				}
+			});
+	}
+
+private:
+	bool simulateLoss()
+	{
+		if (options_.lossRate > 0.0f && lossDist_(rng_) < options_.lossRate)
+		{
+			packetsLost++;
+			return true;
+		}
+		return false;
+	}
+
+	void sendPacket(const udp::endpoint &endpoint, const void *data, size_t size)
+	{
+		if (simulateLoss())
+			return;
+
+		boost::system::error_code ec;
+		socket_.send_to(boost::asio::buffer(data, size), endpoint, 0, ec);
+		if (!ec)
+		{
+			packetsOut++;
+			bytesOut += size;
+		}
+	}
+
+	void refillTokens(Peer &peer, chrono::steady_clock::time_point now)
+	{
+		if (options_.rateKbps <= 0)
+			return;
+
+		float bytesPerSec = options_.rateKbps * 1024.0f / 8.0f;
+		float burst = std::max(bytesPerSec * 0.05f, options_.mtu * 4.0f); // 50ms 분량
+		float elapsed = chrono::duration<float>(now - peer.lastRefill).count();
+		peer.tokens = std::min(burst, peer.tokens + elapsed * bytesPerSec);
+		peer.lastRefill = now;
+	}
+
+	// 토큰이 허락하는 만큼 조각 송신, 나머지는 페이싱 타이머가 이어서 보낸다
+	void flushPeer(Peer &peer)
+	{
+		if (!peer.pending)
+			return;
+
+		refillTokens(peer, chrono::steady_clock::now());
+
+		size_t payloadPerFragment = sendBuffer_.size() - sizeof(UdpSnapshotHeader);
+		const string &data = *peer.pending;
+
+		while (peer.nextFragment < peer.fragmentCount)
+		{
+			size_t offset = static_cast<size_t>(peer.nextFragment) * payloadPerFragment;
+			size_t length = std::min(payloadPerFragment, data.size() - offset);
+			size_t packetSize = sizeof(UdpSnapshotHeader) + length;
+
+			if (options_.rateKbps > 0)
+			{
+				if (peer.tokens < packetSize)
+					return;
+				peer.tokens -= packetSize;
+			}
+
+			UdpSnapshotHeader header;
+			header.type = UDP_SNAPSHOT;
+			header.sequence = peer.pendingSequence;
+			header.fragmentIndex = peer.nextFragment;
+			header.fragmentCount = peer.fragmentCount;
+			memcpy(sendBuffer_.data(), &header, sizeof(header));
+			memcpy(sendBuffer_.data() + sizeof(header), data.data() + offset, length);
+
+			sendPacket(peer.endpoint, sendBuffer_.data(), packetSize);
+			peer.nextFragment++;
+		}
+
+		peer.pending.reset();
+	}
+
+	void schedulePacing()
+	{
+		paceTimer_.expires_after(PACE_INTERVAL);
+		paceTimer_.async_wait([this](boost::system::error_code ec)
+			{
+				if (ec) return;
+				for (auto &pair : peers_)
+				{
+					flushPeer(pair.second);
+				}
+				schedulePacing();
+			});
+	}
+
+	void doReceive()
+	{
+		socket_.async_receive_from(
+			boost::asio::buffer(recvBuffer_), remote_,
+			[this](boost::system::error_code ec, size_t bytes)
+			{
+				if (ec == boost::asio::error::operation_aborted)
+					return;
+				if (!ec && bytes > 0 && !simulateLoss())
+				{
+					packetsIn++;
+					handlePacket(bytes);
+				}
+				doReceive();
+			});
+	}
+
+	void handlePacket(size_t bytes)
+	{
+		switch (static_cast<uint8_t>(recvBuffer_[0]))
+		{
+		case UDP_HELLO:
+		{
+			if (bytes < sizeof(UdpHelloPacket))
+				return;
+			UdpHelloPacket hello;
+			memcpy(&hello, recvBuffer_.data(), sizeof(hello));
+
+			auto it = peers_.find(hello.token);
+			if (it == peers_.end())
+				return;
+
+			// HELLO는 클라이언트가 ACK를 받을 때까지 재전송하므로 멱등하게 처리
+			Peer &peer = it->second;
+			peer.endpoint = remote_;
+			if (!peer.bound)
+			{
+				peer.bound = true;
+				peer.lastRefill = chrono::steady_clock::now();
+				if (peer.onBound)
+					peer.onBound();
+			}
+
+			uint8_t ack = UDP_HELLO_ACK;
+			sendPacket(peer.endpoint, &ack, sizeof(ack));
+			break;
+		}
+
+		case UDP_INPUT:
+		{
+			if (bytes < sizeof(UdpInputPacket))
+				return;
+			UdpInputPacket input;
+			memcpy(&input, recvBuffer_.data(), sizeof(input));
+
+			auto it = peers_.find(input.token);
+			if (it == peers_.end())
+				return;
+
+			// 등록된 주소에서 온 것만, 더 새로운 입력만 적용
+			Peer &peer = it->second;
+			if (!peer.bound || peer.endpoint != remote_)
+				return;
+			if (peer.hasInput && !sequenceNewer(input.sequence, peer.lastInputSequence))
+				return;
+
+			peer.lastInputSequence = input.sequence;
+			peer.hasInput = true;
+			onInput_(peer.playerId, Vector3(input.x, input.y, input.z));
+			break;
+		}
+
+		default:
+			break;
+		}
+	}
+};
@@ -3,7 +3,7 @@
 #include <boost/beast/websocket.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/steady_timer.hpp>
-#include <boost/asio/strand.hpp>
+#include <boost/asio/executor_work_guard.hpp>
 #include <boost/asio/bind_executor.hpp>
 #include <boost/asio/post.hpp>
 #include <thread>
@@ -14,8 +14,30 @@
 #include <nlohmann/json.hpp>
 #include <chrono>
 #include <iomanip>
+#include <fstream>
 #include "GameObject.h"
 #include "GameWorld.h"
+#include "SlotMap.h"
+#include "ServerConfig.h"
+#include "UdpTransport.h"
+#include "Logger.h"
+#include "HandlerAllocator.h"
+#include "ClientMessage.h"
+#include "SnapshotScheduler.h"
+#include "SessionTelemetry.h"
+#include "StatsEndpoint.h"
+#include "GatewayControl.h"
+#include "LoadShedder.h"
+#include "SnapshotRing.h"
+#include "FrameArena.h"
+
+#ifndef _WIN32
+#include <netinet/tcp.h>
+#endif
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 using namespace std;
 
@@ -25,6 +47,28 @@ namespace net = boost::asio;
 using tcp = net::ip::tcp;
 using json = nlohmann::json;
 
+#ifdef GAMESERVER_COUNT_ALLOCS
+// 할당 카운터 (벤치마크 빌드 전용, -DGAMESERVER_COUNT_ALLOCS=ON)
+// I/O 샤드 스레드와 게임 루프 스레드에서 일어난 operator new만 센다 (PhysX는 자체 할당자라 제외)
+static atomic<long long> ioAllocationCount{ 0 };
+static thread_local bool countIoAllocations = false;
+static atomic<long long> tickAllocationCount{ 0 };
+static thread_local bool countTickAllocations = false;
+
+void *operator new(size_t size)
+{
+	if (countIoAllocations)
+		ioAllocationCount.fetch_add(1, memory_order_relaxed);
+	else if (countTickAllocations)
+		tickAllocationCount.fetch_add(1, memory_order_relaxed);
+	if (void *pointer = malloc(size ? size : 1))
+		return pointer;
+	throw bad_alloc();
+}
+void operator delete(void *pointer) noexcept { free(pointer); }
+void operator delete(void *pointer, size_t) noexcept { free(pointer); }
+#endif
+
 //전방 선언
 class GameServer;
 
@@ -37,44 +81,98 @@ private:
 	int playerId_;
 	string nickname_;
 	GameServer *server_;
-	bool isAlive_;
-	bool hasJoined_; // JOIN_REQUEST를 받았는지 확인
-
-	net::strand<net::io_context::executor_type> strand_;
-	vector<string> writeQueue_;
+	atomic<bool> isAlive_;
+	atomic<bool> hasJoined_; // JOIN_REQUEST를 받았는지 확인
+	atomic<bool> spectating_{ false }; // SPECTATE_REQUEST로 들어온 관전자 (월드 슬롯/액터 없음)
+	int shardIndex_; // 소속 I/O 샤드
+	uint64_t udpToken_ = 0; // UDP 채널 토큰 (0이면 미사용)
+	atomic<bool> udpBound_{ false }; // UDP로 스냅샷을 받는 중이면 웹소켓 스냅샷 생략
+	atomic<bool> keyframePending_{ false }; // 키프레임을 요청해 두고 아직 못 받음 (중복 요청은 합친다)
+	SlotHandle slot_; // 샤드 세션 슬롯맵에서의 위치
+
+	// 샤드 io_context는 스레드 하나만 돌리므로 executor 자체가 암묵적 strand
+	net::io_context::executor_type executor_;
+	// 읽기/쓰기/post 완료 핸들러가 돌려 쓰는 메모리 (메시지마다 힙 할당하지 않도록)
+	shared_ptr<HandlerMemory> handlerMemory_ = make_shared<HandlerMemory>();
+	vector<shared_ptr<const string>> writeQueue_;
 	mutex queueMutex_;
 	bool isWriting_ = false;
-	string curentWriteMessage_;
+	bool writeInFlight_ = false; // async_write가 걸려 있는 동안
+	size_t queuedBytes_ = 0;     // 큐 + 보내는 중인 메시지 크기 합
+	shared_ptr<const string> latest_; // 관전자 스냅샷: 아직 못 보낸 것은 새 것으로 교체 (큐 뒤에 보낸다)
+	shared_ptr<const string> curentWriteMessage_;
+	chrono::steady_clock::time_point writeStart_;
+
+	// 네트워크 지표 / 느린 소비자 축출 (샤드 스레드, 큐 관련 필드는 queueMutex_ 안에서)
+	SessionTelemetry telemetry_;
+	string remote_;
+	chrono::steady_clock::time_point connectedAt_;
+	bool pingInFlight_ = false;
+	chrono::steady_clock::time_point pingSentAt_;
+	atomic<bool> evicted_{ false };
+
+	// 클라이언트별 예산 스냅샷 (샤드 스레드에서만, 예산을 켠 경우만 생성)
+	unique_ptr<SnapshotScheduler> scheduler_;
+	SharedPool<string> snapshotBuffers_{ 4 };
 
 public:
-	Session(tcp::socket socket, GameServer *server, net::io_context &ioc)
+	Session(tcp::socket socket, GameServer *server, net::io_context &ioc, int shardIndex)
 		: ws_(move(socket)),
 		playerId_(-1),
 		server_(server),
 		isAlive_(true),
 		hasJoined_(false),
-		strand_(net::make_strand(ioc.get_executor()))
+		shardIndex_(shardIndex),
+		executor_(ioc.get_executor()),
+		connectedAt_(chrono::steady_clock::now())
 	{
+		beast::error_code ec;
+		auto endpoint = ws_.next_layer().remote_endpoint(ec);
+		if (!ec)
+		{
+			remote_ = endpoint.address().to_string() + ":" + to_string(endpoint.port());
+		}
 	}
 
 	int getPlayerId() const { return playerId_; }
 	string getNickname() const { return nickname_; }
 	bool isAlive() const { return isAlive_; }
 	bool hasJoined() const { return hasJoined_; }
+	bool isSpectating() const { return spectating_; }
+	bool isUdpBound() const { return udpBound_; }
+	int getShardIndex() const { return shardIndex_; }
+	SlotHandle getSlot() const { return slot_; }
+	void setSlot(SlotHandle slot) { slot_ = slot; }
 
 	void run()
 	{
+		// pong은 읽기 작업 안에서 전달된다 (세션이 살아 있는 동안만 불림)
+		ws_.control_callback([this](websocket::frame_type kind, beast::string_view)
+			{
+				if (kind == websocket::frame_type::pong && pingInFlight_)
+				{
+					pingInFlight_ = false;
+					telemetry_.recordRtt(chrono::duration_cast<chrono::microseconds>(
+						chrono::steady_clock::now() - pingSentAt_).count());
+				}
+			});
+
 		//websocket 핸드셰이크
-		//모든 비동기 작업을 strand_를 통해 실행하도록 bind_executor 사용추가
+		//모든 비동기 작업을 샤드 executor에서 실행하도록 bind_executor 사용
 		ws_.async_accept(
-			net::bind_executor(strand_,
+			net::bind_executor(executor_,
 				[self = shared_from_this()](beast::error_code ec)
 				{
 					if (!ec)
 					{
-						cout << "Client connected, waiting for JOIN_REQUEST..." << endl;
+						LOG_INFO << "Client connected, waiting for JOIN_REQUEST...";
 						self->doRead();
 					}
+					else
+					{
+						// 핸드셰이크 실패도 정리 대상
+						self->close();
+					}
 				})
 		);
 	}
@@ -100,45 +198,114 @@ public:
 
 	void doRead()
 	{
-		// 읽기 작업도 strand_를 통해 실행추가
+		// 읽기 작업도 샤드 executor에서 실행
 		ws_.async_read(
 			buffer_,
-			net::bind_executor(strand_,
+			net::bind_executor(executor_, makeAllocatingHandler(handlerMemory_,
 				[self = shared_from_this()](beast::error_code ec, size_t bytes)
 				{
 					if (!ec)
 					{
 						//받은 메시지 처리
-						string message = beast::buffers_to_string(self->buffer_.data());
+						//버퍼를 그대로 보고 처리한 뒤 비운다 (flat_buffer는 용량을 유지하므로 다음 읽기도 할당 없음)
+						auto data = self->buffer_.data();
+						self->handleMessage(boost::string_view(static_cast<const char *>(data.data()), data.size()));
 						self->buffer_.consume(self->buffer_.size());
 
-						self->handleMessage(message);
+						self->telemetry_.bytesIn += bytes;
+						self->telemetry_.messagesIn++;
+						self->recordRead();
 						self->doRead();
 					}
 					else
 					{
 						if (self->hasJoined_)
 						{
-							cout << "Player " << self->playerId_ << " (" << self->nickname_ << ") disconnected" << endl;
+							LOG_INFO << "Player " << self->playerId_ << " (" << self->nickname_ << ") disconnected";
 						}
 						else
 						{
-							cout << "Client disconnected before joining" << endl;
+							LOG_INFO << "Client disconnected before joining";
 						}
-						self->isAlive_ = false;
+						self->close();
 					}
-				})
+				}))
 		);
 	}
 
 	// 비동기 큐 구현
-	void send(const string &message)
+	void send(string message)
+	{
+		send(make_shared<const string>(move(message)));
+	}
+
+	// 브로드캐스트용: 같은 버퍼를 모든 세션이 공유 (세션별 복사 없음)
+	void send(shared_ptr<const string> message)
 	{
+		if (evicted_)
+			return;
+
 		bool startWrite = false;
+		bool overflow = false;
 		// 큐는 락걸고 작업해야하니 스코프안에서
 		{
 			lock_guard<mutex> lock(queueMutex_);
-			writeQueue_.push_back(message);
+
+			// 안 읽는 클라이언트 때문에 큐가 끝없이 커지지 않도록
+			size_t maxQueueBytes = getEvictionLimits().maxQueueBytes;
+			if (maxQueueBytes > 0 && queuedBytes_ + message->size() > maxQueueBytes)
+			{
+				overflow = true;
+			}
+			else
+			{
+				queuedBytes_ += message->size();
+				writeQueue_.push_back(move(message));
+				telemetry_.recordQueue(writeQueue_.size() + (writeInFlight_ ? 1 : 0), queuedBytes_);
+			}
+
+			if (!isWriting_)
+			{
+				isWriting_ = true;
+				startWrite = true;
+			}
+		}
+
+		if (overflow)
+		{
+			net::post(executor_, [self = shared_from_this()]() {
+				self->evict("write queue limit");
+				});
+			return;
+		}
+
+		if (startWrite)
+		{
+			net::post(executor_, makeAllocatingHandler(handlerMemory_, [self = shared_from_this()]() {
+				self->doWrite();
+				}));
+		}
+	}
+
+	// 관전자 스냅샷: 큐에 쌓지 않고 최신 하나만 유지 (느린 관전자는 중간 프레임을 건너뛴다)
+	// 순서가 중요한 메시지(SPECTATE_RESPONSE 등)는 send()로 보내며 항상 먼저 나간다
+	void sendLatest(shared_ptr<const string> message)
+	{
+		if (evicted_)
+			return;
+
+		bool startWrite = false;
+		bool skipped = false;
+		{
+			lock_guard<mutex> lock(queueMutex_);
+			if (latest_)
+			{
+				queuedBytes_ -= latest_->size();
+				skipped = true;
+			}
+			queuedBytes_ += message->size();
+			latest_ = move(message);
+			telemetry_.recordQueue(writeQueue_.size() + 1 + (writeInFlight_ ? 1 : 0), queuedBytes_);
 
 			if (!isWriting_)
 			{
@@ -147,14 +314,81 @@ public:
 			}
 		}
 
+		if (skipped)
+		{
+			recordSpectatorSkip();
+		}
 		if (startWrite)
 		{
-			net::post(strand_, [self = shared_from_this()]() {
+			net::post(executor_, makeAllocatingHandler(handlerMemory_, [self = shared_from_this()]() {
 				self->doWrite();
-				});
+				}));
+		}
+	}
+
+	// 샤드 주기 점검 (샤드 스레드): ping 송신, 축출 기준 검사
+	void checkHealth(chrono::steady_clock::time_point now)
+	{
+		if (!isAlive_ || evicted_ || (!hasJoined_ && !spectating_))
+			return;
+
+		const EvictionLimits &limits = getEvictionLimits();
+
+		bool stalled;
+		{
+			lock_guard<mutex> lock(queueMutex_);
+			stalled = limits.maxWriteStallMs > 0 && writeInFlight_
+				&& now - writeStart_ > chrono::milliseconds(limits.maxWriteStallMs);
+		}
+		if (stalled)
+		{
+			evict("write stalled");
+			return;
+		}
+
+		if (limits.maxRttMs > 0)
+		{
+			if (pingInFlight_ && now - pingSentAt_ > chrono::milliseconds(limits.maxRttMs))
+			{
+				evict("ping timeout");
+				return;
+			}
+			if (telemetry_.rttMicros > static_cast<int64_t>(limits.maxRttMs) * 1000)
+			{
+				evict("rtt limit");
+				return;
+			}
+		}
+
+		if (!pingInFlight_)
+		{
+			pingInFlight_ = true;
+			pingSentAt_ = now;
+			ws_.async_ping({},
+				net::bind_executor(executor_, makeAllocatingHandler(handlerMemory_,
+					[self = shared_from_this()](beast::error_code ec)
+					{
+						// 실패는 읽기/쓰기 쪽에서 정리된다
+						(void)ec;
+					})));
 		}
 	}
 
+	// 통계 조회용 복사본 (샤드 스레드)
+	SessionStatsRow statsRow(chrono::steady_clock::time_point now)
+	{
+		SessionStatsRow row;
+		row.shard = shardIndex_;
+		row.playerId = playerId_;
+		row.nickname = nickname_;
+		row.spectator = spectating_;
+		row.remote = remote_;
+		row.connectedSeconds = chrono::duration<double>(now - connectedAt_).count();
+		lock_guard<mutex> lock(queueMutex_);
+		row.telemetry = telemetry_;
+		return row;
+	}
+
 private:
 	// 비동기 쓰기 루프
 	void doWrite()
@@ -164,48 +398,157 @@ private:
 			lock_guard<mutex> lock(queueMutex_);
 
 			// 큐가 비면 쓰기 종료후 리턴
-			if (writeQueue_.empty())
+			if (writeQueue_.empty() && !latest_)
 			{
 				isWriting_ = false;
 				return;
 			}
 
-			curentWriteMessage_ = std::move(writeQueue_.front());
-			writeQueue_.erase(writeQueue_.begin());
+			if (!writeQueue_.empty())
+			{
+				curentWriteMessage_ = std::move(writeQueue_.front());
+				writeQueue_.erase(writeQueue_.begin());
+			}
+			else
+			{
+				curentWriteMessage_ = std::move(latest_);
+			}
+			writeInFlight_ = true;
+			writeStart_ = chrono::steady_clock::now();
 		}
 
 		ws_.text(true);
 		ws_.async_write(
-			net::buffer(curentWriteMessage_),
-			net::bind_executor(strand_,
+			net::buffer(*curentWriteMessage_),
+			net::bind_executor(executor_, makeAllocatingHandler(handlerMemory_,
 				[self = shared_from_this()](beast::error_code ec, size_t bytes)
 				{
 					if (!ec)
 					{
+						self->recordWrite(bytes);
+
+						auto latency = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - self->writeStart_);
+						{
+							lock_guard<mutex> lock(self->queueMutex_);
+							self->writeInFlight_ = false;
+							self->queuedBytes_ -= self->curentWriteMessage_->size();
+							self->telemetry_.bytesOut += bytes;
+							self->telemetry_.messagesOut++;
+							self->telemetry_.recordWriteLatency(latency.count());
+							self->telemetry_.recordQueue(self->writeQueue_.size(), self->queuedBytes_);
+						}
+						if (self->scheduler_)
+						{
+							self->scheduler_->onWriteCompleted(latency);
+						}
+
 						// 다음 메시지 전송
 						self->doWrite();
 					}
 					else
 					{
-						cerr << "Send error: " << ec.message() << endl;
-						self->isAlive_ = false;
+						LOG_EVERY_MS(LogLevel::WARN, 1000) << "Send error: " << ec.message();
+						self->close();
 					}
-				})
+				}))
 		);
 	}
 
+	// 세션 종료 처리 (샤드 스레드에서 호출)
+	// 읽기/쓰기 에러가 동시에 나도 한 번만 서버에 통보한다
+	void close()
+	{
+		if (isAlive_.exchange(false))
+		{
+			notifyClosed();
+		}
+	}
+
+	// 느린 소비자 축출: 소켓을 닫으면 걸려 있던 읽기/쓰기가 에러로 끝나면서 close()로 정리된다
+	void evict(const char *reason)
+	{
+		if (!isAlive_ || evicted_.exchange(true))
+			return;
+
+		LOG_WARN << "Evicting " << (hasJoined_ ? "Player " + to_string(playerId_) + " (" + nickname_ + ")" : string(spectating_ ? "spectator" : "client"))
+			<< " " << remote_ << ": " << reason;
+		recordEviction();
+
+		beast::error_code ec;
+		ws_.next_layer().shutdown(tcp::socket::shutdown_both, ec);
+		ws_.next_layer().close(ec);
+	}
+
+	void notifyClosed(); // 전방 선언
+	void offerUdpChannel(); // 전방 선언
+	void recordWrite(size_t bytes); // 전방 선언
+	void recordRead(); // 전방 선언
+	void recordEviction(); // 전방 선언
+	void recordSpectatorSkip(); // 전방 선언
+	const EvictionLimits &getEvictionLimits() const; // 전방 선언
+
 public:
-	void handleMessage(const string &message); // 전방 선언
+	void handleMessage(boost::string_view text); // 전방 선언
 	void sendGameState(); // 전방 선언
+	void sendSnapshot(const SnapshotFrame &frame); // 전방 선언
+
+	// 게임 루프가 틱마다 한 번 만든 키프레임 (요청한 세션들이 같은 버퍼를 공유)
+	void sendKeyframe(shared_ptr<const string> keyframe)
+	{
+		keyframePending_ = false;
+		send(move(keyframe));
+	}
+};
+
+// I/O 샤드: 스레드 하나가 전담하는 io_context + 그 위의 세션들
+// sessions는 샤드 스레드에서만 접근하므로 락이 필요 없다
+struct IoShard
+{
+	net::io_context ioc{ 1 }; // concurrency hint 1 = 단일 스레드
+	net::executor_work_guard<net::io_context::executor_type> work{ ioc.get_executor() };
+	SlotMap<shared_ptr<Session>> sessions;
+	thread worker;
+
+	// 세션 점검 주기 타이머와 마지막 통계 복사본 (통계 조회는 이것만 읽는다)
+	net::steady_timer telemetryTimer{ ioc };
+	mutex statsMutex;
+	vector<SessionStatsRow> stats;
 };
 
 class GameServer
 {
 private:
-	net::io_context ioc_;
-	tcp::acceptor acceptor_;
-	vector<shared_ptr<Session>> sessions_;
-	mutex sessionsMutex_;
+	ServerConfig config_;
+	vector<unique_ptr<IoShard>> shards_;
+	tcp::acceptor acceptor_; // 0번 샤드에서 동작
+	int nextShard_ = 0; // 라운드로빈 배정
+
+	atomic<int> sessionCount_{ 0 };
+	atomic<int> playerCount_{ 0 };
+
+	// 관전자 (월드 슬롯 없이 낮은 주기의 전체 스냅샷만 받는다)
+	atomic<int> spectatorCount_{ 0 };
+	atomic<long long> spectatorSkips_{ 0 }; // 느린 관전자가 건너뛴 프레임
+	int spectatorDivider_ = 1;              // 몇 틱마다 관전자 스냅샷을 보내는지
+
+	// UDP 스냅샷 채널 (선택, 0번 샤드에서 동작)
+	unique_ptr<UdpTransport> udp_;
+
+	// 세션 점검 / 느린 소비자 축출 / 로컬 통계 조회 (0번 샤드에서 동작)
+	EvictionLimits evictionLimits_;
+	atomic<long long> evictionCount_{ 0 };
+	unique_ptr<StatsEndpoint> statsEndpoint_;
+	unique_ptr<LoadReporter> loadReporter_; // 게이트웨이 뒤에서 돌 때만
+
+	// 공유 메모리 스냅샷 내보내기 (--shm-export, 게임 루프 스레드에서만 쓴다)
+	unique_ptr<SnapshotRingWriter> shmExport_;
+	long long shmExportMicros_ = 0; // 상태 출력 구간 누적
+	int shmExportFrames_ = 0;
+	const chrono::seconds TELEMETRY_INTERVAL{ 1 };
+
+	// 플레이어 퇴장 이벤트 (I/O 스레드 -> 게임 루프)
+	vector<int> leftPlayers_;
+	mutex leftPlayersMutex_;
 
 	GameWorld gameWorld_;
 	mutex worldMutex_;
@@ -214,60 +557,275 @@ private:
 	const int TARGET_FPS = 60;
 	const float FIXED_DELTA_TIME = 1.0f / 60.0f;
 
-	const int MAX_PLAYERS = 50;
+	// 틱 예산 초과 시 단계적 부하 경감
+	LoadShedder loadShedder_{ 1000000.0f / TARGET_FPS };
 
 	// TPS 측정용 추가
 	int tickCount_ = 0;
 	chrono::steady_clock::time_point lastTPSUpdate_;
 	float currentTPS_ = 0.0f;
 
+	// 참가 처리량 측정용
+	atomic<int> joinCount_{ 0 };
+
+	// 송신 통계
+	// writeCount_는 완료된 웹소켓 메시지 쓰기 수이지 syscall 수가 아니다
+	// - epoll: 소켓 버퍼에 한 번에 들어가면 sendmsg 한 번, 부분 전송이면 그만큼 더 (여기서는 안 보임)
+	// - io_uring: 쓰기마다 SQE 하나, 제출(io_uring_enter)은 여러 SQE를 묶으므로 syscall 절감은 이 숫자로 알 수 없다
+	//   (strace -c -e trace=sendmsg,io_uring_enter 등으로 확인)
+	// - UDP 스냅샷은 따로 센다 (UDP Out pkts = sendto 호출 수)
+	atomic<long long> writeCount_{ 0 };
+	atomic<long long> bytesOut_{ 0 };
+	atomic<long long> readCount_{ 0 };
+
+	// 브로드캐스트 버퍼 풀
+	// 모든 세션/UDP가 다 보내고 놓은 버퍼를 다음 브로드캐스트에 재사용 -> 틱마다 새 버퍼를 만들지 않음
+	SharedPool<string> snapshotBuffers_{ 16 };
+	mutex snapshotBuffersMutex_;
+
+	// 클라이언트별 예산 스냅샷 (--client-budget-kbps)
+	SnapshotScheduler::Options snapshotOptions_;
+	SharedPool<SnapshotFrame> snapshotFrames_{ 4 }; // 게임 루프 스레드에서만
+	atomic<long long> budgetSnapshots_{ 0 };
+	atomic<long long> budgetDummiesSent_{ 0 };
+	atomic<long long> budgetDummiesTotal_{ 0 };
+	atomic<long long> budgetBytesSum_{ 0 }; // 세션별 현재 예산 합 (초당 바이트)
+
+	// 틱 임시 메모리 (전체 스냅샷 인코딩 버퍼, 임시 컨테이너), 월드 잠금 안에서만 할당
+	// 게임 루프가 틱 시작에 되돌리므로 encodeGameStateInternal의 결과는 그 틱의 브로드캐스트까지만 유효
+	FrameArena frameArena_;
+	// 틱 밖 이벤트(스폰/전체 삭제)의 전체 스냅샷용, 쓸 때마다 되돌린다
+	// (틱 아레나에 잡으면 한 틱 안의 요청 수만큼 쌓이고, reset이 그 크기를 계속 붙잡는다)
+	FrameArena eventArena_{ 64 * 1024 };
+	static const size_t ENCODE_GRAIN = 2048;
+
+	// 참가/재동기화용 전체 상태 키프레임
+	// 요청한 세션은 대기 목록에만 들어가고 (월드 잠금 없음), 게임 루프가 틱마다 많아야 한 번 인코딩해서 같은 버퍼를 나눠 준다
+	// 대기자가 없는 틱에는 만들지 않는다
+	mutex keyframeMutex_;
+	vector<shared_ptr<Session>> keyframeWaiters_;
+	vector<shared_ptr<Session>> keyframeServing_; // 게임 루프 스레드에서만 (용량 재사용)
+	atomic<bool> keyframeWanted_{ false };
+	atomic<long long> keyframesBuilt_{ 0 };
+	atomic<long long> keyframesSent_{ 0 };
+
+	// 방 스냅샷 (게임 루프 스레드에서만 접근)
+	chrono::steady_clock::time_point lastSnapshotTime_;
+	float lastSnapshotMillis_ = 0.0f;
+
 	thread gameLoopThread_;
-	vector<thread> iocThreads_;
 	atomic<bool> running_;
 
 	int broadcaseCounter_ = 0;
 
-	json getGameStateInternal()
+	// throttleDistant: 플레이어에게서 먼 더미는 돌아가며 일부만 싣는다 ("partial": true, 클라이언트는 마지막 위치 유지)
+	// {"type":4,"tick":T[,"partial":true,"dummyCount":N],"players":[...],"dummies":[...]} (예산 스냅샷과 같은 형식)
+	// 더미 배열은 청크 병렬로 아레나 버퍼에 쓰고 순서대로 이어 붙인다 (월드 잠금 안에서, 힙 할당 없음)
+	string_view encodeGameStateInternal(bool throttleDistant = false)
 	{
-		json data;
-		data["type"] = 4; // GAME_STATE
+		return encodeGameStateInternal(frameArena_, throttleDistant);
+	}
+
+	// arena: 인코딩 버퍼를 잡을 곳 (결과는 arena를 되돌리기 전까지 유효)
+	string_view encodeGameStateInternal(FrameArena &arena, bool throttleDistant)
+	{
+		uint32_t tick = gameWorld_.getTick();
+		size_t dummyCount = gameWorld_.getTotalDummyCount();
+		size_t chunkCount = (dummyCount + ENCODE_GRAIN - 1) / ENCODE_GRAIN;
+
+		// 청크 버퍼는 호출 스레드가 상한(더미당 DUMMY_JSON_MAX_BYTES + 쉼표)으로 미리 잡는다 (아레나는 스레드 안전하지 않음)
+		struct EncodeChunk
+		{
+			FrameText text;
+			size_t count;
+		};
+		pmr::vector<EncodeChunk> chunks(&arena);
+		chunks.reserve(chunkCount);
+		for (size_t c = 0; c < chunkCount; ++c)
+		{
+			size_t chunkDummies = std::min(ENCODE_GRAIN, dummyCount - c * ENCODE_GRAIN);
+			chunks.push_back(EncodeChunk{ FrameText(arena, chunkDummies * (DUMMY_JSON_MAX_BYTES + 1)), 0 });
+		}
+
+		// 장식용 더미 포함, 클라이언트에게는 구분 없음
+		// 풀이 없거나 범위가 작으면 한 번에 [0, count)가 오므로 grain 단위로 나눠 자기 청크 버퍼에 쓴다
+		parallelFor(gameWorld_.getTaskPool(), dummyCount, ENCODE_GRAIN, [&](size_t begin, size_t end)
+			{
+				for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += ENCODE_GRAIN)
+				{
+					EncodeChunk &chunk = chunks[chunkBegin / ENCODE_GRAIN];
+					gameWorld_.forEachDummyInRange(chunkBegin, std::min(end, chunkBegin + ENCODE_GRAIN),
+						[&](int id, const Vector3 &position, const Vector3 &)
+						{
+							if (throttleDistant && !LoadShedder::distantDummyDue(id, tick) && isDistantInternal(position))
+								return;
+
+							if (chunk.count++ > 0)
+								chunk.text.push_back(',');
+							chunk.text.commit(writeDummyJson(chunk.text.tail(), id, position));
+						});
+				}
+			});
 
-		json playersArray = json::array();
+		size_t included = 0;
+		size_t dummyBytes = 0;
+		for (const EncodeChunk &chunk : chunks)
+		{
+			included += chunk.count;
+			dummyBytes += chunk.text.size() + 1;
+		}
+
+		const auto &players = gameWorld_.getPlayers();
+		static const size_t HEADER_BYTES = 96;
+		FrameText text(arena, HEADER_BYTES + playersJsonMaxBytes(players) + dummyBytes + 16);
+		char header[HEADER_BYTES];
+		int headerLength = included < dummyCount
+			? snprintf(header, sizeof(header), "{\"type\":4,\"tick\":%u,\"partial\":true,\"dummyCount\":%zu,\"players\":", tick, dummyCount)
+			: snprintf(header, sizeof(header), "{\"type\":4,\"tick\":%u,\"players\":", tick);
+		text.append(header, static_cast<size_t>(headerLength));
+		appendPlayersJson(text, players);
+		text += ",\"dummies\":[";
+		bool first = true;
+		for (const EncodeChunk &chunk : chunks)
+		{
+			if (chunk.count == 0)
+				continue;
+			if (!first)
+				text += ',';
+			text += chunk.text.view();
+			first = false;
+		}
+		text += "]}";
+		return text.view();
+	}
+
+	// 틱 밖(이벤트 처리)에서 쓰는 복사본, 이벤트 아레나에 인코딩해서 바로 되돌린다 (틱 아레나는 건드리지 않음)
+	string getGameStateInternal()
+	{
+		eventArena_.reset();
+		string state(encodeGameStateInternal(eventArena_, false));
+		eventArena_.reset();
+		return state;
+	}
+
+	// 가장 가까운 플레이어도 DISTANT_RADIUS 밖이면 먼 더미
+	bool isDistantInternal(const Vector3 &position)
+	{
+		const float radiusSq = LoadShedder::DISTANT_RADIUS * LoadShedder::DISTANT_RADIUS;
+		for (const auto &player : gameWorld_.getPlayers())
+		{
+			if (player == nullptr)
+				continue;
+			float dx = position.x - player->position.x;
+			float dy = position.y - player->position.y;
+			float dz = position.z - player->position.z;
+			if (dx * dx + dy * dy + dz * dz <= radiusSq)
+				return false;
+		}
+		return true;
+	}
+
+	// 틱마다 월드 상태를 공유 메모리 링에 한 번 쓴다 (월드 잠금 안에서, 소비자 수와 무관)
+	// 부하 경감 중에도 건너뛰지 않는다: JSON/할당 없이 개체당 32바이트 복사뿐이고 사이드카는 틱 누락을 싫어한다
+	void exportSnapshotInternal()
+	{
+		auto start = chrono::steady_clock::now();
+		shmExport_->begin(gameWorld_.getTick());
 		for (const auto &player : gameWorld_.getPlayers())
 		{
 			if (player != nullptr)
-			{
-				json p;
-				p["id"] = player->id;
-				p["nickname"] = player->nickname;
-				p["pos"] = { player->position.x, player->position.y, player->position.z };
-				p["vel"] = { player->velocity.x, player->velocity.y, player->velocity.z };
-				p["color"] = { player->color.r, player->color.g, player->color.b };
-				playersArray.push_back(p);
-			}
+				shmExport_->add(player->id, SnapshotRingEntity::PLAYER, player->position, player->velocity);
 		}
-		data["players"] = playersArray;
+		gameWorld_.forEachDummy([this](int id, const Vector3 &position, const Vector3 &velocity)
+			{
+				shmExport_->add(id, SnapshotRingEntity::DUMMY, position, velocity);
+			});
+		shmExport_->commit();
 
-		// 더미 배열 추가
-		json dummiesArray = json::array();
-		for (const auto &dummy : gameWorld_.getDummies())
+		shmExportMicros_ += chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+		shmExportFrames_++;
+		if (shmExport_->lastTotalCount() > shmExport_->lastCount())
 		{
-			json d;
-			d["id"] = dummy->id;
-			d["pos"] = { dummy->position.x, dummy->position.y, dummy->position.z };
-			dummiesArray.push_back(d);
+			LOG_EVERY_MS(LogLevel::WARN, 10000) << "Shared-memory export truncated: " << shmExport_->lastTotalCount()
+				<< " entities, capacity " << shmExport_->entityCapacity();
 		}
-		data["dummies"] = dummiesArray;
+	}
 
-		return data;
+	// 세션별 스냅샷의 공통 재료 (월드 잠금 안에서)
+	void buildSnapshotFrameInternal(SnapshotFrame &frame)
+	{
+		frame.clear();
+		frame.tick = gameWorld_.getTick();
+		appendPlayersJson(frame.playersJson, gameWorld_.getPlayers());
+		for (const auto &player : gameWorld_.getPlayers())
+		{
+			if (player != nullptr)
+				frame.playerPositions.emplace_back(player->id, player->position);
+		}
+		gameWorld_.forEachDummy([&frame](int id, const Vector3 &position, const Vector3 &velocity)
+			{
+				frame.addDummy(id, position, velocity);
+			});
 	}
 
 public:
-	GameServer(int port)
-		: acceptor_(ioc_, tcp::endpoint(tcp::v4(), port))
+	GameServer(const ServerConfig &config)
+		: config_(config)
+		, shards_(createShards(config))
+		, acceptor_(shards_[0]->ioc, tcp::endpoint(tcp::v4(), config.port))
+		, gameWorld_(*findSceneProfile(config.sceneProfile), config.regions, config.maxPlayers)
 		, running_(false)
 	{
 		lastTPSUpdate_ = chrono::steady_clock::now();
+
+		snapshotOptions_.budgetKbps = config_.clientBudgetKbps;
+		snapshotOptions_.adaptive = config_.clientBudgetAdaptive;
+		snapshotOptions_.tickRate = TARGET_FPS;
+
+		spectatorDivider_ = std::max(1, TARGET_FPS / std::max(1, config_.spectatorRate));
+		gameWorld_.setWorkerThreads(config_.worldThreads);
+
+		evictionLimits_.maxQueueBytes = static_cast<size_t>(std::max(0, config_.maxQueueKb)) * 1024;
+		evictionLimits_.maxWriteStallMs = config_.maxWriteStallMs;
+		evictionLimits_.maxRttMs = config_.maxRttMs;
+
+		if (config_.statsPort > 0)
+		{
+			statsEndpoint_ = make_unique<StatsEndpoint>(shards_[0]->ioc, config_.statsPort,
+				[this]() { return renderStats(); });
+			statsEndpoint_->addCommand("/pvd-capture",
+				[this](const string &query) { return startPvdCaptureCommand(query); });
+		}
+
+		if (!config_.gateway.empty())
+		{
+			loadReporter_ = make_unique<LoadReporter>(shards_[0]->ioc, config_.gateway,
+				[this]() { return currentLoadReport(); });
+		}
+
+		if (config_.udpPort > 0)
+		{
+			UdpTransport::Options options;
+			options.port = config_.udpPort;
+			options.mtu = config_.udpMtu;
+			options.rateKbps = config_.udpRateKbps;
+			options.lossRate = config_.udpLoss;
+			udp_ = make_unique<UdpTransport>(shards_[0]->ioc, options,
+				[this](int playerId, const Vector3 &movement)
+				{
+					setPlayerInput(playerId, movement);
+				});
+		}
+
+		if (!config_.shmExport.empty())
+		{
+			shmExport_ = SnapshotRingWriter::create(config_.shmExport,
+				static_cast<uint32_t>(std::max(2, config_.shmSlots)),
+				static_cast<uint32_t>(std::max(1, config_.shmCapacity)),
+				static_cast<uint32_t>(TARGET_FPS));
+			if (!shmExport_)
+				LOG_ERROR << "Failed to create shared-memory export " << config_.shmExport << " (continuing without it)";
+		}
 	}
 	~GameServer()
 	{
@@ -276,40 +834,79 @@ public:
 
 	void start()
 	{
-		cout << "Game Server Started on port 9002" << endl;
-		cout << "Target FPS: " << TARGET_FPS << endl;
-		cout << "Fixed Delta Time: " << FIXED_DELTA_TIME << "s" << endl;
-		cout << "Waiting for players (max " << MAX_PLAYERS << ")..." << endl;
+		LOG_INFO << "Game Server Started on port " << config_.port;
+		LOG_INFO << "I/O Backend: " << ioBackendName();
+		LOG_INFO << "Scene Profile: " << config_.sceneProfile;
+		LOG_INFO << "Region Grid: " << gameWorld_.getRegionGrid() << "x" << gameWorld_.getRegionGrid()
+			<< " (map " << gameWorld_.getMapSize() << " m)";
+		LOG_INFO << "Target FPS: " << TARGET_FPS;
+		LOG_INFO << "Fixed Delta Time: " << FIXED_DELTA_TIME << "s";
+		LOG_INFO << "World Threads: " << gameWorld_.getWorkerThreads();
+		LOG_INFO << "Waiting for players (max " << getMaxPlayers() << ")...";
+		restoreRoomSnapshot();
+		if (!config_.pvdCapture.empty())
+		{
+			// 게임 루프가 돌기 전이라 잠금 없이
+			if (!gameWorld_.getPhysicsWorld().startPvdCapture(config_.pvdCapture, static_cast<uint32_t>(std::max(1, config_.pvdTicks))))
+				LOG_ERROR << "PVD capture not started: " << config_.pvdCapture;
+		}
 		doAccept();
 
+		// 샤드 스레드가 돌기 전이므로 여기서 타이머를 걸어도 된다
+		for (auto &shard : shards_)
+		{
+			scheduleTelemetry(shard.get());
+		}
+		if (statsEndpoint_)
+		{
+			LOG_INFO << "Stats endpoint on http://127.0.0.1:" << config_.statsPort << "/stats";
+			statsEndpoint_->start();
+		}
+		if (loadReporter_)
+		{
+			LOG_INFO << "Reporting load to gateway " << config_.gateway;
+			loadReporter_->start();
+		}
+
+		if (udp_)
+		{
+			LOG_INFO << "UDP snapshot channel on port " << udp_->port()
+				<< " (mtu " << config_.udpMtu << ", loss " << config_.udpLoss << ")";
+			udp_->start();
+		}
+		if (shmExport_)
+		{
+			LOG_INFO << "Shared-memory export " << shmExport_->name() << " (" << shmExport_->slotCount() << " slots x "
+				<< shmExport_->entityCapacity() << " entities, " << (shmExport_->mappedBytes() >> 20) << " MB)";
+		}
+
 		running_ = true;
 		gameLoopThread_ = thread([this]() {this->gameLoopThreadFunc(); });
 	}
 
 	void run()
 	{
-		// CPU 코어 수 만큼 I/O 스레드 생성 예정
-		auto const thread_count = std::max<int>(1, std::thread::hardware_concurrency());
-		cout << "Starting " << thread_count << " I/O threads" << endl;
+		// 샤드(= io_context) 하나당 I/O 스레드 하나
+		int const threadCount = static_cast<int>(shards_.size());
+		LOG_INFO << "Starting " << threadCount << " I/O shards"
+			<< (config_.pinThreads ? " (pinned)" : "");
 
-		iocThreads_.reserve(thread_count - 1);
-
-		// I/O 스레드 실제 생성 (N-1개)
-		for (int i = 0; i < thread_count - 1; ++i)
+		// I/O 스레드 실제 생성 (1 ~ N-1번 샤드)
+		for (int i = 1; i < threadCount; ++i)
 		{
-			iocThreads_.emplace_back([this] {
-				ioc_.run();
+			shards_[i]->worker = thread([this, i] {
+				runShard(i);
 				});
 		}
 
-		// N번째는 메인 스레드
-		ioc_.run();
+		// 0번 샤드는 메인 스레드
+		runShard(0);
 
 		// 서버 종료시 모든 스레드 수거
-		for (auto &t : iocThreads_)
+		for (auto &shard : shards_)
 		{
-			if (t.joinable())
-				t.join();
+			if (shard->worker.joinable())
+				shard->worker.join();
 		}
 	}
 
@@ -319,18 +916,107 @@ public:
 		if (gameLoopThread_.joinable())
 		{
 			gameLoopThread_.join();
+			saveRoomSnapshot();
+		}
+		{
+			// 게임 루프가 멈췄으니 키프레임 대기자는 더 받을 수 없다 (세션을 붙잡지 않도록)
+			lock_guard<mutex> lock(keyframeMutex_);
+			keyframeWaiters_.clear();
 		}
+		shmExport_.reset(); // 소비자에게 CLOSED 표시 후 이름 제거
 
-		if (!ioc_.stopped())
+		for (auto &shard : shards_)
 		{
-			ioc_.stop();
+			if (!shard->ioc.stopped())
+			{
+				shard->ioc.stop();
+			}
 		}
 	}
 
 	int joinPlayer(string nickname, Color color)
 	{
-		lock_guard<mutex> lock(worldMutex_);
-		return gameWorld_.addPlayer(nickname, color);
+		int playerId;
+		{
+			lock_guard<mutex> lock(worldMutex_);
+			playerId = gameWorld_.addPlayer(nickname, color);
+		}
+		if (playerId != -1)
+		{
+			joinCount_++;
+			playerCount_++;
+		}
+		return playerId;
+	}
+
+	UdpTransport *getUdpTransport() { return udp_.get(); }
+
+	void recordWrite(size_t bytes)
+	{
+		writeCount_++;
+		bytesOut_ += bytes;
+	}
+
+	void recordRead()
+	{
+		readCount_++;
+	}
+
+	const SnapshotScheduler::Options &getSnapshotOptions() const { return snapshotOptions_; }
+	const EvictionLimits &getEvictionLimits() const { return evictionLimits_; }
+
+	void recordEviction()
+	{
+		evictionCount_++;
+	}
+
+	// 관전자 자리 (I/O 스레드), 상한이면 false
+	bool addSpectator()
+	{
+		int count = spectatorCount_.load();
+		do
+		{
+			if (count >= config_.maxSpectators)
+				return false;
+		} while (!spectatorCount_.compare_exchange_weak(count, count + 1));
+		return true;
+	}
+
+	void removeSpectator()
+	{
+		spectatorCount_--;
+	}
+
+	void recordSpectatorSkip()
+	{
+		spectatorSkips_++;
+	}
+
+	int getSpectatorRate() const
+	{
+		return TARGET_FPS / spectatorDivider_;
+	}
+
+	void recordSnapshotBudget(const SnapshotScheduler &scheduler)
+	{
+		budgetSnapshots_++;
+		budgetDummiesSent_ += scheduler.lastSent();
+		budgetDummiesTotal_ += scheduler.lastTotal();
+		budgetBytesSum_ += static_cast<long long>(scheduler.budgetBytesPerSecond());
+	}
+
+	// 세션 종료 통보 (세션의 샤드 스레드에서 호출)
+	// 샤드 슬롯은 바로 해제하고, 플레이어 제거는 게임 루프가 다음 틱에 처리한다
+	void onSessionClosed(int shardIndex, SlotHandle slot, int playerId)
+	{
+		shards_[shardIndex]->sessions.erase(slot);
+		sessionCount_--;
+
+		if (playerId != -1)
+		{
+			lock_guard<mutex> lock(leftPlayersMutex_);
+			leftPlayers_.push_back(playerId);
+		}
 	}
 
 	void setPlayerInput(int playerId, const Vector3 &movement)
@@ -351,15 +1037,28 @@ public:
 		gameWorld_.removePlayer(playerId);
 	}
 
-	void spawnDummies(int count)
+	// 실제로 만든 수 (부하 경감 3단계에서는 0)
+	// cosmetic: PhysX 액터 없이 SIMD로 적분하는 장식용 더미 (플레이어 근처에서만 액터로 승격)
+	int spawnDummies(int count, bool cosmetic = false)
 	{
+		if (loadShedder_.spawnCapped())
+		{
+			LOG_EVERY_MS(LogLevel::WARN, 1000) << "SPAWN_DUMMIES rejected: server overloaded ("
+				<< LoadShedder::levelName(loadShedder_.level()) << ")";
+			return 0;
+		}
+
 		string updateData;
 		{
 			lock_guard<mutex> lock(worldMutex_);
-			gameWorld_.spawnDummies(count);
-			updateData = getGameStateInternal().dump();
+			if (cosmetic)
+				count = gameWorld_.spawnCosmeticDummies(count);
+			else
+				gameWorld_.spawnDummies(count);
+			updateData = getGameStateInternal();
 		}
 		broadcast(updateData);
+		return count;
 	}
 
 	void deleteAllDummies()
@@ -368,70 +1067,373 @@ public:
 		{
 			lock_guard<mutex> lock(worldMutex_);
 			gameWorld_.deleteAllDummies();
-			updateData = getGameStateInternal().dump();
+			updateData = getGameStateInternal();
 		}
 		broadcast(updateData);
 	}
 
-	json getGameState()
+	// 다음 틱 키프레임을 기다린다 (I/O 스레드, 월드 잠금을 잡지 않으므로 재접속 폭주가 틱과 경합하지 않는다)
+	void requestKeyframe(shared_ptr<Session> session)
 	{
-		lock_guard<mutex> lock(worldMutex_);
-		return getGameStateInternal();
+		lock_guard<mutex> lock(keyframeMutex_);
+		keyframeWaiters_.push_back(move(session));
+		keyframeWanted_ = true;
 	}
 
-	void broadcast(const string &message)
+	// 샤드마다 한 번씩만 post (세션 수와 무관)
+	// 샤드 스레드가 자기 세션들에게 같은 버퍼를 나눠준다
+	// UDP 채널이 연결된 세션은 웹소켓 대신 UDP로 받는다
+	void broadcast(string_view message)
 	{
-		lock_guard<mutex> lock(sessionsMutex_);
-		for (auto &session : sessions_)
+		shared_ptr<const string> shared = acquireSnapshotBuffer(message);
+		for (auto &shard : shards_)
 		{
-			if (session->isAlive() && session->hasJoined())
-			{
-				session->send(message);
-			}
+			net::post(shard->ioc, [shard = shard.get(), shared]()
+				{
+					for (auto &session : shard->sessions)
+					{
+						if (session->isAlive() && session->hasJoined() && !session->isUdpBound())
+						{
+							session->send(shared);
+						}
+					}
+				});
 		}
-	}
 
-	int getConnectedPlayerCount()
-	{
-		lock_guard<mutex> lock(sessionsMutex_);
-		int count = 0;
-		for (auto &session : sessions_)
+		if (udp_)
 		{
-			if (session->hasJoined())
-			{
-				count++;
-			}
+			udp_->sendSnapshot(shared);
 		}
-		return count;
 	}
 
-private:
-	void doAccept()
+	// 예산 모드: 프레임만 샤드에 나눠주고 세션마다 자기 예산에 맞춰 스냅샷을 만든다 (샤드 스레드에서 병렬)
+	// UDP 채널은 자체 페이싱이 있으므로 전체 스냅샷(fullMessage)을 그대로 보낸다
+	void broadcastFrame(shared_ptr<const SnapshotFrame> frame, string_view fullMessage)
 	{
-		acceptor_.async_accept(
-			[this](beast::error_code ec, tcp::socket socket)
-			{
-				if (!ec)
+		for (auto &shard : shards_)
+		{
+			net::post(shard->ioc, [shard = shard.get(), frame]()
 				{
-					// 세션만 생성, playerId는 JOIN_REQUEST에서 할당
-					auto session = make_shared<Session>(move(socket), this, ioc_);
+					for (auto &session : shard->sessions)
+					{
+						if (session->isAlive() && session->hasJoined() && !session->isUdpBound())
+						{
+							session->sendSnapshot(*frame);
+						}
+					}
+				});
+		}
+
+		if (udp_ && !fullMessage.empty())
+		{
+			udp_->sendSnapshot(acquireSnapshotBuffer(fullMessage));
+		}
+	}
+
+	// 관전자 스냅샷 (샤드마다 한 번씩 post, 세션은 최신 것만 유지)
+	void broadcastSpectators(string_view message)
+	{
+		shared_ptr<const string> shared = acquireSnapshotBuffer(message);
+		for (auto &shard : shards_)
+		{
+			net::post(shard->ioc, [shard = shard.get(), shared]()
+				{
+					for (auto &session : shard->sessions)
 					{
-						lock_guard<mutex> lock(sessionsMutex_);
-						sessions_.push_back(session);
+						if (session->isAlive() && session->isSpectating())
+						{
+							session->sendLatest(shared);
+						}
 					}
+				});
+		}
+	}
+
+	// 풀에서 아무도 안 쓰는 버퍼를 골라 내용을 덮어쓴다 (용량이 충분하면 할당 없음)
+	shared_ptr<const string> acquireSnapshotBuffer(string_view message)
+	{
+		lock_guard<mutex> lock(snapshotBuffersMutex_);
+		shared_ptr<string> buffer = snapshotBuffers_.acquire();
+		buffer->assign(message.data(), message.size());
+		return buffer;
+	}
+
+	int getConnectedPlayerCount()
+	{
+		return playerCount_;
+	}
+
+	// 플레이어 정원 (--max-players, 시작 후 바뀌지 않음)
+	int getMaxPlayers() const
+	{
+		return gameWorld_.getMaxPlayers();
+	}
+
+	int getSessionCount()
+	{
+		return sessionCount_;
+	}
+
+private:
+	static vector<unique_ptr<IoShard>> createShards(const ServerConfig &config)
+	{
+		// 0이면 CPU 코어 수 만큼
+		int count = config.ioThreads > 0
+			? config.ioThreads
+			: std::max<int>(1, std::thread::hardware_concurrency());
+
+		vector<unique_ptr<IoShard>> shards;
+		for (int i = 0; i < count; ++i)
+		{
+			shards.push_back(make_unique<IoShard>());
+		}
+		return shards;
+	}
+
+	// 샤드마다 주기적으로: 세션 점검(ping, 축출) + 통계 복사본 갱신
+	void scheduleTelemetry(IoShard *shard)
+	{
+		shard->telemetryTimer.expires_after(TELEMETRY_INTERVAL);
+		shard->telemetryTimer.async_wait([this, shard](beast::error_code ec)
+			{
+				if (ec)
+					return;
 
-					session->run();
+				auto now = chrono::steady_clock::now();
+				vector<SessionStatsRow> rows;
+				rows.reserve(shard->sessions.size());
+				for (auto &session : shard->sessions)
+				{
+					if (!session->isAlive())
+						continue;
+					session->checkHealth(now);
+					rows.push_back(session->statsRow(now));
+				}
+				{
+					lock_guard<mutex> lock(shard->statsMutex);
+					shard->stats.swap(rows);
+				}
+
+				scheduleTelemetry(shard);
+			});
+	}
+
+	// 게이트웨이 부하 보고 (0번 샤드 스레드, 원자 변수만 읽는다)
+	BackendLoadReport currentLoadReport()
+	{
+		BackendLoadReport report;
+		report.port = config_.port;
+		report.players = getConnectedPlayerCount();
+		report.maxPlayers = getMaxPlayers();
+		report.sessions = getSessionCount();
+		report.loadLevel = static_cast<int>(loadShedder_.level());
+		report.tickMs = loadShedder_.smoothedCostMicros() / 1000.0f;
+		return report;
+	}
+
+	// POST /pvd-capture?ticks=N (0번 샤드 스레드): pvdDir/gameserver-<tick>.pxd2에 N틱 캡처
+	// 파일 이름은 서버가 정한다 (요청으로 임의 경로에 쓰지 않게)
+	string startPvdCaptureCommand(const string &query)
+	{
+		const int MAX_CAPTURE_TICKS = TARGET_FPS * 600;
+		int ticks = atoi(StatsEndpoint::queryValue(query, "ticks", to_string(config_.pvdTicks)).c_str());
+		ticks = std::min(std::max(1, ticks), MAX_CAPTURE_TICKS);
+
+		json result;
+		{
+			// 틱 사이에 연결해야 하므로 월드 잠금 (연결 시 씬 전체를 보내는 동안 틱이 밀린다)
+			lock_guard<mutex> lock(worldMutex_);
+			PhysicsWorld &physics = gameWorld_.getPhysicsWorld();
+			string path = config_.pvdDir + "/gameserver-" + to_string(physics.getTick()) + ".pxd2";
+			result["started"] = physics.startPvdCapture(path, static_cast<uint32_t>(ticks));
+			result["capturing"] = physics.isPvdCapturing();
+			result["path"] = physics.getPvdPath();
+			result["remainingTicks"] = physics.getPvdRemainingTicks();
+		}
+		return result.dump(2);
+	}
+
+	// 통계 조회 응답 (0번 샤드 스레드, 샤드별 복사본만 읽는다)
+	string renderStats()
+	{
+		json result;
+		result["sessionCount"] = getSessionCount();
+		result["playerCount"] = getConnectedPlayerCount();
+		result["evictions"] = evictionCount_.load();
+		result["spectatorCount"] = spectatorCount_.load();
+		result["keyframes"] = {
+			{ "built", keyframesBuilt_.load() },
+			{ "sent", keyframesSent_.load() },
+		};
+		result["loadShedding"] = {
+			{ "level", static_cast<int>(loadShedder_.level()) },
+			{ "name", LoadShedder::levelName(loadShedder_.level()) },
+			{ "tickCostMs", loadShedder_.smoothedCostMicros() / 1000.0f },
+			{ "lastTickCostMs", loadShedder_.lastCostMicros() / 1000.0f },
+			{ "budgetMs", loadShedder_.budgetMicros() / 1000.0f },
+			{ "overruns", loadShedder_.overruns() },
+		};
+		{
+			// 마지막 틱의 PxSimulationStatistics (구조체 복사만 잠금 안에서)
+			PhysicsTickStats physicsStats;
+			bool pvdCapturing;
+			uint32_t pvdRemainingTicks;
+			{
+				lock_guard<mutex> lock(worldMutex_);
+				PhysicsWorld &physics = gameWorld_.getPhysicsWorld();
+				physicsStats = physics.getTickStats();
+				pvdCapturing = physics.isPvdCapturing();
+				pvdRemainingTicks = physics.getPvdRemainingTicks();
+			}
+			result["physics"] = {
+				{ "tick", physicsStats.tick },
+				{ "simulateMs", physicsStats.simulateMicros / 1000.0f },
+				{ "activeDynamicBodies", physicsStats.activeDynamicBodies },
+				{ "dynamicBodies", physicsStats.dynamicBodies },
+				{ "staticBodies", physicsStats.staticBodies },
+				{ "activeConstraints", physicsStats.activeConstraints },
+				{ "axisSolverConstraints", physicsStats.axisSolverConstraints },
+				{ "partitions", physicsStats.partitions },
+				{ "contactPairs", physicsStats.contactPairs },
+				{ "contactPairsWithContacts", physicsStats.contactPairsWithContacts },
+				{ "newPairs", physicsStats.newPairs },
+				{ "lostPairs", physicsStats.lostPairs },
+				{ "newTouches", physicsStats.newTouches },
+				{ "lostTouches", physicsStats.lostTouches },
+				{ "regions", physicsStats.regions },
+				{ "ghostActors", physicsStats.ghostActors },
+				{ "handoffs", physicsStats.handoffs },
+				{ "pvdCapturing", pvdCapturing },
+				{ "pvdRemainingTicks", pvdRemainingTicks },
+			};
+		}
+		result["limits"] = {
+			{ "maxQueueBytes", evictionLimits_.maxQueueBytes },
+			{ "maxWriteStallMs", evictionLimits_.maxWriteStallMs },
+			{ "maxRttMs", evictionLimits_.maxRttMs },
+		};
+
+		json sessions = json::array();
+		for (auto &shard : shards_)
+		{
+			lock_guard<mutex> lock(shard->statsMutex);
+			for (const SessionStatsRow &row : shard->stats)
+			{
+				sessions.push_back(row.toJson());
+			}
+		}
+		result["sessions"] = sessions;
+		return result.dump(2);
+	}
+
+	void runShard(int index)
+	{
+		if (config_.pinThreads)
+		{
+			pinCurrentThread(index);
+		}
+#ifdef GAMESERVER_COUNT_ALLOCS
+		countIoAllocations = true;
+#endif
+		shards_[index]->ioc.run();
+	}
+
+	// 현재 스레드를 index번 코어에 고정 (Linux 전용, 그 외에는 무시)
+	static void pinCurrentThread(int index)
+	{
+#ifdef __linux__
+		int cpuCount = std::max<int>(1, std::thread::hardware_concurrency());
+		cpu_set_t cpuset;
+		CPU_ZERO(&cpuset);
+		CPU_SET(index % cpuCount, &cpuset);
+		int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+		if (rc != 0)
+		{
+			LOG_WARN << "pthread_setaffinity_np failed for shard " << index << ": " << rc;
+		}
+#else
+		(void)index;
+#endif
+	}
+
+	void doAccept()
+	{
+		// 새 소켓은 배정된 샤드의 io_context 위에 바로 만든다
+		int shardIndex = nextShard_;
+		nextShard_ = (nextShard_ + 1) % static_cast<int>(shards_.size());
+		IoShard *shard = shards_[shardIndex].get();
+
+		acceptor_.async_accept(
+			shard->ioc,
+			[this, shard, shardIndex](beast::error_code ec, tcp::socket socket)
+			{
+				if (!ec)
+				{
+					applySocketOptions(socket);
+
+					// 세션만 생성, playerId는 JOIN_REQUEST에서 할당
+					auto session = make_shared<Session>(move(socket), this, shard->ioc, shardIndex);
+					sessionCount_++;
+
+					// 슬롯 등록과 핸드셰이크는 샤드 스레드에서
+					net::post(shard->ioc, [shard, session]()
+						{
+							session->setSlot(shard->sessions.insert(session));
+							session->run();
+						});
 				}
 				doAccept();
 			});
 	}
 
+	// accept된 소켓에 커널 옵션 적용 (실패해도 연결은 유지)
+	void applySocketOptions(tcp::socket &socket)
+	{
+		beast::error_code ec;
+
+		socket.set_option(tcp::no_delay(config_.tcpNoDelay), ec);
+		if (ec)
+			LOG_EVERY_MS(LogLevel::WARN, 1000) << "TCP_NODELAY failed: " << ec.message();
+
+		if (config_.sendBufferBytes > 0)
+		{
+			socket.set_option(net::socket_base::send_buffer_size(config_.sendBufferBytes), ec);
+			if (ec)
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "SO_SNDBUF failed: " << ec.message();
+		}
+
+#ifdef TCP_NOTSENT_LOWAT
+		if (config_.notSentLowat > 0)
+		{
+			// 커널 송신 큐에 쌓이는 미전송 데이터 상한 -> 오래된 스냅샷이 커널에서 대기하지 않게
+			using notsent_lowat = net::detail::socket_option::integer<IPPROTO_TCP, TCP_NOTSENT_LOWAT>;
+			socket.set_option(notsent_lowat(config_.notSentLowat), ec);
+			if (ec)
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "TCP_NOTSENT_LOWAT failed: " << ec.message();
+		}
+#endif
+	}
+
+	static const char *ioBackendName()
+	{
+#if defined(BOOST_ASIO_HAS_IO_URING) && defined(BOOST_ASIO_DISABLE_EPOLL)
+		return "io_uring";
+#elif defined(_WIN32)
+		return "iocp";
+#else
+		return "epoll";
+#endif
+	}
+
 	void gameLoopThreadFunc()
 	{
 		using namespace chrono;
 
-		const auto frameDuration = microseconds(100000 / TARGET_FPS);
+		const auto frameDuration = microseconds(1000000 / TARGET_FPS);
 		auto nextFrameTime = steady_clock::now();
+#ifdef GAMESERVER_COUNT_ALLOCS
+		countTickAllocations = true;
+#endif
 
 		while (running_)
 		{
@@ -439,6 +1441,23 @@ private:
 
 			gameUpdate();
 
+			// 틱 비용을 부하 경감 제어기에 알린다
+			float costMicros = duration<float, micro>(steady_clock::now() - frameStart).count();
+			LoadLevel previous = loadShedder_.level();
+			if (loadShedder_.recordTick(costMicros))
+			{
+				LoadLevel level = loadShedder_.level();
+				if (level > previous)
+				{
+					LOG_WARN << "Load shedding level " << static_cast<int>(level) << " (" << LoadShedder::levelName(level)
+						<< "), tick cost " << (loadShedder_.smoothedCostMicros() / 1000.0f) << " ms";
+				}
+				else
+				{
+					LOG_INFO << "Load shedding level " << static_cast<int>(level) << " (" << LoadShedder::levelName(level) << ")";
+				}
+			}
+
 			//다음 프레임 시간 계산
 			nextFrameTime += frameDuration;
 
@@ -454,41 +1473,150 @@ private:
 
 	void gameUpdate()
 	{
-		string updateData;
-		//게임 월드 업데이트
+		// 퇴장한 플레이어 정리 (이벤트 기반, O(퇴장 수))
+		processLeftPlayers();
+
+		// 스냅샷 텍스트는 틱 아레나 안 (브로드캐스트가 버퍼 풀에 복사, 다음 틱 시작에 되돌린다)
+		string_view updateData;
+		string_view spectatorData;
+		string_view keyframeData;
+		shared_ptr<SnapshotFrame> frame;
+		bool budgeted = snapshotOptions_.budgetKbps > 0;
+		bool sendSnapshot;
+		//게임 월드 업데이트 (부하와 관계없이 매 틱: 플레이어 입력 지연을 지킨다)
 		{
 			lock_guard<mutex> lock(worldMutex_);
+			frameArena_.reset();
 			gameWorld_.update(FIXED_DELTA_TIME);
-			updateData = getGameStateInternal().dump();
-		}
+			if (shmExport_)
+				exportSnapshotInternal();
 
-		// 브로드캐스트
-		broadcast(updateData);
+			// 부하 경감 중이면 스냅샷은 건너뛸 수 있다
+			sendSnapshot = loadShedder_.shouldSendSnapshot(gameWorld_.getTick());
+			if (sendSnapshot)
+			{
+				// 예산 모드는 클라이언트별 예산이 이미 더미 수를 제한하므로 먼 더미 솎아내기는 전체 스냅샷에만
+				if (budgeted)
+				{
+					frame = snapshotFrames_.acquire();
+					buildSnapshotFrameInternal(*frame);
+				}
+				if (!budgeted || udp_)
+				{
+					updateData = encodeGameStateInternal(loadShedder_.throttleDistantDummies());
+				}
 
-		//죽은 세션 제거
-		{
-			lock_guard<mutex> lock(sessionsMutex_);
+				// 관전자 스냅샷은 관전자 수와 무관하게 한 번만 만든다 (플레이어용 전체 스냅샷이 있으면 재사용)
+				if (spectatorCount_ > 0 && gameWorld_.getTick() % spectatorDivider_ == 0)
+				{
+					spectatorData = updateData.empty()
+						? encodeGameStateInternal(loadShedder_.throttleDistantDummies())
+						: updateData;
+				}
+			}
 
-			for (auto it = sessions_.begin(); it != sessions_.end();)
+			// 키프레임: 먼 더미를 솎아내지 않은 전체 스냅샷이 이미 있으면 그대로, 없으면 이번 틱에 한 번만
+			if (keyframeWanted_.exchange(false))
 			{
-				if (!(*it)->isAlive())
 				{
-					if ((*it)->hasJoined())
-					{
-						int playerId = (*it)->getPlayerId();
-						removePlayer(playerId);
-					}
-					it = sessions_.erase(it);
+					lock_guard<mutex> waitersLock(keyframeMutex_);
+					keyframeServing_.swap(keyframeWaiters_);
 				}
-				else
+				if (!keyframeServing_.empty())
 				{
-					++it;
+					keyframeData = !updateData.empty() && !loadShedder_.throttleDistantDummies()
+						? updateData
+						: encodeGameStateInternal();
+					keyframesBuilt_++;
 				}
 			}
 		}
+
+		// 브로드캐스트
+		if (sendSnapshot)
+		{
+			if (budgeted)
+				broadcastFrame(move(frame), updateData);
+			else
+				broadcast(updateData);
+		}
+		if (!spectatorData.empty())
+		{
+			broadcastSpectators(spectatorData);
+		}
+		if (!keyframeServing_.empty())
+		{
+			shared_ptr<const string> keyframe = acquireSnapshotBuffer(keyframeData);
+			for (auto &session : keyframeServing_)
+			{
+				if (session->isAlive())
+					session->sendKeyframe(keyframe);
+			}
+			keyframesSent_ += static_cast<long long>(keyframeServing_.size());
+			keyframeServing_.clear();
+		}
+
+		// 크래시 복구용 주기 저장 (틱 사이에서만 직렬화 가능하므로 게임 루프에서)
+		if (config_.snapshotInterval > 0
+			&& chrono::steady_clock::now() - lastSnapshotTime_ >= chrono::seconds(config_.snapshotInterval))
+		{
+			saveRoomSnapshot();
+		}
+
 		updateTPS();
 	}
 
+	void restoreRoomSnapshot()
+	{
+		lastSnapshotTime_ = chrono::steady_clock::now();
+		if (config_.roomSnapshot.empty() || !ifstream(config_.roomSnapshot))
+			return;
+
+		auto start = chrono::steady_clock::now();
+		bool ok;
+		{
+			lock_guard<mutex> lock(worldMutex_);
+			ok = gameWorld_.loadSnapshot(config_.roomSnapshot);
+		}
+		if (ok)
+		{
+			LOG_INFO << "Room restored in "
+				<< chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << " ms";
+		}
+	}
+
+	void saveRoomSnapshot()
+	{
+		lastSnapshotTime_ = chrono::steady_clock::now();
+		if (config_.roomSnapshot.empty())
+			return;
+
+		auto start = chrono::steady_clock::now();
+		{
+			lock_guard<mutex> lock(worldMutex_);
+			gameWorld_.saveSnapshot(config_.roomSnapshot);
+		}
+		lastSnapshotMillis_ = chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+	}
+
+	void processLeftPlayers()
+	{
+		vector<int> players;
+		{
+			lock_guard<mutex> lock(leftPlayersMutex_);
+			if (leftPlayers_.empty())
+				return;
+			players.swap(leftPlayers_);
+		}
+
+		lock_guard<mutex> lock(worldMutex_);
+		for (int playerId : players)
+		{
+			gameWorld_.removePlayer(playerId);
+			playerCount_--;
+		}
+	}
+
 	void updateTPS()
 	{
 		tickCount_++;
@@ -513,6 +1641,27 @@ private:
 			cout << "TPS: " << fixed << setprecision(1) << currentTPS_ << endl;
 			cout << "Tick Time: " << fixed << setprecision(2)
 				<< (1000.0f / currentTPS_) << " ms" << endl;
+			{
+				lock_guard<mutex> lock(worldMutex_);
+				const PhysicsWorld &physics = gameWorld_.getPhysicsWorld();
+				cout << "History Record: " << fixed << setprecision(1)
+					<< physics.getLastRecordMicros() << " us ("
+					<< (physics.getHistory().memoryBytes() / 1048576.0f) << " MB)" << endl;
+				cout << "Awake Dummies: " << physics.countAwakeDummies()
+					<< " / " << gameWorld_.getDummies().size() << endl;
+				if (gameWorld_.getTotalDummyCount() > gameWorld_.getDummies().size() || gameWorld_.getPromotedCount() > 0)
+				{
+					cout << "Cosmetic Dummies: " << gameWorld_.getCosmeticDummies().size()
+						<< " (promoted " << gameWorld_.getPromotedCount() << ", "
+						<< CosmeticDummyField::kernelName() << ")" << endl;
+				}
+				if (!config_.roomSnapshot.empty())
+				{
+					cout << "Room Snapshot: " << fixed << setprecision(1) << lastSnapshotMillis_ << " ms (last save)" << endl;
+				}
+				cout << "Scene Queries: " << physics.getQueryBatch().lastQueryCount() << " / tick ("
+					<< fixed << setprecision(1) << physics.getQueryBatch().lastExecuteMicros() << " us)" << endl;
+			}
 
 			// 색상 표시 (TPS에 따라)
 			if (currentTPS_ >= TARGET_FPS * 0.95f)
@@ -523,7 +1672,96 @@ private:
 				cout << "Performance: POOR" << endl;
 
 			// 플레이어 정보
-			cout << "Connected Players: " << getConnectedPlayerCount() << " / " << MAX_PLAYERS << endl;
+			cout << "Connected Players: " << getConnectedPlayerCount() << " / " << getMaxPlayers() << endl;
+			cout << "Sessions: " << getSessionCount() << endl;
+			cout << "Joins/s: " << fixed << setprecision(1)
+				<< (joinCount_.exchange(0) * 1000.0f / elapsed) << endl;
+			cout << "Keyframes: built " << keyframesBuilt_ << "  sent " << keyframesSent_ << endl;
+
+			// 웹소켓 메시지 쓰기/읽기 (틱당, syscall 수가 아님: writeCount_ 참고)
+			long long writes = writeCount_.exchange(0);
+			long long reads = readCount_.exchange(0);
+			cout << "WS Writes/Tick: " << fixed << setprecision(1)
+				<< (float(writes) / max(1, tickCount_))
+				<< "  Reads/Tick: " << (float(reads) / max(1, tickCount_)) << endl;
+			cout << "Load Level: " << static_cast<int>(loadShedder_.level()) << " (" << LoadShedder::levelName(loadShedder_.level()) << ")"
+				<< "  Tick Cost: " << fixed << setprecision(2) << (loadShedder_.smoothedCostMicros() / 1000.0f)
+				<< " / " << (loadShedder_.budgetMicros() / 1000.0f) << " ms"
+				<< "  Overruns: " << loadShedder_.overruns() << endl;
+			cout << "Evictions: " << evictionCount_ << endl;
+			{
+				// 게임 루프 스레드만 쓰는 값이라 잠금 없이
+				const PhysicsTickStats &physicsStats = gameWorld_.getPhysicsWorld().getTickStats();
+				cout << "PhysX: simulate " << fixed << setprecision(2) << (physicsStats.simulateMicros / 1000.0f) << " ms"
+					<< "  active bodies " << physicsStats.activeDynamicBodies << " / " << physicsStats.dynamicBodies
+					<< "  pairs " << physicsStats.contactPairs << " (touching " << physicsStats.contactPairsWithContacts << ")"
+					<< "  partitions " << physicsStats.partitions;
+				if (gameWorld_.getPhysicsWorld().isPvdCapturing())
+					cout << "  [PVD capture, " << gameWorld_.getPhysicsWorld().getPvdRemainingTicks() << " ticks left]";
+				cout << endl;
+				if (physicsStats.regions > 1)
+				{
+					cout << "Regions: " << gameWorld_.getRegionGrid() << "x" << gameWorld_.getRegionGrid()
+						<< "  ghosts " << physicsStats.ghostActors
+						<< "  handoffs/tick " << physicsStats.handoffs
+						<< " (total " << gameWorld_.getPhysicsWorld().getHandoffsTotal() << ")" << endl;
+				}
+			}
+			if (TaskPool *pool = gameWorld_.getTaskPool())
+			{
+				cout << "World Threads: " << pool->threadCount()
+					<< " (parallel jobs " << pool->jobs() << ", steals " << pool->steals() << ")" << endl;
+			}
+			if (config_.maxSpectators > 0)
+			{
+				cout << "Spectators: " << spectatorCount_ << " / " << config_.maxSpectators
+					<< " (" << getSpectatorRate() << " Hz, skipped frames " << spectatorSkips_.exchange(0) << ")" << endl;
+			}
+			if (shmExport_)
+			{
+				cout << "Shm Export: frame " << shmExport_->published() << ", " << shmExport_->lastCount() << " entities, "
+					<< fixed << setprecision(3) << (shmExportMicros_ / 1000.0 / max(1, shmExportFrames_)) << " ms/tick" << endl;
+				shmExportMicros_ = 0;
+				shmExportFrames_ = 0;
+			}
+			cout << "Handler Heap Fallbacks: " << HandlerMemory::fallbacks().exchange(0) << endl;
+#ifdef GAMESERVER_COUNT_ALLOCS
+			// 읽기 + 쓰기 메시지당 I/O 스레드 힙 할당 (정상 상태 목표 0)
+			cout << "I/O Allocs/Msg: " << fixed << setprecision(2)
+				<< (float(ioAllocationCount.exchange(0)) / max(1LL, reads + writes)) << endl;
+			// 게임 루프 스레드 틱당 힙 할당 (이 상태 출력분 포함, 정상 상태 목표 ~0)
+			cout << "Tick Allocs/Tick: " << fixed << setprecision(2)
+				<< (float(tickAllocationCount.exchange(0)) / max(1, tickCount_)) << endl;
+#endif
+			{
+				// 게임 루프가 월드 잠금 안에서 아레나를 쓴다
+				lock_guard<mutex> lock(worldMutex_);
+				cout << "Frame Arena: " << (frameArena_.lastUsed() >> 10) << " KB/tick (peak " << (frameArena_.peakUsed() >> 10)
+					<< " KB, capacity " << (frameArena_.capacity() >> 10) << " KB, blocks allocated " << frameArena_.blockAllocations() << ")" << endl;
+			}
+			cout << "Outbound: " << fixed << setprecision(1)
+				<< (bytesOut_.exchange(0) / 1024.0f * 1000.0f / elapsed) << " KB/s" << endl;
+
+			if (snapshotOptions_.budgetKbps > 0)
+			{
+				long long snapshots = max(1LL, budgetSnapshots_.exchange(0));
+				long long total = budgetDummiesTotal_.exchange(0);
+				long long sent = budgetDummiesSent_.exchange(0);
+				cout << "Client Budget: " << fixed << setprecision(1)
+					<< (budgetBytesSum_.exchange(0) * 8.0f / 1000.0f / snapshots) << " kbps avg"
+					<< (snapshotOptions_.adaptive ? " (adaptive, max " : " (fixed ")
+					<< snapshotOptions_.budgetKbps << ")"
+					<< "  Dummy Coverage: " << (total > 0 ? sent * 100.0f / total : 100.0f) << "%" << endl;
+			}
+
+			if (udp_)
+			{
+				cout << "UDP Out: " << udp_->packetsOut.exchange(0) << " pkts, "
+					<< fixed << setprecision(1) << (udp_->bytesOut.exchange(0) / 1024.0f * 1000.0f / elapsed) << " KB/s"
+					<< "  In: " << udp_->packetsIn.exchange(0) << " pkts"
+					<< "  Sim Lost: " << udp_->packetsLost.exchange(0)
+					<< "  Superseded Frags: " << udp_->fragmentsSkipped.exchange(0) << endl;
+			}
 
 			// 리셋
 			tickCount_ = 0;
@@ -533,18 +1771,111 @@ private:
 
 };
 
+void Session::notifyClosed()
+{
+	if (udpToken_ != 0)
+	{
+		server_->getUdpTransport()->unregisterPeer(udpToken_);
+	}
+	if (spectating_)
+	{
+		server_->removeSpectator();
+	}
+	server_->onSessionClosed(shardIndex_, slot_, hasJoined_ ? playerId_ : -1);
+}
+
+// JOIN_RESPONSE 뒤에 UDP 채널 제안 (서버에서 UDP를 켠 경우만)
+// 클라이언트가 HELLO를 보내지 않으면 계속 웹소켓으로 스냅샷을 받는다
+void Session::offerUdpChannel()
+{
+	UdpTransport *udp = server_->getUdpTransport();
+	if (!udp)
+		return;
+
+	udpToken_ = udp->nextToken();
+	udp->registerPeer(udpToken_, playerId_, [weak = weak_from_this()]()
+		{
+			if (auto self = weak.lock())
+			{
+				self->udpBound_ = true;
+			}
+		});
+
+	json offer;
+	offer["type"] = 8; // UDP_OFFER
+	offer["port"] = udp->port();
+	offer["token"] = udpToken_;
+	offer["mtu"] = udp->mtu();
+	send(offer.dump());
+}
+
+void Session::recordWrite(size_t bytes)
+{
+	server_->recordWrite(bytes);
+}
+
+void Session::recordRead()
+{
+	server_->recordRead();
+}
+
+void Session::recordEviction()
+{
+	server_->recordEviction();
+}
+
+void Session::recordSpectatorSkip()
+{
+	server_->recordSpectatorSkip();
+}
+
+const EvictionLimits &Session::getEvictionLimits() const
+{
+	return server_->getEvictionLimits();
+}
+
+// 전체 상태는 다음 틱 키프레임으로 (이미 요청해 둔 것이 있으면 그걸 같이 받는다)
 void Session::sendGameState()
 {
-	json gameState = server_->getGameState();
-	send(gameState.dump());
+	if (!keyframePending_.exchange(true))
+		server_->requestKeyframe(shared_from_this());
 }
 
-void Session::handleMessage(const string &message)
+// 예산 안에서 이 클라이언트에게 중요한 더미부터 골라 보낸다
+void Session::sendSnapshot(const SnapshotFrame &frame)
+{
+	if (!scheduler_)
+	{
+		scheduler_ = make_unique<SnapshotScheduler>(server_->getSnapshotOptions());
+	}
+
+	shared_ptr<string> buffer = snapshotBuffers_.acquire();
+	scheduler_->build(frame, playerId_, *buffer);
+	server_->recordSnapshotBudget(*scheduler_);
+	send(shared_ptr<const string>(move(buffer)));
+}
+
+// 입력/점프처럼 숫자만 있는 메시지는 할당 없이 스캔하고,
+// 문자열/배열이 있는 메시지(JOIN 등)만 json DOM으로 파싱한다
+void Session::handleMessage(boost::string_view text)
 {
 	try
 	{
-		json data = json::parse(message);
-		int msgType = data["type"];
+		ClientMessage message;
+		json data;
+		if (!scanClientMessage(text, message))
+		{
+			data = json::parse(text.begin(), text.end());
+			message = ClientMessage();
+			readClientMessage(data, message);
+		}
+
+		if (!message.has(ClientMessage::TYPE))
+		{
+			LOG_EVERY_MS(LogLevel::WARN, 1000) << "Message without type";
+			return;
+		}
+		int msgType = message.type;
 
 		switch (msgType)
 		{
@@ -552,7 +1883,12 @@ void Session::handleMessage(const string &message)
 		{
 			if (hasJoined_)
 			{
-				cout << "Player already joined, ignoring duplicate JOIN_REQUEST" << endl;
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "Player already joined, ignoring duplicate JOIN_REQUEST";
+				return;
+			}
+			if (spectating_)
+			{
+				sendJoinResponse(false, -1, "", "Spectators cannot join, reconnect as a player");
 				return;
 			}
 
@@ -577,20 +1913,22 @@ void Session::handleMessage(const string &message)
 				nickname_ = requestedNickname;
 				hasJoined_ = true;
 
-				cout << "Player " << playerId_ << " (" << nickname_ << ") joined with color ("
-					<< playerColor.r << ", " << playerColor.g << ", " << playerColor.b << ")" << endl;
+				LOG_INFO << "Player " << playerId_ << " (" << nickname_ << ") joined with color ("
+					<< playerColor.r << ", " << playerColor.g << ", " << playerColor.b << ")";
 
 				sendJoinResponse(true, playerId_, nickname_);
+				offerUdpChannel();
 
-				// 초기 게임 상태 전송
-				this_thread::sleep_for(chrono::milliseconds(100)); // ?? 왜 잠드는 것인지 ??
+				// 초기 게임 상태 전송 (다음 틱 키프레임, 최대 한 틱 뒤)
+				// JOIN_RESPONSE가 먼저 큐에 들어갔으므로 항상 그 뒤에 도착한다
 				sendGameState();
 			}
 			else
 			{
 				// 실패 (서버 만원)
-				cout << "Server full, rejecting join request" << endl;
-				sendJoinResponse(false, -1, "", "Server is full (50/50 players)");
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "Server full, rejecting join request";
+				int maxPlayers = server_->getMaxPlayers();
+				sendJoinResponse(false, -1, "", "Server is full (" + to_string(maxPlayers) + "/" + to_string(maxPlayers) + " players)");
 			}
 			break;
 		}
@@ -599,22 +1937,30 @@ void Session::handleMessage(const string &message)
 		{
 			if (!hasJoined_)
 			{
-				cerr << "Received INPUT from non-joined client" << endl;
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "Received INPUT from non-joined client";
 				return;
 			}
 
-			int pid = data["playerId"];
-			if (pid != playerId_)
+			if (!message.has(ClientMessage::PLAYER_ID | ClientMessage::X | ClientMessage::Y | ClientMessage::Z))
 			{
-				cerr << "PlayerId mismatch!" << endl;
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "Malformed INPUT from Player " << playerId_;
 				return;
 			}
 
-			Vector3 movement(
-				data["x"],
-				data["y"],
-				data["z"]
-			);
+			if (message.playerId != playerId_)
+			{
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "PlayerId mismatch!";
+				return;
+			}
+
+			// NaN/무한대는 PhysX 속도까지 그대로 가므로 여기서도 막는다
+			if (!isfinite(message.x) || !isfinite(message.y) || !isfinite(message.z))
+			{
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "Non-finite INPUT from Player " << playerId_;
+				return;
+			}
+
+			Vector3 movement(message.x, message.y, message.z);
 
 			server_->setPlayerInput(playerId_, movement);
 			break;
@@ -624,14 +1970,13 @@ void Session::handleMessage(const string &message)
 		{
 			if (!hasJoined_)
 			{
-				cerr << "Received JUMP from non-joined client" << endl;
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "Received JUMP from non-joined client";
 				return;
 			}
 
-			int pid = data["playerId"];
-			if (pid != playerId_)
+			if (!message.has(ClientMessage::PLAYER_ID) || message.playerId != playerId_)
 			{
-				cerr << "PlayerId mismatch!" << endl;
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "PlayerId mismatch!";
 				return;
 			}
 
@@ -643,13 +1988,14 @@ void Session::handleMessage(const string &message)
 		{
 			if (!hasJoined_)
 			{
-				cerr << "Received SPAWN_DUMMIES from non-joined client" << endl;
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "Received SPAWN_DUMMIES from non-joined client";
 				return;
 			}
 
-			int count = data.value("count", 10);
-			server_->spawnDummies(count);
-			cout << "Spawning " << count << " dummies requested by Player " << playerId_ << endl;
+			int count = message.count;
+			int spawned = server_->spawnDummies(count, message.cosmetic);
+			LOG_INFO << "Spawning " << spawned << " / " << count << (message.cosmetic ? " cosmetic" : "")
+				<< " dummies requested by Player " << playerId_;
 			break;
 		}
 
@@ -657,38 +2003,101 @@ void Session::handleMessage(const string &message)
 		{
 			if (!hasJoined_)
 			{
-				cerr << "Received DELETE_ALL_DUMMIES from non-joined client" << endl;
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "Received DELETE_ALL_DUMMIES from non-joined client";
 				return;
 			}
 
 			server_->deleteAllDummies();
-			cout << "Delete all dummies requested by Player " << playerId_ << endl;
+			LOG_INFO << "Delete all dummies requested by Player " << playerId_;
+			break;
+		}
+
+		case 9: // SPECTATE_REQUEST
+		{
+			if (hasJoined_ || spectating_)
+			{
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "Ignoring SPECTATE_REQUEST from joined client";
+				return;
+			}
+
+			json response;
+			response["type"] = 10; // SPECTATE_RESPONSE
+			if (server_->addSpectator())
+			{
+				spectating_ = true;
+				response["success"] = true;
+				response["rate"] = server_->getSpectatorRate();
+				send(response.dump());
+
+				// 첫 상태는 다음 관전자 스냅샷으로 (최대 1/rate초, 대량 접속이 월드 잠금을 잡지 않도록)
+				LOG_DEBUG << "Spectator connected from " << remote_;
+			}
+			else
+			{
+				response["success"] = false;
+				response["message"] = "Spectator limit reached";
+				send(response.dump());
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "Spectator limit reached, rejecting " << remote_;
+			}
+			break;
+		}
+
+		case 11: // RESYNC_REQUEST
+		{
+			// 클라이언트가 상태를 잃었을 때 (패킷 유실, 탭 복귀 등) 다음 키프레임을 받는다
+			if (!hasJoined_)
+			{
+				LOG_EVERY_MS(LogLevel::WARN, 1000) << "Received RESYNC_REQUEST from non-joined client";
+				return;
+			}
+
+			sendGameState();
 			break;
 		}
 
 		default:
-			cerr << "Unknown message type: " << msgType << endl;
+			LOG_EVERY_MS(LogLevel::WARN, 1000) << "Unknown message type: " << msgType;
 			break;
 		}
 	}
 	catch (const exception &e)
 	{
-		cerr << "Message parse error: " << e.what() << endl;
+		LOG_EVERY_MS(LogLevel::WARN, 1000) << "Message parse error: " << e.what();
 	}
 }
 
-int main()
+int main(int argc, char *argv[])
 {
 	try
 	{
-		GameServer server(9002);
+		ServerConfig config = parseServerConfig(argc, argv);
+		if (!findSceneProfile(config.sceneProfile))
+		{
+			cerr << "Unknown scene profile: " << config.sceneProfile << endl;
+			cerr << "Available:";
+			for (const auto &profile : sceneProfiles())
+				cerr << " " << profile.name;
+			cerr << endl;
+			return 1;
+		}
+		LogLevel logLevel;
+		if (!Logger::parseLevel(config.logLevel, logLevel))
+		{
+			cerr << "Unknown log level: " << config.logLevel << " (debug, info, warn, error)" << endl;
+			return 1;
+		}
+		Logger::instance().setLevel(logLevel);
+
+		GameServer server(config);
 		server.start();
 		server.run();
 	}
 	catch (const exception &e)
 	{
-		cerr << "Fatal Error: " << e.what() << endl;
+		LOG_ERROR << "Fatal Error: " << e.what();
+		Logger::instance().stop();
 		return 1;
 	}
+	Logger::instance().stop();
 	return 0;
 }